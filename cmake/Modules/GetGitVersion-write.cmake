@@ -1,14 +1,18 @@
-### Don't include directly, for use by GetSVNVersion.cmake
-find_package(Git)
-# Extract svn info into MY_XXX variables
+### Don't include directly, for use by GetGitVersion.cmake
+find_package(Git QUIET)
+# Extract git info into GIT_REVISION
 if(GIT_FOUND)
-  execute_process(COMMAND ${GIT_EXECUTABLE} rev-parse --verify --short HEAD
+  execute_process(COMMAND ${GIT_EXECUTABLE} rev-parse --verify --short=12 HEAD
     WORKING_DIRECTORY ${SOURCE_DIR}
     OUTPUT_VARIABLE GIT_REVISION
-    OUTPUT_STRIP_TRAILING_WHITESPACE)
-  file(WRITE include/galois/revision.h.txt "#define GALOIS_REVISION \"${GIT_REVISION}\"\n")
-else()
-  file(WRITE include/galois/revision.h.txt "#define GALOIS_REVISION \"0\"\n")
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    ERROR_QUIET)
+endif()
+if(NOT GIT_REVISION)
+  set(GIT_REVISION "unknown")
 endif()
 
-execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different include/galois/revision.h.txt include/galois/revision.h)
+file(WRITE ${BINARY_DIR}/include/galois/revision.h.txt "#define GALOIS_REVISION \"${GIT_REVISION}\"\n")
+# Only touch the header when the revision changes so that its users are not
+# rebuilt every time
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different ${BINARY_DIR}/include/galois/revision.h.txt ${BINARY_DIR}/include/galois/revision.h)
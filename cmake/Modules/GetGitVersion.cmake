@@ -1,11 +1,14 @@
-# DUMMY is a non-existent file to force regeneration of svn header every build
-add_custom_target(revision ALL DEPENDS DUMMY ${PROJECT_BINARY_DIR}/include/galois/revision.h)
+# DUMMY is a non-existent file to force regeneration of the revision header
+# every build; the header itself only changes with the revision
+add_custom_target(revision ALL DEPENDS DUMMY)
 
 find_file(_MODULE "GetGitVersion-write.cmake" PATHS ${CMAKE_MODULE_PATH})
 
-add_custom_command(OUTPUT DUMMY ${PROJECT_BINARY_DIR}/include/galois/revision.h
+add_custom_command(OUTPUT DUMMY
+  BYPRODUCTS ${PROJECT_BINARY_DIR}/include/galois/revision.h
   COMMAND ${CMAKE_COMMAND} -DSOURCE_DIR=${CMAKE_SOURCE_DIR}
-  -DCMAKE_MODULE_PATH="${CMAKE_SOURCE_DIR}/cmake/Modules/" -P ${_MODULE})
+  -DBINARY_DIR=${PROJECT_BINARY_DIR}
+  -DCMAKE_MODULE_PATH=${CMAKE_SOURCE_DIR}/cmake/Modules/ -P ${_MODULE})
 
 set(_MODULE off)
 
@@ -27,6 +27,8 @@
 #ifndef _GALOIS_CUSP_PSCAFFOLD_H_
 #define _GALOIS_CUSP_PSCAFFOLD_H_
 
+#include "galois/runtime/Checkpoint.h"
+
 namespace galois {
 namespace graphs {
 
@@ -137,6 +139,16 @@ public:
    * assignment phase.
    */
   bool addMasterMapping(uint32_t, uint32_t) { return false; }
+
+  /**
+   * No-op: masters follow from the read assignment, which the graph saves.
+   */
+  void saveMasters(galois::runtime::CheckpointWriter&) const {}
+  /**
+   * No-op: masters follow from the read assignment restored with
+   * saveGIDToHost.
+   */
+  void loadMasters(galois::runtime::CheckpointReader&) {}
 };
 
 /**
@@ -318,6 +330,47 @@ public:
       return false;
     }
   }
+
+  /**
+   * Saves the master mapping of a partitioner in stage 2.
+   *
+   * @param w writer to append the mapping to
+   */
+  void saveMasters(galois::runtime::CheckpointWriter& w) const {
+    assert(_status == 2);
+    w.writeValue(_nodeOffset);
+    w.writeVector(_localNodeToMaster);
+    std::vector<uint64_t> gids;
+    std::vector<uint32_t> masters;
+    gids.reserve(_gid2masters.size());
+    masters.reserve(_gid2masters.size());
+    for (auto& gidMaster : _gid2masters) {
+      gids.push_back(gidMaster.first);
+      masters.push_back(gidMaster.second);
+    }
+    w.writeVector(gids);
+    w.writeVector(masters);
+  }
+
+  /**
+   * Restores a master mapping saved with saveMasters and puts the
+   * partitioner in stage 2.
+   *
+   * @param r reader positioned at the saved mapping
+   */
+  void loadMasters(galois::runtime::CheckpointReader& r) {
+    _nodeOffset = r.readValue<uint64_t>();
+    r.readVector(_localNodeToMaster);
+    std::vector<uint64_t> gids;
+    std::vector<uint32_t> masters;
+    r.readVector(gids);
+    r.readVector(masters);
+    _gid2masters.reserve(gids.size());
+    for (size_t i = 0; i < gids.size(); ++i) {
+      _gid2masters[gids[i]] = masters[i];
+    }
+    _status = 2;
+  }
 };
 
 } // end namespace graphs
@@ -33,6 +33,7 @@
 #include "galois/graphs/LC_CSR_Graph.h"
 #include "galois/graphs/BufferedGraph.h"
 #include "galois/runtime/DistStats.h"
+#include "galois/runtime/Checkpoint.h"
 #include "galois/graphs/OfflineGraph.h"
 #include "galois/DynamicBitset.h"
 
@@ -845,21 +846,151 @@ protected:
    */
   void edgesEqualMasters() { specificRanges[2] = specificRanges[1]; }
 
-public:
+  //! Identifies local graph files written by this version of the code
+  constexpr static uint64_t localGraphMagic = 0x47616c5061727431ULL;
+
+  /**
+   * Saves what a derived graph needs, beyond the state of this class, to
+   * answer ownership queries without partitioning again.
+   *
+   * @param w writer to append the state to
+   */
+  virtual void savePartitionState(galois::runtime::CheckpointWriter&) const {
+    GALOIS_DIE("saving this kind of partition is not supported");
+  }
+
   /**
-   * Write the local LC_CSR graph to the file on a disk.
+   * Restores the state saved by savePartitionState. Called once the
+   * metadata of this class has been read.
    *
-   * @todo revive this
+   * @param r reader positioned at the saved state
    */
-  void save_local_graph_to_file(std::string) { GALOIS_DIE("not implemented"); }
+  virtual void loadPartitionState(galois::runtime::CheckpointReader&) {
+    GALOIS_DIE("loading this kind of partition is not supported");
+  }
+
+public:
+  /**
+   * Write the local LC_CSR graph and the partition metadata to
+   * localGraphFileName_<host id> on a disk. Each host writes its own file,
+   * and the CSR arrays are written by all threads in parallel. Node data is
+   * not saved.
+   *
+   * @param localGraphFileName prefix of the file to write
+   */
+  void save_local_graph_to_file(std::string localGraphFileName) {
+    galois::StatTimer Tsave("SaveLocalGraphTime", GRNAME);
+    Tsave.start();
+    std::string fileName = localGraphFileName + "_" + std::to_string(id);
+    galois::runtime::CheckpointWriter w(fileName);
+
+    w.writeValue(localGraphMagic);
+    w.writeValue(id);
+    w.writeValue(numHosts);
+    w.writeValue(uint64_t{galois::LargeArray<EdgeTy>::size_of::value});
+    w.writeValue(transposed);
+    w.writeValue(numGlobalNodes);
+    w.writeValue(numGlobalEdges);
+    w.writeValue(numNodes);
+    w.writeValue(numEdges);
+    w.writeValue(numOwned);
+    w.writeValue(beginMaster);
+    w.writeValue(numNodesWithEdges);
+    for (auto& range : gid2host) {
+      w.writeValue(range.first);
+      w.writeValue(range.second);
+    }
+    for (auto& mirrors : mirrorNodes) {
+      w.writeVector(mirrors);
+    }
+    savePartitionState(w);
+
+    w.writeArray(localToGlobalVector.data(), numNodes);
+    w.writeParallel<uint64_t>(numNodes,
+                              [&](size_t n) { return *graph.edge_end(n); });
+    w.writeParallel<uint32_t>(numEdges, [&](size_t e) {
+      return graph.getEdgeDst(edge_iterator(e));
+    });
+    if constexpr (galois::LargeArray<EdgeTy>::has_value) {
+      w.writeParallel<EdgeTy>(numEdges, [&](size_t e) {
+        return graph.getEdgeData(edge_iterator(e));
+      });
+    }
+    w.commit();
+    Tsave.stop();
+
+    galois::runtime::reportStat_Tsum(GRNAME, "LocalGraphBytes", w.size());
+    galois::gPrint("[", id, "] Saved local graph to ", fileName, "\n");
+  }
 
   /**
-   * Read the local LC_CSR graph from the file on a disk.
+   * Read the local LC_CSR graph and the partition metadata saved by
+   * save_local_graph_to_file instead of partitioning the input again. The
+   * file must have been written by a run with the same number of hosts,
+   * partitioning policy, and edge type.
    *
-   * @todo revive this
+   * @param localGraphFileName prefix of the file to read
    */
-  void read_local_graph_from_file(std::string) {
-    GALOIS_DIE("not implemented");
+  void read_local_graph_from_file(std::string localGraphFileName) {
+    galois::StatTimer Tread("ReadLocalGraphTime", GRNAME);
+    Tread.start();
+    std::string fileName = localGraphFileName + "_" + std::to_string(id);
+    galois::runtime::CheckpointReader r(fileName);
+
+    if (r.readValue<uint64_t>() != localGraphMagic) {
+      GALOIS_DIE(fileName, " is not a local graph file");
+    }
+    unsigned savedID       = r.readValue<unsigned>();
+    uint32_t savedNumHosts = r.readValue<uint32_t>();
+    uint64_t edgeDataSize  = r.readValue<uint64_t>();
+    if (savedID != id || savedNumHosts != numHosts ||
+        edgeDataSize != galois::LargeArray<EdgeTy>::size_of::value) {
+      GALOIS_DIE(fileName, " was saved by host ", savedID, " of ",
+                 savedNumHosts, " with ", edgeDataSize,
+                 " byte edge data; expected host ", id, " of ", numHosts);
+    }
+    transposed        = r.readValue<bool>();
+    numGlobalNodes    = r.readValue<uint64_t>();
+    numGlobalEdges    = r.readValue<uint64_t>();
+    numNodes          = r.readValue<uint32_t>();
+    numEdges          = r.readValue<uint64_t>();
+    numOwned          = r.readValue<uint32_t>();
+    beginMaster       = r.readValue<uint32_t>();
+    numNodesWithEdges = r.readValue<uint32_t>();
+    gid2host.resize(numHosts);
+    for (auto& range : gid2host) {
+      range.first  = r.readValue<uint64_t>();
+      range.second = r.readValue<uint64_t>();
+    }
+    for (auto& mirrors : mirrorNodes) {
+      r.readVector(mirrors);
+    }
+    loadPartitionState(r);
+
+    localToGlobalVector.resize(numNodes);
+    r.readArray(localToGlobalVector.data(), numNodes);
+    globalToLocalMap.reserve(numNodes);
+    for (uint32_t n = 0; n < numNodes; ++n) {
+      globalToLocalMap[localToGlobalVector[n]] = n;
+    }
+
+    graph.allocateFrom(numNodes, numEdges);
+    graph.constructNodes();
+    r.readParallel<uint64_t>(
+        numNodes, [&](size_t n, uint64_t e) { graph.fixEndEdge(n, e); });
+    r.readParallel<uint32_t>(
+        numEdges, [&](size_t e, uint32_t dst) { graph.constructEdge(e, dst); });
+    if constexpr (galois::LargeArray<EdgeTy>::has_value) {
+      r.readParallel<EdgeTy>(numEdges, [&](size_t e, const EdgeTy& data) {
+        graph.getEdgeData(edge_iterator(e)) = data;
+      });
+    }
+
+    determineThreadRanges();
+    determineThreadRangesMaster();
+    determineThreadRangesWithEdges();
+    initializeSpecificRanges();
+    Tread.stop();
   }
 
   /**
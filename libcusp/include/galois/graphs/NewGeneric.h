@@ -31,6 +31,7 @@
 #include "galois/DReducible.h"
 #include <optional>
 #include <sstream>
+#include <typeinfo>
 
 #define CUSP_PT_TIMER 0
 
@@ -107,6 +108,29 @@ private:
     return graphPartitioner->cartesianGrid();
   }
 
+protected:
+  //! Saves the partitioning policy and its master assignment
+  virtual void savePartitionState(galois::runtime::CheckpointWriter& w) const {
+    std::string policy = typeid(Partitioner).name();
+    w.writeVector(std::vector<char>(policy.begin(), policy.end()));
+    graphPartitioner->saveMasters(w);
+  }
+
+  //! Recreates the partitioner from the state saved by savePartitionState
+  virtual void loadPartitionState(galois::runtime::CheckpointReader& r) {
+    std::vector<char> policy;
+    r.readVector(policy);
+    std::string savedPolicy(policy.begin(), policy.end());
+    if (savedPolicy != typeid(Partitioner).name()) {
+      GALOIS_DIE("local graph was saved with a different partitioning policy");
+    }
+    graphPartitioner = std::make_unique<Partitioner>(
+        base_DistGraph::id, base_DistGraph::numHosts,
+        base_DistGraph::numGlobalNodes, base_DistGraph::numGlobalEdges);
+    graphPartitioner->saveGIDToHost(base_DistGraph::gid2host);
+    graphPartitioner->loadMasters(r);
+  }
+
 public:
   /**
    * Reset load balance on host reducibles.
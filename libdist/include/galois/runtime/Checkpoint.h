@@ -0,0 +1,221 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file Checkpoint.h
+ *
+ * Binary files used to save partitions and node data to local disk. A file is
+ * a sequence of values and arrays appended in order and read back in the same
+ * order. Arrays start on a page boundary and are written and read by all
+ * threads in parallel.
+ */
+
+#ifndef _GALOIS_RUNTIME_CHECKPOINT_H_
+#define _GALOIS_RUNTIME_CHECKPOINT_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "galois/Galois.h"
+#include "galois/runtime/ExtraTraits.h"
+
+namespace galois {
+namespace runtime {
+
+/**
+ * Appends data to a file. Data goes to a temporary file that replaces the
+ * final file only on commit, so a crash while writing never leaves behind a
+ * partially written file under the final name.
+ */
+class CheckpointWriter {
+  std::string fileName; //!< name the file gets on commit
+  std::string tmpName;  //!< name written to until commit
+  int fd;               //!< descriptor of the temporary file
+  uint64_t offset;      //!< end of the data written so far
+
+  void pwriteAll(const void* buf, size_t bytes, uint64_t off);
+
+public:
+  //! Number of elements each thread gathers before writing them
+  static constexpr size_t chunkSize = 1 << 16;
+
+  //! Opens a uniquely named temporary file next to fileName for writing
+  explicit CheckpointWriter(const std::string& fileName);
+  //! Removes the temporary file if commit was not called
+  ~CheckpointWriter();
+
+  CheckpointWriter(const CheckpointWriter&) = delete;
+  CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+  //! Appends bytes to the file
+  void write(const void* buf, size_t bytes);
+
+  //! Appends a value that can be copied as raw memory
+  template <typename T>
+  void writeValue(const T& value) {
+    static_assert(is_memory_copyable<T>::value, "T must be memory copyable");
+    write(&value, sizeof(T));
+  }
+
+  //! Appends the size of a vector followed by its elements
+  template <typename T, typename Alloc>
+  void writeVector(const std::vector<T, Alloc>& vec) {
+    static_assert(is_memory_copyable<T>::value, "T must be memory copyable");
+    writeValue(uint64_t{vec.size()});
+    write(vec.data(), vec.size() * sizeof(T));
+  }
+
+  //! Pads the file with zeros up to the next page boundary
+  void alignToPage();
+
+  /**
+   * Appends n elements starting on a page boundary; the threads of the
+   * runtime each gather a contiguous block of elements and write it.
+   *
+   * @param n number of elements to write
+   * @param getElem returns element i when called with i
+   */
+  template <typename T, typename FnTy>
+  void writeParallel(size_t n, const FnTy& getElem) {
+    static_assert(is_memory_copyable<T>::value, "T must be memory copyable");
+    alignToPage();
+    uint64_t base = offset;
+    galois::on_each([&](unsigned tid, unsigned numThreads) {
+      auto r = galois::block_range(size_t{0}, n, tid, numThreads);
+      std::vector<T> buf;
+      buf.reserve(std::min(chunkSize, r.second - r.first));
+      for (size_t b = r.first; b < r.second; b += chunkSize) {
+        size_t e = std::min(b + chunkSize, r.second);
+        buf.clear();
+        for (size_t i = b; i < e; ++i) {
+          buf.push_back(getElem(i));
+        }
+        pwriteAll(buf.data(), (e - b) * sizeof(T), base + b * sizeof(T));
+      }
+    });
+    offset = base + n * sizeof(T);
+  }
+
+  //! Appends a contiguous array of n elements; see writeParallel
+  template <typename T>
+  void writeArray(const T* data, size_t n) {
+    writeParallel<T>(n, [data](size_t i) { return data[i]; });
+  }
+
+  //! Flushes the file to disk and atomically gives it its final name
+  void commit();
+
+  //! Returns the number of bytes written so far
+  uint64_t size() const { return offset; }
+};
+
+/**
+ * Reads a file written by CheckpointWriter. Values must be read with the
+ * same types and in the same order they were written.
+ */
+class CheckpointReader {
+  std::string fileName; //!< file being read
+  int fd;               //!< descriptor of the file
+  uint64_t offset;      //!< position of the next read
+  uint64_t fileSize;    //!< total size of the file
+
+  void preadAll(void* buf, size_t bytes, uint64_t off);
+
+public:
+  //! Number of elements each thread reads at a time
+  static constexpr size_t chunkSize = CheckpointWriter::chunkSize;
+
+  //! Opens fileName for reading; dies if it cannot be opened
+  explicit CheckpointReader(const std::string& fileName);
+  ~CheckpointReader();
+
+  CheckpointReader(const CheckpointReader&) = delete;
+  CheckpointReader& operator=(const CheckpointReader&) = delete;
+
+  //! Returns true if fileName exists and can be read
+  static bool exists(const std::string& fileName);
+
+  //! Reads bytes from the file; dies if the file ends first
+  void read(void* buf, size_t bytes);
+
+  //! Reads a value written with writeValue
+  template <typename T>
+  T readValue() {
+    static_assert(is_memory_copyable<T>::value, "T must be memory copyable");
+    T value;
+    read(&value, sizeof(T));
+    return value;
+  }
+
+  //! Reads a vector written with writeVector
+  template <typename T, typename Alloc>
+  void readVector(std::vector<T, Alloc>& vec) {
+    static_assert(is_memory_copyable<T>::value, "T must be memory copyable");
+    vec.resize(readValue<uint64_t>());
+    read(vec.data(), vec.size() * sizeof(T));
+  }
+
+  //! Skips the padding written by alignToPage
+  void alignToPage();
+
+  /**
+   * Reads n elements written with writeParallel; the threads of the runtime
+   * each read a contiguous block of elements.
+   *
+   * @param n number of elements to read
+   * @param setElem called with i and element i
+   */
+  template <typename T, typename FnTy>
+  void readParallel(size_t n, const FnTy& setElem) {
+    static_assert(is_memory_copyable<T>::value, "T must be memory copyable");
+    alignToPage();
+    uint64_t base = offset;
+    if (base + n * sizeof(T) > fileSize) {
+      GALOIS_DIE("checkpoint ", fileName, " is truncated");
+    }
+    galois::on_each([&](unsigned tid, unsigned numThreads) {
+      auto r = galois::block_range(size_t{0}, n, tid, numThreads);
+      std::vector<T> buf(std::min(chunkSize, r.second - r.first));
+      for (size_t b = r.first; b < r.second; b += chunkSize) {
+        size_t e = std::min(b + chunkSize, r.second);
+        preadAll(buf.data(), (e - b) * sizeof(T), base + b * sizeof(T));
+        for (size_t i = b; i < e; ++i) {
+          setElem(i, buf[i - b]);
+        }
+      }
+    });
+    offset = base + n * sizeof(T);
+  }
+
+  //! Reads n elements written with writeArray into data
+  template <typename T>
+  void readArray(T* data, size_t n) {
+    readParallel<T>(n, [data](size_t i, const T& v) { data[i] = v; });
+  }
+
+  //! Returns the number of bytes read so far
+  uint64_t position() const { return offset; }
+};
+
+} // namespace runtime
+} // namespace galois
+
+#endif
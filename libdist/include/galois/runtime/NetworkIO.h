@@ -124,6 +124,25 @@ public:
 std::tuple<std::unique_ptr<NetworkIO>, uint32_t, uint32_t>
 makeNetworkIOMPI(galois::runtime::MemUsageTracker& tracker,
                  std::atomic<size_t>& sends, std::atomic<size_t>& recvs);
+
+/**
+ * Creates/returns a network IO layer over POSIX shared memory for hosts that
+ * all run on this machine. Does not use MPI. Blocks until all NUM hosts have
+ * created theirs.
+ *
+ * @param ID this host's ID
+ * @param NUM total number of hosts
+ * @param name name of the shared memory segment (e.g. "/galois-job"); all
+ * hosts of a run must use the same name, which must not be in use
+ * @param ringSize bytes buffered from one host to another; a power of 2
+ * @returns tuple with pointer to the shared memory IO layer, this host's ID,
+ * and the total number of hosts in the system
+ */
+std::tuple<std::unique_ptr<NetworkIO>, uint32_t, uint32_t>
+makeNetworkIOShm(galois::runtime::MemUsageTracker& tracker,
+                 std::atomic<size_t>& sends, std::atomic<size_t>& recvs,
+                 uint32_t ID, uint32_t NUM, const std::string& name,
+                 uint64_t ringSize = 4 * 1024 * 1024);
 // #ifdef GALOIS_USE_LCI
 // /**
 //  * Creates/returns a network IO layer that uses LWCI to do communication.
@@ -0,0 +1,142 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file Checkpoint.cpp
+ *
+ * File handling for checkpoint writers and readers.
+ */
+
+#include "galois/runtime/Checkpoint.h"
+#include "galois/gIO.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace galois::runtime;
+
+namespace {
+constexpr uint64_t pageSize = 4096;
+} // namespace
+
+CheckpointWriter::CheckpointWriter(const std::string& _fileName)
+    : fileName(_fileName), tmpName(_fileName + ".XXXXXX"), offset(0) {
+  // a unique name keeps concurrent writers of the same file (e.g., two jobs
+  // sharing a directory) from clobbering each other before the rename
+  fd = mkstemp(&tmpName[0]);
+  if (fd < 0) {
+    GALOIS_SYS_DIE("could not open ", tmpName, " for writing");
+  }
+  // mkstemp creates the file owner-only; other hosts' ranks may read it
+  if (fchmod(fd, 0644) != 0) {
+    GALOIS_SYS_DIE("could not set permissions of ", tmpName);
+  }
+}
+
+CheckpointWriter::~CheckpointWriter() {
+  // only our own temporary file is removed; a committed file has fd == -1
+  if (fd >= 0) {
+    close(fd);
+    unlink(tmpName.c_str());
+  }
+}
+
+void CheckpointWriter::pwriteAll(const void* buf, size_t bytes, uint64_t off) {
+  const char* ptr = static_cast<const char*>(buf);
+  while (bytes > 0) {
+    ssize_t written = pwrite(fd, ptr, bytes, off);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      GALOIS_SYS_DIE("could not write ", tmpName);
+    }
+    ptr += written;
+    off += written;
+    bytes -= written;
+  }
+}
+
+void CheckpointWriter::write(const void* buf, size_t bytes) {
+  pwriteAll(buf, bytes, offset);
+  offset += bytes;
+}
+
+void CheckpointWriter::alignToPage() {
+  static const char zeros[pageSize] = {};
+  write(zeros, (pageSize - offset % pageSize) % pageSize);
+}
+
+void CheckpointWriter::commit() {
+  if (fsync(fd) != 0 || close(fd) != 0) {
+    GALOIS_SYS_DIE("could not flush ", tmpName);
+  }
+  fd = -1;
+  if (rename(tmpName.c_str(), fileName.c_str()) != 0) {
+    GALOIS_SYS_DIE("could not rename ", tmpName, " to ", fileName);
+  }
+}
+
+CheckpointReader::CheckpointReader(const std::string& _fileName)
+    : fileName(_fileName), offset(0) {
+  fd = open(fileName.c_str(), O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    GALOIS_SYS_DIE("could not open ", fileName, " for reading");
+  }
+  fileSize = st.st_size;
+}
+
+CheckpointReader::~CheckpointReader() { close(fd); }
+
+bool CheckpointReader::exists(const std::string& fileName) {
+  return access(fileName.c_str(), R_OK) == 0;
+}
+
+void CheckpointReader::preadAll(void* buf, size_t bytes, uint64_t off) {
+  char* ptr = static_cast<char*>(buf);
+  while (bytes > 0) {
+    ssize_t got = pread(fd, ptr, bytes, off);
+    if (got < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      GALOIS_SYS_DIE("could not read ", fileName);
+    }
+    if (got == 0) {
+      GALOIS_DIE("checkpoint ", fileName, " is truncated");
+    }
+    ptr += got;
+    off += got;
+    bytes -= got;
+  }
+}
+
+void CheckpointReader::read(void* buf, size_t bytes) {
+  preadAll(buf, bytes, offset);
+  offset += bytes;
+}
+
+void CheckpointReader::alignToPage() {
+  offset += (pageSize - offset % pageSize) % pageSize;
+}
@@ -29,6 +29,7 @@
 #include "galois/runtime/Network.h"
 #include "galois/runtime/NetworkIO.h"
 #include "galois/runtime/Tracer.h"
+#include "galois/substrate/EnvCheck.h"
 
 #ifdef GALOIS_USE_LCI
 #define NO_AGG
@@ -371,6 +372,29 @@ class NetworkInterfaceBuffered : public NetworkInterface {
 
   std::vector<sendBuffer> sendData;
 
+  /**
+   * Picks a name for the shared memory segment of this run on host 0 and
+   * hands it to the others. Dies if the hosts are not all on one machine.
+   */
+  static std::string shmSegmentName(int rank, int hostSize) {
+    MPI_Comm local;
+    int localSize;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank,
+                        MPI_INFO_NULL, &local);
+    MPI_Comm_size(local, &localSize);
+    MPI_Comm_free(&local);
+    if (localSize != hostSize) {
+      GALOIS_DIE("GALOIS_NETWORK_IO=shm needs all hosts on one machine");
+    }
+
+    char name[64] = {};
+    if (rank == 0) {
+      snprintf(name, sizeof(name), "/galois-net-%d", getpid());
+    }
+    MPI_Bcast(name, sizeof(name), MPI_CHAR, 0, MPI_COMM_WORLD);
+    return name;
+  }
+
   void workerThread() {
     initializeMPI();
     int rank;
@@ -387,8 +411,17 @@ class NetworkInterfaceBuffered : public NetworkInterface {
     }
 
     galois::gDebug("[", NetworkInterface::ID, "] MPI initialized");
-    std::tie(netio, ID, Num) =
-        makeNetworkIOMPI(memUsageTracker, inflightSends, inflightRecvs);
+    std::string io;
+    if (galois::substrate::EnvCheck("GALOIS_NETWORK_IO", io) && io == "shm") {
+      int ringSize = 4 * 1024 * 1024;
+      galois::substrate::EnvCheck("GALOIS_SHM_RING_SIZE", ringSize);
+      std::tie(netio, ID, Num) = makeNetworkIOShm(
+          memUsageTracker, inflightSends, inflightRecvs, rank, hostSize,
+          shmSegmentName(rank, hostSize), ringSize);
+    } else {
+      std::tie(netio, ID, Num) =
+          makeNetworkIOMPI(memUsageTracker, inflightSends, inflightRecvs);
+    }
 
     assert(ID == (unsigned)rank);
     assert(Num == (unsigned)hostSize);
@@ -0,0 +1,374 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file NetworkIOShm.cpp
+ *
+ * Contains an implementation of network IO over POSIX shared memory for hosts
+ * that run on the same machine.
+ */
+
+#include "galois/runtime/NetworkIO.h"
+#include "galois/runtime/Tracer.h"
+#include "galois/gIO.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+
+//! Identifies a segment laid out by this version of the code
+constexpr uint64_t SHM_MAGIC = 0x47616c6f69734e31ULL;
+
+//! An index of a ring on its own cache line to avoid false sharing between
+//! the sender and the receiver
+struct alignas(64) RingIndex {
+  std::atomic<uint64_t> value;
+};
+
+/**
+ * Single-producer single-consumer byte ring. head and tail only grow, so
+ * tail - head is the number of readable bytes.
+ */
+struct RingHeader {
+  RingIndex head;    //!< next byte to read; written by the receiver only
+  RingIndex tail;    //!< next byte to write; written by the sender only
+  RingIndex matched; //!< messages the receiver has started to read
+};
+
+//! Start of the segment, followed by numHosts * numHosts rings
+struct alignas(64) SegmentHeader {
+  std::atomic<uint64_t> magic;
+  uint64_t numHosts;
+  uint64_t ringSize;
+  std::atomic<uint64_t> attached;
+};
+
+//! Every message in a ring is preceded by this frame
+struct FrameHeader {
+  uint32_t tag;
+  uint32_t unused;
+  uint64_t size;
+};
+
+size_t segmentSize(uint64_t numHosts, uint64_t ringSize) {
+  return sizeof(SegmentHeader) +
+         numHosts * numHosts * (sizeof(RingHeader) + ringSize);
+}
+
+} // namespace
+
+/**
+ * Network IO over a POSIX shared memory segment. The segment holds one ring
+ * for every ordered pair of hosts; a host only writes to the rings it sends
+ * on and only reads from the rings it receives on, so no locks are needed.
+ * Messages larger than a ring are streamed through it in pieces.
+ *
+ * Like the other network IO layers, all calls must come from one thread.
+ */
+class NetworkIOShm : public galois::runtime::NetworkIO {
+  //! a message being written to a ring
+  struct sendTy {
+    uint32_t tag;
+    vTy data;
+    size_t sent;
+    bool framed;
+  };
+
+  //! a message written to a ring that the receiver has not started reading
+  struct unmatchedTy {
+    uint64_t number;
+    size_t size;
+  };
+
+  //! the message being read from a ring
+  struct recvTy {
+    uint32_t tag;
+    vTy data;
+    size_t received;
+    bool active = false;
+  };
+
+  uint32_t ID;
+  uint32_t Num;
+  uint64_t ringSize;
+  size_t mappedSize;
+  void* segment;
+
+  std::vector<std::deque<sendTy>> sendQueues;
+  std::vector<std::deque<unmatchedTy>> unmatched;
+  //! messages written to each ring so far
+  std::vector<uint64_t> numSent;
+  std::vector<recvTy> partial;
+  std::deque<message> done;
+
+  SegmentHeader& header() { return *static_cast<SegmentHeader*>(segment); }
+
+  RingHeader& ringHeader(uint32_t src, uint32_t dst) {
+    char* base = static_cast<char*>(segment) + sizeof(SegmentHeader);
+    return *reinterpret_cast<RingHeader*>(
+        base + (src * Num + dst) * (sizeof(RingHeader) + ringSize));
+  }
+
+  uint8_t* ringData(uint32_t src, uint32_t dst) {
+    return reinterpret_cast<uint8_t*>(&ringHeader(src, dst) + 1);
+  }
+
+  //! Copies up to len bytes into the ring to dst; returns bytes copied
+  size_t ringWrite(uint32_t dst, const uint8_t* src, size_t len) {
+    RingHeader& r = ringHeader(ID, dst);
+    uint64_t tail = r.tail.value.load(std::memory_order_relaxed);
+    uint64_t head = r.head.value.load(std::memory_order_acquire);
+    size_t n      = std::min<size_t>(len, ringSize - (tail - head));
+    size_t pos    = tail & (ringSize - 1);
+    size_t first  = std::min<size_t>(n, ringSize - pos);
+    uint8_t* data = ringData(ID, dst);
+    std::copy_n(src, first, data + pos);
+    std::copy_n(src + first, n - first, data);
+    r.tail.value.store(tail + n, std::memory_order_release);
+    return n;
+  }
+
+  //! Copies up to len bytes out of the ring from src; returns bytes copied
+  size_t ringRead(uint32_t src, uint8_t* dst, size_t len) {
+    RingHeader& r = ringHeader(src, ID);
+    uint64_t head = r.head.value.load(std::memory_order_relaxed);
+    uint64_t tail = r.tail.value.load(std::memory_order_acquire);
+    size_t n      = std::min<size_t>(len, tail - head);
+    size_t pos    = head & (ringSize - 1);
+    size_t first  = std::min<size_t>(n, ringSize - pos);
+    uint8_t* data = ringData(src, ID);
+    std::copy_n(data + pos, first, dst);
+    std::copy_n(data, n - first, dst + first);
+    r.head.value.store(head + n, std::memory_order_release);
+    return n;
+  }
+
+  size_t ringFree(uint32_t dst) {
+    RingHeader& r = ringHeader(ID, dst);
+    return ringSize - (r.tail.value.load(std::memory_order_relaxed) -
+                       r.head.value.load(std::memory_order_acquire));
+  }
+
+  size_t ringUsed(uint32_t src) {
+    RingHeader& r = ringHeader(src, ID);
+    return r.tail.value.load(std::memory_order_acquire) -
+           r.head.value.load(std::memory_order_relaxed);
+  }
+
+  void* map(int fd, size_t size) {
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (ptr == MAP_FAILED)
+      GALOIS_SYS_DIE("mapping shared memory network segment failed");
+    return ptr;
+  }
+
+  //! Host 0 creates and lays out the segment; the others wait for it
+  void attach(const std::string& name, uint64_t requestedRingSize) {
+    int fd;
+    if (ID == 0) {
+      fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+      if (fd < 0)
+        GALOIS_SYS_DIE("creating shared memory network segment ", name,
+                       " failed");
+      ringSize   = requestedRingSize;
+      mappedSize = segmentSize(Num, ringSize);
+      if (ftruncate(fd, mappedSize) != 0)
+        GALOIS_SYS_DIE("sizing shared memory network segment failed");
+      segment           = map(fd, mappedSize);
+      header().numHosts = Num;
+      header().ringSize = ringSize;
+      header().attached = 0;
+      header().magic.store(SHM_MAGIC, std::memory_order_release);
+    } else {
+      while ((fd = shm_open(name.c_str(), O_RDWR, 0600)) < 0) {
+        if (errno != ENOENT)
+          GALOIS_SYS_DIE("opening shared memory network segment ", name,
+                         " failed");
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      // host 0 may not have sized the segment yet
+      struct stat st;
+      while (true) {
+        if (fstat(fd, &st) != 0)
+          GALOIS_SYS_DIE("stat of shared memory network segment failed");
+        if (st.st_size >= static_cast<off_t>(sizeof(SegmentHeader)))
+          break;
+        std::this_thread::yield();
+      }
+      mappedSize = st.st_size;
+      segment    = map(fd, mappedSize);
+      while (header().magic.load(std::memory_order_acquire) != SHM_MAGIC) {
+        std::this_thread::yield();
+      }
+      ringSize = header().ringSize;
+      if (header().numHosts != Num ||
+          mappedSize != segmentSize(Num, ringSize))
+        GALOIS_DIE("shared memory network segment ", name,
+                   " was made for a different number of hosts");
+    }
+    close(fd);
+
+    // once everyone is attached the name is no longer needed; removing it
+    // right away means a crashed run cannot leave a stale segment behind
+    header().attached.fetch_add(1);
+    while (header().attached.load() < Num) {
+      std::this_thread::yield();
+    }
+    if (ID == 0)
+      shm_unlink(name.c_str());
+  }
+
+  /**
+   * Sends complete once the receiver has started reading them, like
+   * MPI_Issend; termination detection relies on a message always being
+   * counted as in flight by either the sender or the receiver.
+   */
+  void sendProgress(uint32_t dst) {
+    auto& u          = unmatched[dst];
+    uint64_t matched = ringHeader(ID, dst).matched.value.load(
+        std::memory_order_acquire);
+    while (!u.empty() && u.front().number < matched) {
+      memUsageTracker.decrementMemUsage(u.front().size);
+      --inflightSends;
+      u.pop_front();
+    }
+
+    auto& q = sendQueues[dst];
+    while (!q.empty()) {
+      auto& m = q.front();
+      if (!m.framed) {
+        if (ringFree(dst) < sizeof(FrameHeader))
+          return;
+        FrameHeader fh{m.tag, 0, m.data.size()};
+        ringWrite(dst, reinterpret_cast<uint8_t*>(&fh), sizeof(fh));
+        m.framed = true;
+      }
+      m.sent += ringWrite(dst, m.data.data() + m.sent, m.data.size() - m.sent);
+      if (m.sent != m.data.size())
+        return;
+      u.push_back(unmatchedTy{numSent[dst]++, m.data.size()});
+      q.pop_front();
+    }
+  }
+
+  void recvProgress(uint32_t src) {
+    auto& m = partial[src];
+    while (true) {
+      if (!m.active) {
+        if (ringUsed(src) < sizeof(FrameHeader))
+          return;
+        FrameHeader fh;
+        ringRead(src, reinterpret_cast<uint8_t*>(&fh), sizeof(fh));
+        ++inflightRecvs;
+        ringHeader(src, ID).matched.value.fetch_add(1,
+                                                    std::memory_order_release);
+        m.tag      = fh.tag;
+        m.data     = vTy(fh.size);
+        m.received = 0;
+        m.active   = true;
+        memUsageTracker.incrementMemUsage(fh.size);
+      }
+      m.received +=
+          ringRead(src, m.data.data() + m.received, m.data.size() - m.received);
+      if (m.received != m.data.size())
+        return;
+      galois::runtime::trace("SHM RECV", src, m.tag, m.data.size());
+      done.emplace_back(src, m.tag, std::move(m.data));
+      m.active = false;
+    }
+  }
+
+public:
+  /**
+   * Constructor. Blocks until all Num hosts have attached to the segment.
+   *
+   * @param tracker memory usage tracker
+   * @param sends
+   * @param recvs
+   * @param id this host's id
+   * @param num total number of hosts on this machine
+   * @param name name of the shared memory segment; must be unique per run
+   * @param requestedRingSize bytes in each ring; a power of 2
+   */
+  NetworkIOShm(galois::runtime::MemUsageTracker& tracker,
+               std::atomic<size_t>& sends, std::atomic<size_t>& recvs,
+               uint32_t id, uint32_t num, const std::string& name,
+               uint64_t requestedRingSize)
+      : NetworkIO(tracker, sends, recvs), ID(id), Num(num), sendQueues(num),
+        unmatched(num), numSent(num), partial(num) {
+    GALOIS_ASSERT(ID < Num);
+    GALOIS_ASSERT(requestedRingSize >= sizeof(FrameHeader) &&
+                      (requestedRingSize & (requestedRingSize - 1)) == 0,
+                  "shared memory ring size must be a power of 2");
+    attach(name, requestedRingSize);
+  }
+
+  virtual ~NetworkIOShm() { munmap(segment, mappedSize); }
+
+  /**
+   * Adds a message to the send queue of its destination
+   */
+  virtual void enqueue(message m) {
+    memUsageTracker.incrementMemUsage(m.data.size());
+    galois::runtime::trace("SHM SEND", m.host, m.tag, m.data.size(),
+                           galois::runtime::printVec(m.data));
+    sendQueues[m.host].push_back(sendTy{m.tag, std::move(m.data), 0, false});
+    sendProgress(m.host);
+  }
+
+  /**
+   * Attempts to get a completely received message.
+   */
+  virtual message dequeue() {
+    if (!done.empty()) {
+      auto msg = std::move(done.front());
+      done.pop_front();
+      return msg;
+    }
+    return message{~0U, 0, vTy()};
+  }
+
+  /**
+   * Moves bytes in and out of all rings of this host.
+   */
+  virtual void progress() {
+    for (uint32_t h = 0; h < Num; ++h) {
+      sendProgress(h);
+      recvProgress(h);
+    }
+  }
+}; // end NetworkIOShm class
+
+std::tuple<std::unique_ptr<galois::runtime::NetworkIO>, uint32_t, uint32_t>
+galois::runtime::makeNetworkIOShm(galois::runtime::MemUsageTracker& tracker,
+                                  std::atomic<size_t>& sends,
+                                  std::atomic<size_t>& recvs, uint32_t ID,
+                                  uint32_t NUM, const std::string& name,
+                                  uint64_t ringSize) {
+  std::unique_ptr<galois::runtime::NetworkIO> n{
+      new NetworkIOShm(tracker, sends, recvs, ID, NUM, name, ringSize)};
+  return std::make_tuple(std::move(n), ID, NUM);
+}
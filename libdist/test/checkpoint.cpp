@@ -0,0 +1,209 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * Writes and reads back checkpoint files and a saved local graph.
+ */
+
+#include "galois/DistGalois.h"
+#include "galois/graphs/CuSPPartitioner.h"
+#include "galois/graphs/FileGraph.h"
+#include "galois/runtime/Checkpoint.h"
+#include "galois/gIO.h"
+
+#include <cstdio>
+#include <random>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using galois::runtime::CheckpointReader;
+using galois::runtime::CheckpointWriter;
+
+struct Elem {
+  uint64_t a;
+  uint32_t b;
+};
+
+Elem makeElem(size_t i) { return Elem{i * 2654435761u, uint32_t(i ^ 0x5a5a)}; }
+
+//! Runs fn in a child process and checks that it dies
+template <typename FnTy>
+void expectDeath(const FnTy& fn) {
+  pid_t pid = fork();
+  GALOIS_ASSERT(pid >= 0, "fork failed");
+  if (pid == 0) {
+    fn();
+    _exit(0);
+  }
+  int status;
+  GALOIS_ASSERT(waitpid(pid, &status, 0) == pid);
+  GALOIS_ASSERT(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT,
+                "reading a truncated checkpoint did not die");
+}
+
+//! A truncated file is detected by both sequential and parallel reads. Runs
+//! before the runtime exists so the children only have the forking thread.
+void testTruncated(const std::string& fileName) {
+  const size_t n = 1000;
+  {
+    CheckpointWriter w(fileName);
+    w.writeValue(uint64_t{n});
+    w.writeVector(std::vector<uint32_t>(100, 7));
+    // same layout writeArray produces
+    w.alignToPage();
+    std::vector<Elem> elems(n);
+    for (size_t i = 0; i < n; ++i)
+      elems[i] = makeElem(i);
+    w.write(elems.data(), n * sizeof(Elem));
+    w.commit();
+  }
+  GALOIS_ASSERT(CheckpointReader::exists(fileName));
+  GALOIS_ASSERT(!CheckpointReader::exists(fileName + ".missing"));
+
+  // cut the file inside the vector
+  GALOIS_ASSERT(truncate(fileName.c_str(), 8 + 8 + 50 * sizeof(uint32_t)) == 0);
+  expectDeath([&]() {
+    CheckpointReader r(fileName);
+    r.readValue<uint64_t>();
+    std::vector<uint32_t> v;
+    r.readVector(v);
+  });
+
+  // cut the file inside the array; caught before any thread reads
+  GALOIS_ASSERT(truncate(fileName.c_str(), 4096 + (n / 2) * sizeof(Elem)) ==
+                0);
+  expectDeath([&]() {
+    CheckpointReader r(fileName);
+    size_t len = r.readValue<uint64_t>();
+    std::vector<uint32_t> v;
+    r.readVector(v);
+    std::vector<Elem> elems(len);
+    r.readArray(elems.data(), len);
+  });
+  std::remove(fileName.c_str());
+}
+
+//! Parallel writes and reads that cross chunk and thread block boundaries
+void testRoundTrip(const std::string& fileName) {
+  const size_t n = 3 * CheckpointWriter::chunkSize + 123;
+  std::vector<Elem> elems(n);
+  for (size_t i = 0; i < n; ++i)
+    elems[i] = makeElem(i);
+  std::vector<uint16_t> header{1, 2, 3};
+
+  uint64_t written;
+  {
+    CheckpointWriter w(fileName);
+    w.writeVector(header);
+    w.writeArray(elems.data(), n);
+    w.writeValue(uint32_t{0xdeadbeef});
+    w.writeParallel<uint64_t>(n, [](size_t i) { return i * i; });
+    written = w.size();
+    w.commit();
+  }
+
+  CheckpointReader r(fileName);
+  std::vector<uint16_t> readHeader;
+  r.readVector(readHeader);
+  GALOIS_ASSERT(readHeader == header);
+  std::vector<Elem> readElems(n);
+  r.readArray(readElems.data(), n);
+  for (size_t i = 0; i < n; ++i)
+    GALOIS_ASSERT(readElems[i].a == elems[i].a && readElems[i].b == elems[i].b,
+                  "element ", i, " differs");
+  GALOIS_ASSERT(r.readValue<uint32_t>() == 0xdeadbeef);
+  std::vector<uint64_t> squares(n);
+  r.readParallel<uint64_t>(n, [&](size_t i, uint64_t v) { squares[i] = v; });
+  for (size_t i = 0; i < n; ++i)
+    GALOIS_ASSERT(squares[i] == i * i, "square ", i, " differs");
+  GALOIS_ASSERT(r.position() == written);
+  std::remove(fileName.c_str());
+}
+
+void makeGraph(const std::string& fileName, uint32_t numNodes) {
+  std::mt19937 gen(numNodes);
+  std::uniform_int_distribution<uint32_t> dist(0, numNodes - 1);
+  std::vector<std::vector<uint32_t>> adj(numNodes);
+  uint64_t numEdges = 0;
+  for (uint32_t n = 0; n < numNodes; ++n) {
+    adj[n].resize(n % 7);
+    for (auto& dst : adj[n])
+      dst = dist(gen);
+    numEdges += adj[n].size();
+  }
+
+  galois::graphs::FileGraphWriter w;
+  w.setNumNodes(numNodes);
+  w.setNumEdges<uint32_t>(numEdges);
+  w.phase1();
+  for (uint32_t n = 0; n < numNodes; ++n)
+    w.incrementDegree(n, adj[n].size());
+  w.phase2();
+  for (uint32_t n = 0; n < numNodes; ++n)
+    for (auto dst : adj[n])
+      w.addNeighbor<uint32_t>(n, dst, n + dst);
+  w.finish();
+  w.toFile(fileName);
+}
+
+//! A local graph read back from disk matches the partitioned one
+void testLocalGraph(const std::string& graphFile,
+                    const std::string& localGraphFile) {
+  makeGraph(graphFile, 3000);
+  auto part = galois::cuspPartitionGraph<GenericCVC, char, uint32_t>(
+      graphFile, galois::CUSP_CSR, galois::CUSP_CSR, true);
+  part->save_local_graph_to_file(localGraphFile);
+  auto read = galois::cuspPartitionGraph<GenericCVC, char, uint32_t>(
+      graphFile, galois::CUSP_CSR, galois::CUSP_CSR, true, "", "", true, 100,
+      galois::graphs::BALANCED_EDGES_OF_MASTERS, 0, 0, true, localGraphFile);
+
+  GALOIS_ASSERT(read->size() == part->size());
+  GALOIS_ASSERT(read->sizeEdges() == part->sizeEdges());
+  GALOIS_ASSERT(read->numMasters() == part->numMasters());
+  GALOIS_ASSERT(read->globalSize() == part->globalSize());
+  GALOIS_ASSERT(read->globalSizeEdges() == part->globalSizeEdges());
+  GALOIS_ASSERT(read->getMirrorNodes() == part->getMirrorNodes());
+  for (uint32_t n = 0; n < part->size(); ++n) {
+    GALOIS_ASSERT(read->getGID(n) == part->getGID(n));
+    GALOIS_ASSERT(read->getLID(part->getGID(n)) == n);
+    auto pe = part->edge_begin(n);
+    auto re = read->edge_begin(n);
+    GALOIS_ASSERT(read->edge_end(n) - re == part->edge_end(n) - pe);
+    for (; pe != part->edge_end(n); ++pe, ++re) {
+      GALOIS_ASSERT(read->getEdgeDst(re) == part->getEdgeDst(pe));
+      GALOIS_ASSERT(read->getEdgeData(re) == part->getEdgeData(pe));
+    }
+  }
+
+  std::remove(graphFile.c_str());
+  std::remove((localGraphFile + "_0").c_str());
+}
+
+int main() {
+  std::string prefix = "checkpoint-test-" + std::to_string(getpid());
+  testTruncated(prefix + ".trunc");
+
+  galois::DistMemSys G;
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+  testRoundTrip(prefix + ".data");
+  testLocalGraph(prefix + ".gr", prefix + ".local");
+  return 0;
+}
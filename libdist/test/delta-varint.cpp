@@ -0,0 +1,209 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * Round trips of the delta+varint codec and of the compressed Gluon message
+ * formats, and rejection of truncated encodings.
+ */
+
+#include "galois/runtime/CompressedMessage.h"
+#include "galois/gIO.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using galois::PODResizeableArray;
+using namespace galois::runtime;
+
+template <typename T>
+void checkRoundTrip(const PODResizeableArray<T>& in) {
+  PODResizeableArray<uint8_t> enc;
+  // encoding appends
+  enc.push_back(0xff);
+  deltaVarintEncode(in.data(), in.size(), enc);
+  GALOIS_ASSERT(enc.size() <= 1 + in.size() * 10);
+
+  PODResizeableArray<T> out;
+  out.resize(in.size());
+  const uint8_t* end = enc.data() + enc.size();
+  GALOIS_ASSERT(deltaVarintDecode(enc.data() + 1, end, out.data(),
+                                  out.size()) == end,
+                "decoding did not consume the encoding");
+  GALOIS_ASSERT(std::equal(in.begin(), in.end(), out.begin()),
+                "round trip changed the values");
+}
+
+// std::vector<bool> has no data(), so values are kept in plain arrays
+template <typename T>
+void checkRoundTrip(std::initializer_list<T> list) {
+  PODResizeableArray<T> in;
+  in.resize(list.size());
+  std::copy(list.begin(), list.end(), in.begin());
+  checkRoundTrip(in);
+}
+
+template <typename T>
+void testCodec() {
+  using Limits = std::numeric_limits<T>;
+  checkRoundTrip<T>({});
+  checkRoundTrip<T>({Limits::min()});
+  checkRoundTrip<T>({Limits::max()});
+  // largest possible steps in both directions
+  checkRoundTrip<T>({Limits::max(), Limits::min(), Limits::max(), T(0),
+                     Limits::min(), T(1), Limits::max()});
+
+  std::mt19937_64 gen(sizeof(T));
+  PODResizeableArray<T> sorted;
+  PODResizeableArray<T> random;
+  sorted.resize(1000);
+  random.resize(1000);
+  uint64_t cur = 0;
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    cur += gen() % 5;
+    sorted[i] = static_cast<T>(cur);
+    random[i] = static_cast<T>(gen());
+  }
+  checkRoundTrip(sorted);
+  checkRoundTrip(random);
+}
+
+//! Runs fn in a child process and checks that it dies
+template <typename FnTy>
+void expectDeath(const FnTy& fn) {
+  pid_t pid = fork();
+  GALOIS_ASSERT(pid >= 0, "fork failed");
+  if (pid == 0) {
+    fn();
+    _exit(0);
+  }
+  int status;
+  GALOIS_ASSERT(waitpid(pid, &status, 0) == pid);
+  GALOIS_ASSERT(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT,
+                "decoding a bad encoding did not die");
+}
+
+void testOverrun() {
+  std::vector<uint64_t> in{1, std::numeric_limits<uint64_t>::max(), 3};
+  PODResizeableArray<uint8_t> enc;
+  deltaVarintEncode(in.data(), in.size(), enc);
+  std::vector<uint64_t> out(in.size() + 1);
+
+  // every proper prefix is missing part of an element
+  for (size_t len = 0; len < enc.size(); ++len) {
+    expectDeath([&]() {
+      deltaVarintDecode(enc.data(), enc.data() + len, out.data(), in.size());
+    });
+  }
+  // asking for more elements than were encoded
+  expectDeath([&]() {
+    deltaVarintDecode(enc.data(), enc.data() + enc.size(), out.data(),
+                      out.size());
+  });
+  // more continuation bytes than a 64 bit element can have
+  std::vector<uint8_t> overlong(11, 0x80);
+  overlong.back() = 0;
+  expectDeath([&]() {
+    deltaVarintDecode(overlong.data(), overlong.data() + overlong.size(),
+                      out.data(), 1);
+  });
+  // zero elements need no bytes
+  GALOIS_ASSERT(deltaVarintDecode(enc.data(), enc.data(), out.data(), 0) ==
+                enc.data());
+}
+
+//! Sends half of num shared nodes with the given mode through the compressed
+//! message format and checks what is received
+template <typename ValTy>
+void testMessage(DataCommMode mode, uint32_t num) {
+  std::mt19937 gen(mode);
+  PODResizeableArray<unsigned int> offsets;
+  galois::DynamicBitSet bitset;
+  bitset.resize(num);
+  PODResizeableArray<ValTy> values;
+  for (uint32_t i = 0; i < num; ++i) {
+    if (mode == onlyData || i % 2 == 0) {
+      offsets.push_back(i);
+      bitset.set(i);
+      values.push_back(static_cast<ValTy>(gen() % 1000));
+    }
+  }
+  size_t count = offsets.size();
+
+  PODResizeableArray<uint8_t> compressedOffsets;
+  PODResizeableArray<uint8_t> compressedValues;
+  size_t rawSize = compressMessage(mode, count, offsets, values,
+                                   compressedOffsets, compressedValues);
+  GALOIS_ASSERT(rawSize > compressedOffsets.size() + compressedValues.size());
+  SendBuffer b;
+  serializeCompressedMessage(b, mode, count, bitset, compressedOffsets,
+                             compressedValues, values);
+
+  RecvBuffer buf(std::move(b));
+  DataCommMode received;
+  gDeserialize(buf, received);
+  GALOIS_ASSERT(received == compressedDataMode(mode));
+  GALOIS_ASSERT(uncompressedDataMode(received) == mode);
+
+  size_t recvCount = num;
+  PODResizeableArray<unsigned int> recvOffsets;
+  galois::DynamicBitSet recvBitset;
+  PODResizeableArray<ValTy> recvValues;
+  PODResizeableArray<uint8_t> scratch;
+  deserializeCompressedMessage(buf, received, num, recvCount, recvOffsets,
+                               recvBitset, recvValues, scratch);
+  GALOIS_ASSERT(recvCount == count);
+  GALOIS_ASSERT(recvValues.size() == count);
+  GALOIS_ASSERT(std::equal(values.begin(), values.end(), recvValues.begin()));
+  if (mode == offsetsData || mode == gidsData) {
+    GALOIS_ASSERT(recvOffsets.size() == count);
+    GALOIS_ASSERT(
+        std::equal(offsets.begin(), offsets.end(), recvOffsets.begin()));
+  } else if (mode == bitsetData) {
+    GALOIS_ASSERT(recvBitset.size() == num);
+    for (uint32_t i = 0; i < num; ++i)
+      GALOIS_ASSERT(recvBitset.test(i) == bitset.test(i));
+  }
+}
+
+int main() {
+  testCodec<int8_t>();
+  testCodec<int32_t>();
+  testCodec<int64_t>();
+  testCodec<uint8_t>();
+  testCodec<uint16_t>();
+  testCodec<uint32_t>();
+  testCodec<uint64_t>();
+  testCodec<bool>();
+
+  testOverrun();
+
+  for (DataCommMode mode : {offsetsData, gidsData, bitsetData, onlyData}) {
+    testMessage<uint32_t>(mode, 1000);
+    testMessage<int64_t>(mode, 1000);
+  }
+  // non-integral values are sent as is next to compressed offsets
+  testMessage<float>(offsetsData, 1000);
+  testMessage<float>(gidsData, 1000);
+  return 0;
+}
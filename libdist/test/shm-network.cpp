@@ -0,0 +1,105 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * Runs several hosts as forked processes that talk over the shared memory
+ * network IO layer, without MPI.
+ */
+
+#include "galois/runtime/NetworkIO.h"
+#include "galois/gIO.h"
+
+#include <algorithm>
+
+#include <sys/wait.h>
+
+using galois::runtime::NetworkIO;
+
+//! message from src to dst; larger than a ring for some pairs
+NetworkIO::message makeMessage(uint32_t src, uint32_t dst, uint32_t tag) {
+  size_t size = 1 + (src * 7 + dst * 13 + tag) % 3 * 40000;
+  galois::PODResizeableArray<uint8_t> data;
+  data.resize(size);
+  for (size_t i = 0; i < size; ++i)
+    data[i] = static_cast<uint8_t>(src + dst + tag + i);
+  return NetworkIO::message(dst, tag, std::move(data));
+}
+
+void runHost(uint32_t id, uint32_t num, const std::string& name) {
+  galois::runtime::MemUsageTracker tracker;
+  std::atomic<size_t> sends(0);
+  std::atomic<size_t> recvs(0);
+  // small rings make messages wrap around and stream in pieces
+  auto net = std::get<0>(galois::runtime::makeNetworkIOShm(
+      tracker, sends, recvs, id, num, name, 4096));
+
+  const uint32_t numTags = 8;
+  for (uint32_t tag = 1; tag <= numTags; ++tag) {
+    for (uint32_t h = 0; h < num; ++h) {
+      ++sends;
+      net->enqueue(makeMessage(id, h, tag));
+    }
+  }
+
+  // messages from one host arrive in the order they were sent
+  std::vector<uint32_t> nextTag(num, 1);
+  uint32_t received = 0;
+  while (received < num * numTags || sends) {
+    net->progress();
+    NetworkIO::message m = net->dequeue();
+    if (!m.valid())
+      continue;
+    GALOIS_ASSERT(m.tag == nextTag[m.host], "out of order message");
+    auto expected = makeMessage(m.host, id, m.tag);
+    GALOIS_ASSERT(m.data.size() == expected.data.size());
+    GALOIS_ASSERT(std::equal(m.data.begin(), m.data.end(),
+                             expected.data.begin()),
+                  "corrupt message");
+    nextTag[m.host] += 1;
+    received += 1;
+  }
+  GALOIS_ASSERT(recvs == num * numTags);
+}
+
+int main(int argc, char** argv) {
+  uint32_t num = 4;
+  if (argc > 1)
+    num = atoi(argv[1]);
+  std::string name = "/galois-test-" + std::to_string(getpid());
+
+  std::vector<pid_t> children;
+  for (uint32_t id = 1; id < num; ++id) {
+    pid_t pid = fork();
+    GALOIS_ASSERT(pid >= 0, "fork failed");
+    if (pid == 0) {
+      runHost(id, num, name);
+      return 0;
+    }
+    children.push_back(pid);
+  }
+  runHost(0, num, name);
+
+  for (pid_t pid : children) {
+    int status;
+    GALOIS_ASSERT(waitpid(pid, &status, 0) == pid);
+    GALOIS_ASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0,
+                  "host process failed");
+  }
+  return 0;
+}
@@ -23,6 +23,7 @@
 #include <iterator>
 #include <stdexcept>
 #include <cstddef>
+#include <cstring>
 #include <algorithm>
 #include <utility>
 #include <type_traits>
@@ -29,6 +29,7 @@
 #include "galois/UserContext.h"
 #include "galois/Threads.h"
 #include "galois/worklists/Chunk.h"
+#include "galois/worklists/StealingDeque.h"
 
 namespace galois {
 //! Parallel versions of STL library algorithms.
@@ -249,7 +250,7 @@ void sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
     std::sort(first, last, comp);
     return;
   }
-  typedef galois::worklists::PerSocketChunkFIFO<1> WL;
+  typedef galois::worklists::StealingDeque<> WL;
 
   for_each(galois::iterate({std::make_pair(first, last)}),
            sort_helper<Compare>(comp), galois::disable_conflict_detection(),
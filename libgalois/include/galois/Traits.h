@@ -20,6 +20,7 @@
 #ifndef GALOIS_TRAITS_H
 #define GALOIS_TRAITS_H
 
+#include <functional>
 #include <tuple>
 #include <type_traits>
 
@@ -260,6 +261,22 @@ struct disable_conflict_detection_tag {};
 struct disable_conflict_detection : public trait_has_type<bool>,
                                     disable_conflict_detection_tag {};
 
+/**
+ * Indicates the operator checks UserContext::isConflicted() after acquiring
+ * its neighborhood and returns early on a conflict. Conflicts are then
+ * reported through a flag instead of by throwing (or longjmp-ing) out of the
+ * operator, which avoids unwinding cost when aborts are frequent.
+ *
+ * Graph methods that acquire and write in one call, such as the addNode,
+ * addEdge and removeNode methods of the Morph graphs, do not check the flag
+ * and write even if their acquire failed. Such operators must acquire every
+ * node they change through read-only accesses (e.g. getData or edges) and
+ * check isConflicted() before calling any of them; otherwise this trait is
+ * only safe with read-only neighborhood access.
+ */
+struct flag_conflicts_tag {};
+struct flag_conflicts : public trait_has_type<bool>, flag_conflicts_tag {};
+
 /**
  * Indicates that the neighborhood set does not change through out i.e. is not
  * dependent on computed values. Examples of such fixed neighborhood is e.g.
@@ -366,6 +383,39 @@ public:
   chunk_size(unsigned cs = SZ) : trait_has_value(clamp(cs)) {}
 };
 
+/**
+ * Let work-stealing {@link do_all()} loops adjust their chunk size online.
+ *
+ * The chunk_size trait gives the initial size. Each thread then grows or
+ * shrinks its chunks so that one chunk takes roughly the same time to run,
+ * halves them when another thread steals from it, and never takes more than
+ * its share of the remaining local work (guided self-scheduling). The sizes
+ * chosen are reported as loop statistics.
+ */
+struct adaptive_chunk_size_tag {};
+struct adaptive_chunk_size : public trait_has_type<bool>,
+                             adaptive_chunk_size_tag {};
+
+/**
+ * Combines the values an operator over galois::iterate_edges_balanced()
+ * returns for the pieces of the edges of a node, and passes the result
+ * to a hook.
+ *
+ * The hook has the signature <code>void(node, T)</code>, where T is the
+ * return type of the operator, and is called exactly once per node. The hook
+ * gets the value of a node whose edges are not split as is; the values of the
+ * pieces of a split node are combined with combine (operator+ by default) in
+ * the order of the edges they cover, starting from the first piece.
+ */
+struct edge_reduce_tag {};
+template <typename F, typename C = std::plus<>>
+struct edge_reduce : public edge_reduce_tag {
+  F finish;
+  C combine;
+
+  edge_reduce(const F& f, const C& c = C()) : finish(f), combine(c) {}
+};
+
 typedef worklists::PerSocketChunkFIFO<chunk_size<>::value> defaultWL;
 
 namespace internal {
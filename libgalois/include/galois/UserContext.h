@@ -101,8 +101,25 @@ public:
     this->push(std::forward<Args>(args)...);
   }
 
-  //! Force the abort of this iteration
-  void abort() { galois::runtime::signalConflict(); }
+  //! Force the abort of this iteration. In loops with the flag_conflicts
+  //! trait, this only marks the iteration and the operator has to return.
+  void abort() {
+    runtime::SimpleRuntimeContext* ctx = runtime::getThreadContext();
+    if (ctx && ctx->isFlaggingConflicts())
+      ctx->markConflicted();
+    else
+      galois::runtime::signalConflict();
+  }
+
+  //! used by loops with the flag_conflicts trait
+  //! @returns true when another iteration holds a lock this iteration tried
+  //! to acquire. The operator must then return without changing shared
+  //! state; the iteration is aborted and retried later. Graph mutators do not
+  //! check this themselves (see galois::flag_conflicts).
+  bool isConflicted() const {
+    runtime::SimpleRuntimeContext* ctx = runtime::getThreadContext();
+    return ctx && ctx->isConflicted();
+  }
 
   //! Store and retrieve local state for deterministic
   template <typename LS>
@@ -33,6 +33,7 @@
 #include "galois/config.h"
 #include "galois/gIO.h"
 #include "galois/Reduction.h"
+#include "galois/graphs/ParallelFileReader.h"
 
 namespace galois {
 namespace graphs {
@@ -87,11 +88,11 @@ private:
    * Load the out indices (i.e. where a particular node's edges begin in the
    * array of edges) from the file.
    *
-   * @param graphFile loaded file for the graph
+   * @param graphFile reader of the file for the graph
    * @param nodeStart the first node to load
    * @param numNodesToLoad number of nodes to load
    */
-  void loadOutIndex(std::ifstream& graphFile, uint64_t nodeStart,
+  void loadOutIndex(ParallelFileReader& graphFile, uint64_t nodeStart,
                     uint64_t numNodesToLoad) {
     if (numNodesToLoad == 0) {
       return;
@@ -105,19 +106,8 @@ private:
 
     // position to start of contiguous chunk of nodes to read
     uint64_t readPosition = (4 + nodeStart) * sizeof(uint64_t);
-    graphFile.seekg(readPosition);
-
-    uint64_t numBytesToLoad = numNodesToLoad * sizeof(uint64_t);
-    uint64_t bytesRead      = 0;
-
-    while (numBytesToLoad > 0) {
-      graphFile.read(((char*)this->outIndexBuffer) + bytesRead, numBytesToLoad);
-      size_t numRead = graphFile.gcount();
-      numBytesToLoad -= numRead;
-      bytesRead += numRead;
-    }
-
-    assert(numBytesToLoad == 0);
+    graphFile.read(outIndexBuffer, readPosition,
+                   numNodesToLoad * sizeof(uint64_t));
 
     nodeOffset = nodeStart;
   }
@@ -125,13 +115,13 @@ private:
   /**
    * Load the edge destination information from the file.
    *
-   * @param graphFile loaded file for the graph
+   * @param graphFile reader of the file for the graph
    * @param edgeStart the first edge to load
    * @param numEdgesToLoad number of edges to load
    * @param numGlobalNodes total number of nodes in the graph file; needed
    * to determine offset into the file
    */
-  void loadEdgeDest(std::ifstream& graphFile, uint64_t edgeStart,
+  void loadEdgeDest(ParallelFileReader& graphFile, uint64_t edgeStart,
                     uint64_t numEdgesToLoad, uint64_t numGlobalNodes) {
     if (numEdgesToLoad == 0) {
       return;
@@ -147,18 +137,8 @@ private:
     // position to start of contiguous chunk of edges to read
     uint64_t readPosition = (4 + numGlobalNodes) * sizeof(uint64_t) +
                             (sizeof(uint32_t) * edgeStart);
-    graphFile.seekg(readPosition);
-
-    uint64_t numBytesToLoad = numEdgesToLoad * sizeof(uint32_t);
-    uint64_t bytesRead      = 0;
-    while (numBytesToLoad > 0) {
-      graphFile.read(((char*)this->edgeDestBuffer) + bytesRead, numBytesToLoad);
-      size_t numRead = graphFile.gcount();
-      numBytesToLoad -= numRead;
-      bytesRead += numRead;
-    }
-
-    assert(numBytesToLoad == 0);
+    graphFile.read(edgeDestBuffer, readPosition,
+                   numEdgesToLoad * sizeof(uint32_t));
     // save edge offset of this graph for later use
     edgeOffset = edgeStart;
   }
@@ -168,6 +148,7 @@ private:
    *
    * @tparam EdgeType must be non-void in order to call this function
    *
+   * @param graphFile reader of the file for the graph
    * @param edgeStart the first edge to load
    * @param numEdgesToLoad number of edges to load
    * @param numGlobalNodes total number of nodes in the graph file; needed
@@ -178,7 +159,7 @@ private:
   template <
       typename EdgeType,
       typename std::enable_if<!std::is_void<EdgeType>::value>::type* = nullptr>
-  void loadEdgeData(std::ifstream& graphFile, uint64_t edgeStart,
+  void loadEdgeData(ParallelFileReader& graphFile, uint64_t edgeStart,
                     uint64_t numEdgesToLoad, uint64_t numGlobalNodes,
                     uint64_t numGlobalEdges) {
     galois::gDebug("Loading edge data");
@@ -207,18 +188,8 @@ private:
     // jump to first byte of edge data
     uint64_t readPosition =
         baseReadPosition + (sizeof(EdgeDataType) * edgeStart);
-    graphFile.seekg(readPosition);
-    uint64_t numBytesToLoad = numEdgesToLoad * sizeof(EdgeDataType);
-    uint64_t bytesRead      = 0;
-
-    while (numBytesToLoad > 0) {
-      graphFile.read(((char*)this->edgeDataBuffer) + bytesRead, numBytesToLoad);
-      size_t numRead = graphFile.gcount();
-      numBytesToLoad -= numRead;
-      bytesRead += numRead;
-    }
-
-    assert(numBytesToLoad == 0);
+    graphFile.read(edgeDataBuffer, readPosition,
+                   numEdgesToLoad * sizeof(EdgeDataType));
   }
 
   /**
@@ -232,7 +203,8 @@ private:
   template <
       typename EdgeType,
       typename std::enable_if<std::is_void<EdgeType>::value>::type* = nullptr>
-  void loadEdgeData(std::ifstream&, uint64_t, uint64_t, uint64_t, uint64_t) {
+  void loadEdgeData(ParallelFileReader&, uint64_t, uint64_t, uint64_t,
+                    uint64_t) {
     galois::gDebug("Not loading edge data");
     // do nothing (edge data is void, i.e. no edge data)
   }
@@ -304,19 +276,21 @@ public:
   uint64_t getNodeOffset() const { return nodeOffset; }
 
   /**
-   * Loads given Galois CSR graph into memory.
+   * Loads given Galois CSR graph into memory. The file is read in parallel
+   * by all active threads (see ParallelFileReader).
    *
    * @param filename name of graph to load; should be in Galois binary graph
    * format
+   * @param direct if true, bypass the page cache with O_DIRECT
    */
-  void loadGraph(const std::string& filename) {
+  void loadGraph(const std::string& filename, bool direct = false) {
     if (graphLoaded) {
       GALOIS_DIE("Cannot load an buffered graph more than once.");
     }
 
-    std::ifstream graphFile(filename.c_str());
+    ParallelFileReader graphFile(filename, direct);
     uint64_t header[4];
-    graphFile.read(((char*)header), sizeof(uint64_t) * 4);
+    graphFile.readSerial(header, 0, sizeof(uint64_t) * 4);
 
     numLocalNodes = globalSize = header[2];
     numLocalEdges = globalEdgeSize = header[3];
@@ -328,12 +302,13 @@ public:
                                globalEdgeSize);
     graphLoaded = true;
 
-    graphFile.close();
+    graphFile.reportStats("BufferedGraph");
   }
 
   /**
    * Given a node/edge range to load, loads the specified portion of the graph
-   * into memory buffers using read.
+   * into memory buffers. Each portion is read in parallel by all active
+   * threads (see ParallelFileReader).
    *
    * @param filename name of graph to load; should be in Galois binary graph
    * format
@@ -344,15 +319,17 @@ public:
    * @param edgeEnd Last edge to load, non-inclusive
    * @param numGlobalNodes Total number of nodes in the graph
    * @param numGlobalEdges Total number of edges in the graph
+   * @param direct if true, bypass the page cache with O_DIRECT
    */
   void loadPartialGraph(const std::string& filename, uint64_t nodeStart,
                         uint64_t nodeEnd, uint64_t edgeStart, uint64_t edgeEnd,
-                        uint64_t numGlobalNodes, uint64_t numGlobalEdges) {
+                        uint64_t numGlobalNodes, uint64_t numGlobalEdges,
+                        bool direct = false) {
     if (graphLoaded) {
       GALOIS_DIE("Cannot load an buffered graph more than once.");
     }
 
-    std::ifstream graphFile(filename.c_str());
+    ParallelFileReader graphFile(filename, direct);
 
     globalSize     = numGlobalNodes;
     globalEdgeSize = numGlobalEdges;
@@ -370,7 +347,7 @@ public:
                                numGlobalNodes, numGlobalEdges);
     graphLoaded = true;
 
-    graphFile.close();
+    graphFile.reportStats("BufferedGraph");
   }
 
   //! Edge iterator typedef
@@ -0,0 +1,590 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file GraphOrdering.h
+ *
+ * Locality-improving node orderings. Each ordering fills a permutation perm
+ * where perm[i] is the new id of node i, the convention used by
+ * galois::graphs::permute. The graph only needs size, edge_begin, edge_end
+ * and getEdgeDst, so the orderings work on both FileGraph and the LC graphs.
+ *
+ * The relabel functions at the end apply an ordering to an in-memory graph
+ * that supports permute (e.g. LC_CSR_Graph).
+ */
+
+#ifndef GALOIS_GRAPHS_GRAPHORDERING_H
+#define GALOIS_GRAPHS_GRAPHORDERING_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "galois/config.h"
+#include "galois/AtomicHelpers.h"
+#include "galois/Galois.h"
+#include "galois/LargeArray.h"
+#include "galois/ParallelSTL.h"
+
+namespace galois {
+namespace graphs {
+
+namespace internal {
+
+//! Computes the out-degree of every node in parallel
+template <typename GraphTy>
+void computeDegrees(GraphTy& graph, LargeArray<uint64_t>& degree) {
+  degree.allocateBlocked(graph.size());
+  galois::do_all(
+      galois::iterate(size_t{0}, size_t{graph.size()}),
+      [&](size_t n) {
+        degree[n] = std::distance(graph.edge_begin(n), graph.edge_end(n));
+      },
+      galois::no_stats());
+}
+
+/**
+ * In-edges of a graph in CSR form: the sources of the in-edges of node n are
+ * src[index[n]] to src[index[n + 1]], sorted by id.
+ */
+struct InEdges {
+  LargeArray<uint64_t> index;
+  LargeArray<uint32_t> src;
+
+  uint64_t degree(uint32_t n) const { return index[n + 1] - index[n]; }
+};
+
+//! Builds the transpose of a graph in parallel
+template <typename GraphTy>
+void computeInEdges(GraphTy& graph, InEdges& in) {
+  size_t numNodes = graph.size();
+
+  LargeArray<std::atomic<uint64_t>> cursor;
+  cursor.allocateBlocked(numNodes);
+  galois::do_all(
+      galois::iterate(size_t{0}, numNodes),
+      [&](size_t n) { cursor.constructAt(n, 0); }, galois::no_stats());
+  galois::do_all(
+      galois::iterate(size_t{0}, numNodes),
+      [&](size_t n) {
+        for (auto jj = graph.edge_begin(n), ej = graph.edge_end(n); jj != ej;
+             ++jj)
+          cursor[graph.getEdgeDst(jj)].fetch_add(1, std::memory_order_relaxed);
+      },
+      galois::steal(), galois::no_stats());
+
+  in.index.allocateBlocked(numNodes + 1);
+  in.index[0] = 0;
+  galois::do_all(
+      galois::iterate(size_t{0}, numNodes),
+      [&](size_t n) { in.index[n + 1] = cursor[n].load(); },
+      galois::no_stats());
+  galois::ParallelSTL::partial_sum(in.index.begin() + 1, in.index.end(),
+                                   in.index.begin() + 1);
+
+  in.src.allocateBlocked(in.index[numNodes]);
+  galois::do_all(
+      galois::iterate(size_t{0}, numNodes),
+      [&](size_t n) { cursor[n].store(in.index[n]); }, galois::no_stats());
+  galois::do_all(
+      galois::iterate(size_t{0}, numNodes),
+      [&](size_t n) {
+        for (auto jj = graph.edge_begin(n), ej = graph.edge_end(n); jj != ej;
+             ++jj) {
+          uint64_t pos = cursor[graph.getEdgeDst(jj)].fetch_add(
+              1, std::memory_order_relaxed);
+          in.src[pos] = n;
+        }
+      },
+      galois::steal(), galois::no_stats());
+
+  // make the result independent of the schedule
+  galois::do_all(
+      galois::iterate(size_t{0}, numNodes),
+      [&](size_t n) {
+        std::sort(in.src.begin() + in.index[n],
+                  in.src.begin() + in.index[n + 1]);
+      },
+      galois::steal(), galois::no_stats());
+}
+
+/**
+ * Max-priority queue of nodes whose keys only change by one at a time
+ * (the "unit heap" of Gorder). Nodes with the same key are kept in a
+ * doubly linked list per key, so increment, decrement and pop are O(1)
+ * amortized.
+ */
+class UnitHeap {
+  static constexpr uint32_t nil = std::numeric_limits<uint32_t>::max();
+
+  std::vector<uint32_t> key;
+  std::vector<uint32_t> prev;
+  std::vector<uint32_t> next;
+  std::vector<uint32_t> head;
+  std::vector<bool> removed;
+  uint32_t top = 0;
+
+  void unlink(uint32_t n) {
+    if (prev[n] != nil)
+      next[prev[n]] = next[n];
+    else
+      head[key[n]] = next[n];
+    if (next[n] != nil)
+      prev[next[n]] = prev[n];
+  }
+
+  void link(uint32_t n) {
+    prev[n] = nil;
+    next[n] = head[key[n]];
+    if (next[n] != nil)
+      prev[next[n]] = n;
+    head[key[n]] = n;
+  }
+
+public:
+  //! Creates a heap holding nodes [0, numNodes) with key 0
+  explicit UnitHeap(uint32_t numNodes)
+      : key(numNodes, 0), prev(numNodes), next(numNodes), head(1, nil),
+        removed(numNodes, false) {
+    // link in reverse so that ties are popped in id order
+    for (uint32_t n = numNodes; n-- > 0;)
+      link(n);
+  }
+
+  void increment(uint32_t n) {
+    if (removed[n])
+      return;
+    unlink(n);
+    if (++key[n] == head.size())
+      head.push_back(nil);
+    link(n);
+    top = std::max(top, key[n]);
+  }
+
+  void decrement(uint32_t n) {
+    if (removed[n])
+      return;
+    unlink(n);
+    --key[n];
+    link(n);
+  }
+
+  void remove(uint32_t n) {
+    unlink(n);
+    removed[n] = true;
+  }
+
+  //! Removes and returns a node with the largest key; heap must not be empty
+  uint32_t pop() {
+    while (top > 0 && head[top] == nil)
+      --top;
+    uint32_t n = head[top];
+    assert(n != nil);
+    remove(n);
+    return n;
+  }
+};
+
+} // namespace internal
+
+/**
+ * Orders nodes by decreasing out-degree; nodes with the same degree keep
+ * their relative order.
+ *
+ * @param graph graph to order
+ * @param perm output permutation with at least graph.size() entries
+ */
+template <typename GraphTy, typename PermTy>
+void degreeOrder(GraphTy& graph, PermTy& perm) {
+  size_t numNodes = graph.size();
+
+  LargeArray<uint64_t> degree;
+  internal::computeDegrees(graph, degree);
+  LargeArray<uint32_t> order;
+  order.allocateBlocked(numNodes);
+  galois::do_all(
+      galois::iterate(size_t{0}, numNodes),
+      [&](size_t n) { order[n] = n; }, galois::no_stats());
+  galois::ParallelSTL::sort(order.begin(), order.end(),
+                            [&](uint32_t a, uint32_t b) {
+                              return degree[a] > degree[b] ||
+                                     (degree[a] == degree[b] && a < b);
+                            });
+
+  galois::do_all(
+      galois::iterate(size_t{0}, numNodes),
+      [&](size_t i) { perm[order[i]] = i; }, galois::no_stats());
+}
+
+/**
+ * Reverse Cuthill-McKee ordering. Each connected component (with respect to
+ * out-edges; the ordering is meant for symmetric graphs) is traversed
+ * breadth-first from its lowest degree node, visiting the children of each
+ * node in increasing degree order, and the resulting order is reversed.
+ *
+ * Every BFS level is expanded in parallel: frontier nodes first claim their
+ * unvisited neighbors with an atomic min on their position in the frontier,
+ * so each child is assigned to its earliest parent exactly as in the serial
+ * algorithm, and then every frontier node places and sorts its own children.
+ * The result is deterministic.
+ *
+ * @param graph graph to order
+ * @param perm output permutation with at least graph.size() entries
+ */
+template <typename GraphTy, typename PermTy>
+void rcmOrder(GraphTy& graph, PermTy& perm) {
+  constexpr uint32_t unclaimed = std::numeric_limits<uint32_t>::max();
+  size_t numNodes              = graph.size();
+
+  LargeArray<uint64_t> degree;
+  internal::computeDegrees(graph, degree);
+  auto byDegree = [&](uint32_t a, uint32_t b) {
+    return degree[a] < degree[b] || (degree[a] == degree[b] && a < b);
+  };
+
+  // candidate start nodes, lowest degree first
+  LargeArray<uint32_t> starts;
+  starts.allocateBlocked(numNodes);
+  galois::do_all(
+      galois::iterate(size_t{0}, numNodes),
+      [&](size_t n) { starts[n] = n; }, galois::no_stats());
+  galois::ParallelSTL::sort(starts.begin(), starts.end(), byDegree);
+
+  LargeArray<std::atomic<uint32_t>> parent;
+  LargeArray<uint8_t> visited;
+  LargeArray<uint32_t> order;
+  LargeArray<uint64_t> offsets;
+  parent.allocateBlocked(numNodes);
+  visited.allocateBlocked(numNodes);
+  order.allocateBlocked(numNodes);
+  offsets.allocateBlocked(numNodes + 1);
+  galois::do_all(
+      galois::iterate(size_t{0}, numNodes),
+      [&](size_t n) {
+        parent.constructAt(n, unclaimed);
+        visited[n] = 0;
+      },
+      galois::no_stats());
+
+  size_t numPlaced = 0;
+  size_t nextStart = 0;
+  while (numPlaced < numNodes) {
+    while (visited[starts[nextStart]])
+      ++nextStart;
+    uint32_t source  = starts[nextStart];
+    visited[source]  = 1;
+    order[numPlaced] = source;
+
+    size_t levelBegin = numPlaced;
+    size_t levelEnd   = ++numPlaced;
+    while (levelBegin < levelEnd) {
+      // claim unvisited children for their earliest parent
+      galois::do_all(
+          galois::iterate(levelBegin, levelEnd),
+          [&](size_t i) {
+            uint32_t n = order[i];
+            for (auto jj = graph.edge_begin(n), ej = graph.edge_end(n);
+                 jj != ej; ++jj) {
+              uint32_t dst = graph.getEdgeDst(jj);
+              if (!visited[dst])
+                galois::atomicMin(parent[dst], static_cast<uint32_t>(i));
+            }
+          },
+          galois::steal(), galois::no_stats());
+
+      // count children; only the parent touches a claimed child, and
+      // visited marks also filter out multi-edges
+      galois::do_all(
+          galois::iterate(levelBegin, levelEnd),
+          [&](size_t i) {
+            uint32_t n     = order[i];
+            uint64_t count = 0;
+            for (auto jj = graph.edge_begin(n), ej = graph.edge_end(n);
+                 jj != ej; ++jj) {
+              uint32_t dst = graph.getEdgeDst(jj);
+              if (parent[dst].load(std::memory_order_relaxed) == i &&
+                  !visited[dst]) {
+                visited[dst] = 1;
+                ++count;
+              }
+            }
+            offsets[i - levelBegin + 1] = count;
+          },
+          galois::steal(), galois::no_stats());
+
+      offsets[0] = levelEnd;
+      std::partial_sum(offsets.begin(), offsets.begin() + levelEnd -
+                                            levelBegin + 1,
+                       offsets.begin());
+
+      // place children after the current level, sorted by degree
+      galois::do_all(
+          galois::iterate(levelBegin, levelEnd),
+          [&](size_t i) {
+            uint32_t n   = order[i];
+            uint64_t pos = offsets[i - levelBegin];
+            for (auto jj = graph.edge_begin(n), ej = graph.edge_end(n);
+                 jj != ej; ++jj) {
+              uint32_t dst = graph.getEdgeDst(jj);
+              if (parent[dst].load(std::memory_order_relaxed) == i &&
+                  visited[dst] == 1) {
+                visited[dst] = 2;
+                order[pos++] = dst;
+              }
+            }
+            std::sort(order.begin() + offsets[i - levelBegin],
+                      order.begin() + pos, byDegree);
+          },
+          galois::steal(), galois::no_stats());
+
+      size_t nextEnd = offsets[levelEnd - levelBegin];
+      levelBegin     = levelEnd;
+      levelEnd       = nextEnd;
+      numPlaced      = nextEnd;
+    }
+  }
+
+  galois::do_all(
+      galois::iterate(size_t{0}, numNodes),
+      [&](size_t i) { perm[order[i]] = numNodes - 1 - i; },
+      galois::no_stats());
+}
+
+/**
+ * Gorder ordering (Wei et al., "Speedup Graph Processing by Graph
+ * Ordering", SIGMOD 2016). Nodes are placed greedily: the next node is the
+ * one with the highest locality score with respect to the last window
+ * placed nodes, where the score of a pair of nodes counts the edges between
+ * them plus their common in-neighbors. In-neighbors with more than
+ * sqrt(graph.size()) out-edges are not counted as common neighbors.
+ *
+ * Degrees and the transpose are computed in parallel; the greedy placement
+ * itself is inherently sequential.
+ *
+ * @param graph graph to order
+ * @param perm output permutation with at least graph.size() entries
+ * @param window number of recently placed nodes that determine the score
+ */
+template <typename GraphTy, typename PermTy>
+void gorderOrder(GraphTy& graph, PermTy& perm, unsigned window = 5) {
+  size_t numNodes = graph.size();
+  if (numNodes == 0)
+    return;
+
+  LargeArray<uint64_t> degree;
+  internal::computeDegrees(graph, degree);
+  internal::InEdges in;
+  internal::computeInEdges(graph, in);
+  uint64_t hubDegree = std::sqrt(static_cast<double>(numNodes));
+
+  internal::UnitHeap heap(numNodes);
+  auto update = [&](uint32_t n, bool add) {
+    auto change = [&](uint32_t m) {
+      if (add)
+        heap.increment(m);
+      else
+        heap.decrement(m);
+    };
+    for (auto jj = graph.edge_begin(n), ej = graph.edge_end(n); jj != ej;
+         ++jj)
+      change(graph.getEdgeDst(jj));
+    for (uint64_t ii = in.index[n], ei = in.index[n + 1]; ii != ei; ++ii) {
+      uint32_t src = in.src[ii];
+      change(src);
+      if (degree[src] > hubDegree)
+        continue;
+      for (auto jj = graph.edge_begin(src), ej = graph.edge_end(src); jj != ej;
+           ++jj) {
+        uint32_t sibling = graph.getEdgeDst(jj);
+        if (sibling != n)
+          change(sibling);
+      }
+    }
+  };
+
+  // start from the node with the most in-edges
+  uint32_t start = 0;
+  for (uint32_t n = 1; n < numNodes; ++n)
+    if (in.degree(n) > in.degree(start))
+      start = n;
+
+  LargeArray<uint32_t> order;
+  order.allocateBlocked(numNodes);
+  heap.remove(start);
+  for (size_t i = 0; i < numNodes; ++i) {
+    uint32_t n = i == 0 ? start : heap.pop();
+    order[i]   = n;
+    update(n, true);
+    if (i >= window)
+      update(order[i - window], false);
+  }
+
+  galois::do_all(
+      galois::iterate(size_t{0}, numNodes),
+      [&](size_t i) { perm[order[i]] = i; }, galois::no_stats());
+}
+
+/**
+ * Degree-based grouping (Faldu et al., "A Closer Look at Lightweight Graph
+ * Reordering", IISWC 2019). Nodes are put into groups by out-degree
+ * relative to the average degree d: nodes below d form the last group, and
+ * nodes with degree in [d * 2^(k-1), d * 2^k) form group k (the top group
+ * is unbounded). Groups are laid out from highest to lowest degree and the
+ * original order is kept within a group, so hubs are clustered together
+ * without destroying any existing locality among the remaining nodes. With
+ * two groups this is plain hub clustering.
+ *
+ * @param graph graph to order
+ * @param perm output permutation with at least graph.size() entries
+ * @param numGroups number of degree groups; must be at least 1
+ */
+template <typename GraphTy, typename PermTy>
+void degreeGroupOrder(GraphTy& graph, PermTy& perm, unsigned numGroups = 8) {
+  size_t numNodes = graph.size();
+  if (numNodes == 0)
+    return;
+  numGroups = std::max(numGroups, 1u);
+
+  LargeArray<uint64_t> degree;
+  internal::computeDegrees(graph, degree);
+  double avgDegree = static_cast<double>(graph.sizeEdges()) / numNodes;
+  auto group       = [&](uint32_t n) -> unsigned {
+    if (degree[n] < avgDegree || avgDegree == 0)
+      return numGroups - 1;
+    unsigned k = 1 + std::floor(std::log2(degree[n] / avgDegree));
+    return numGroups - 1 - std::min(k, numGroups - 1);
+  };
+
+  // stable counting sort over contiguous blocks of nodes
+  size_t numBlocks = std::min<size_t>(numNodes, 8 * galois::getActiveThreads());
+  auto blockBegin  = [&](size_t b) { return b * numNodes / numBlocks; };
+  std::vector<uint64_t> counts(numBlocks * numGroups, 0);
+  galois::do_all(
+      galois::iterate(size_t{0}, numBlocks),
+      [&](size_t b) {
+        for (size_t n = blockBegin(b), e = blockBegin(b + 1); n < e; ++n)
+          ++counts[b * numGroups + group(n)];
+      },
+      galois::no_stats());
+
+  std::vector<uint64_t> offsets(numBlocks * numGroups);
+  uint64_t offset = 0;
+  for (unsigned g = 0; g < numGroups; ++g) {
+    for (size_t b = 0; b < numBlocks; ++b) {
+      offsets[b * numGroups + g] = offset;
+      offset += counts[b * numGroups + g];
+    }
+  }
+
+  galois::do_all(
+      galois::iterate(size_t{0}, numBlocks),
+      [&](size_t b) {
+        for (size_t n = blockBegin(b), e = blockBegin(b + 1); n < e; ++n)
+          perm[n] = offsets[b * numGroups + group(n)]++;
+      },
+      galois::no_stats());
+}
+
+/**
+ * Relabels the nodes of an in-memory graph: node n becomes node perm[n].
+ *
+ * @param graph graph to relabel; must provide permute (e.g. LC_CSR_Graph)
+ * @param perm permutation with perm[n] the new id of node n
+ */
+template <typename GraphTy, typename PermTy>
+void permute(GraphTy& graph, const PermTy& perm) {
+  graph.permute(perm);
+}
+
+/**
+ * Node id maps of an in-memory graph relabeled with one of the relabel
+ * functions, used to translate node ids given by the user to the relabeled
+ * graph and ids of the relabeled graph back to the input for output. If the
+ * graph was not relabeled, both translations are the identity.
+ */
+class NodeRelabeling {
+  LargeArray<uint32_t> oldToNew;
+  LargeArray<uint32_t> newToOld;
+
+public:
+  /**
+   * Computes an ordering of graph with orderFn(graph, perm) and relabels
+   * the graph with it.
+   */
+  template <typename GraphTy, typename OrderFn>
+  void apply(GraphTy& graph, OrderFn orderFn) {
+    size_t numNodes = graph.size();
+    oldToNew.deallocate();
+    newToOld.deallocate();
+    oldToNew.allocateBlocked(numNodes);
+    newToOld.allocateBlocked(numNodes);
+
+    orderFn(graph, oldToNew);
+    galois::do_all(
+        galois::iterate(size_t{0}, numNodes),
+        [&](size_t n) { newToOld[oldToNew[n]] = n; }, galois::no_stats());
+    permute(graph, oldToNew);
+  }
+
+  //! True if the graph was not relabeled
+  bool isIdentity() const { return oldToNew.size() == 0; }
+
+  //! Id in the relabeled graph of node n of the input
+  uint32_t toNew(uint32_t n) const { return isIdentity() ? n : oldToNew[n]; }
+
+  //! Id in the input of node n of the relabeled graph
+  uint32_t toOld(uint32_t n) const { return isIdentity() ? n : newToOld[n]; }
+
+  //! Permutation with the new id of every input node; empty if identity
+  const LargeArray<uint32_t>& getOldToNew() const { return oldToNew; }
+};
+
+/**
+ * Relabels an in-memory graph so that nodes are sorted by decreasing degree.
+ *
+ * @param graph graph to relabel
+ * @param relabeling receives the id maps between input and relabeled graph
+ */
+template <typename GraphTy>
+void relabelByDegree(GraphTy& graph, NodeRelabeling& relabeling) {
+  relabeling.apply(graph, [](GraphTy& g, LargeArray<uint32_t>& p) {
+    degreeOrder(g, p);
+  });
+}
+
+/**
+ * Relabels an in-memory graph with the reverse Cuthill-McKee ordering.
+ *
+ * @param graph graph to relabel
+ * @param relabeling receives the id maps between input and relabeled graph
+ */
+template <typename GraphTy>
+void relabelByRCM(GraphTy& graph, NodeRelabeling& relabeling) {
+  relabeling.apply(graph, [](GraphTy& g, LargeArray<uint32_t>& p) {
+    rcmOrder(g, p);
+  });
+}
+
+} // namespace graphs
+} // namespace galois
+
+#endif
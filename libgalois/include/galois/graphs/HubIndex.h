@@ -0,0 +1,222 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_GRAPHS_HUBINDEX_H
+#define GALOIS_GRAPHS_HUBINDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "galois/config.h"
+#include "galois/Galois.h"
+#include "galois/Bag.h"
+#include "galois/LargeArray.h"
+#include "galois/Reduction.h"
+
+namespace galois {
+namespace graphs {
+
+/**
+ * Dense adjacency bitmaps for the highest degree nodes (hubs) of a CSR
+ * topology.
+ *
+ * Every node with degree of at least a threshold is a hub candidate. Each
+ * hub stores one bit per node of the graph, so candidates are indexed in
+ * order of decreasing degree until a memory budget is used up. Membership
+ * tests on a hub are then a single bit test, and intersections involving a
+ * hub probe the bitmap instead of merging adjacency lists.
+ *
+ * A bitmap cannot tell how often a neighbor occurs, so nodes with repeated
+ * edges to the same neighbor are never indexed. Intersections with a hub
+ * count a repeated element of the other list once, which is what the kernels
+ * of Intersection.h give for a list without repeats.
+ *
+ * The index is a snapshot of the topology it was built from; it has to be
+ * rebuilt (or cleared) when the topology changes.
+ */
+class HubIndex {
+  static constexpr uint32_t noSlot = std::numeric_limits<uint32_t>::max();
+
+  //! slot of the bitmap of each node, or noSlot if it is not a hub
+  LargeArray<uint32_t> slotOf;
+  //! bitmaps of all hubs, numWords words each
+  LargeArray<uint64_t> bitmaps;
+  uint64_t numWords = 0;
+  uint32_t numHubs  = 0;
+
+  const uint64_t* bitmap(uint32_t slot) const {
+    return bitmaps.data() + slot * numWords;
+  }
+
+public:
+  HubIndex()                = default;
+  HubIndex(HubIndex&&)      = default;
+  HubIndex& operator=(HubIndex&&) = default;
+
+  //! True if the index has been built and has at least one hub
+  bool empty() const { return numHubs == 0; }
+
+  //! Number of indexed hubs
+  uint32_t size() const { return numHubs; }
+
+  //! Bytes used by the bitmaps and the node to bitmap map
+  uint64_t memoryUsage() const {
+    return bitmaps.size() * sizeof(uint64_t) + slotOf.size() * sizeof(uint32_t);
+  }
+
+  //! True if n has a bitmap
+  bool isHub(uint32_t n) const {
+    return numHubs && slotOf[n] != noSlot;
+  }
+
+  /**
+   * Builds the index of a CSR topology.
+   *
+   * @param numNodes number of nodes
+   * @param edgeIndex edgeIndex[n] is one past the last edge of node n
+   * @param edgeDst destinations of the edges
+   * @param minDegree only nodes with at least this degree become hubs
+   * @param memoryBudget maximum number of bytes used by the index, including
+   * the per-node map; hubs are picked in order of decreasing degree until the
+   * budget is exhausted
+   */
+  void build(uint64_t numNodes, const uint64_t* edgeIndex,
+             const uint32_t* edgeDst, uint64_t minDegree,
+             uint64_t memoryBudget) {
+    clear();
+    numWords = (numNodes + 63) / 64;
+
+    uint64_t mapBytes = numNodes * sizeof(uint32_t);
+    if (memoryBudget <= mapBytes || numWords == 0)
+      return;
+    uint64_t maxHubs = (memoryBudget - mapBytes) / (numWords * sizeof(uint64_t));
+    if (maxHubs == 0)
+      return;
+
+    auto degree = [&](uint64_t n) {
+      return edgeIndex[n] - (n == 0 ? 0 : edgeIndex[n - 1]);
+    };
+
+    galois::InsertBag<uint32_t> candidates;
+    galois::do_all(
+        galois::iterate(UINT64_C(0), numNodes),
+        [&](uint64_t n) {
+          if (degree(n) >= minDegree)
+            candidates.push(n);
+        },
+        galois::no_stats(), galois::loopname("HubIndexCandidates"));
+
+    std::vector<uint32_t> hubs(candidates.begin(), candidates.end());
+    std::sort(hubs.begin(), hubs.end(), [&](uint32_t a, uint32_t b) {
+      uint64_t da = degree(a);
+      uint64_t db = degree(b);
+      return da > db || (da == db && a < b);
+    });
+    if (hubs.size() > maxHubs)
+      hubs.resize(maxHubs);
+    if (hubs.empty())
+      return;
+
+    numHubs = hubs.size();
+    slotOf.allocateBlocked(numNodes);
+    bitmaps.allocateBlocked(numHubs * numWords);
+
+    galois::do_all(
+        galois::iterate(UINT64_C(0), numNodes),
+        [&](uint64_t n) { slotOf[n] = noSlot; }, galois::no_stats(),
+        galois::loopname("HubIndexInitSlots"));
+
+    galois::GAccumulator<uint32_t> repeated;
+    galois::do_all(
+        galois::iterate(UINT32_C(0), numHubs),
+        [&](uint32_t slot) {
+          uint32_t hub   = hubs[slot];
+          uint64_t* bits = bitmaps.data() + slot * numWords;
+          std::fill(bits, bits + numWords, 0);
+          uint64_t seen = 0;
+          for (uint64_t e = (hub == 0 ? 0 : edgeIndex[hub - 1]);
+               e < edgeIndex[hub]; ++e) {
+            uint32_t dst = edgeDst[e];
+            uint64_t bit = UINT64_C(1) << (dst % 64);
+            seen |= bits[dst / 64] & bit;
+            bits[dst / 64] |= bit;
+          }
+          // the slot stays unused if the hub has a repeated neighbor
+          if (seen) {
+            repeated += 1;
+          } else {
+            slotOf[hub] = slot;
+          }
+        },
+        galois::steal(), galois::no_stats(),
+        galois::loopname("HubIndexBitmaps"));
+    numHubs -= repeated.reduce();
+  }
+
+  //! Drops all bitmaps
+  void clear() {
+    slotOf.destroy();
+    slotOf.deallocate();
+    bitmaps.destroy();
+    bitmaps.deallocate();
+    numHubs  = 0;
+    numWords = 0;
+  }
+
+  //! True if hub has an edge to dst; hub must satisfy isHub
+  bool hasEdge(uint32_t hub, uint32_t dst) const {
+    const uint64_t* bits = bitmap(slotOf[hub]);
+    return (bits[dst / 64] >> (dst % 64)) & 1;
+  }
+
+  /**
+   * Number of distinct elements of the sorted list [list, list + n) that are
+   * neighbors of hub; hub must satisfy isHub.
+   */
+  uint64_t countCommon(uint32_t hub, const uint32_t* list, uint64_t n) const {
+    const uint64_t* bits = bitmap(slotOf[hub]);
+    uint64_t count       = 0;
+    for (uint64_t i = 0; i < n; ++i) {
+      uint32_t dst = list[i];
+      count += ((bits[dst / 64] >> (dst % 64)) & 1) &
+               (i == 0 || dst != list[i - 1]);
+    }
+    return count;
+  }
+
+  //! Number of common neighbors of two hubs by intersecting their bitmaps
+  uint64_t countCommonHubs(uint32_t a, uint32_t b) const {
+    const uint64_t* ba = bitmap(slotOf[a]);
+    const uint64_t* bb = bitmap(slotOf[b]);
+    uint64_t count     = 0;
+    for (uint64_t w = 0; w < numWords; ++w)
+      count += __builtin_popcountll(ba[w] & bb[w]);
+    return count;
+  }
+
+  //! Number of words of a bitmap; the cost of countCommonHubs
+  uint64_t bitmapWords() const { return numWords; }
+};
+
+} // namespace graphs
+} // namespace galois
+
+#endif
@@ -0,0 +1,110 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file Intersection.h
+ *
+ * Kernels for intersecting sorted sets of node ids, such as the edge
+ * destinations of two nodes of an LC_CSR_Graph (see
+ * LC_CSR_Graph::edge_dst_begin).
+ *
+ * Sets of similar size are intersected with a block-wise all-pairs
+ * comparison using SSE4.2, AVX2 or AVX-512 instructions; the instruction set
+ * is chosen once at runtime from what the CPU supports. When one set is much
+ * smaller than the other, the larger set is galloped over (exponential
+ * search) instead.
+ */
+
+#ifndef GALOIS_GRAPHS_INTERSECTION_H
+#define GALOIS_GRAPHS_INTERSECTION_H
+
+#include <cstdint>
+
+#include "galois/config.h"
+
+namespace galois {
+namespace graphs {
+
+//! Instruction sets of the intersection kernels
+enum class IntersectISA { SCALAR, SSE42, AVX2, AVX512 };
+
+//! Name of an instruction set
+const char* intersectISAName(IntersectISA isa);
+
+//! True if the CPU and compiler support the instruction set
+bool isIntersectISASupported(IntersectISA isa);
+
+//! Instruction set currently used by countIntersection
+IntersectISA getIntersectISA();
+
+/**
+ * Overrides the instruction set chosen at startup (the best one supported).
+ * Dies if the instruction set is not supported. Meant for testing and
+ * benchmarking; not safe to call during parallel execution.
+ */
+void setIntersectISA(IntersectISA isa);
+
+/**
+ * Counts the elements common to two sets. Both ranges must be sorted in
+ * increasing order. Repeated elements are paired up one to one as in
+ * std::set_intersection, so an element that occurs x times in a and y times
+ * in b is counted min(x, y) times with every instruction set.
+ *
+ * @param a first set
+ * @param na number of elements of a
+ * @param b second set
+ * @param nb number of elements of b
+ * @returns size of the intersection of a and b
+ */
+uint64_t countIntersection(const uint32_t* a, uint64_t na, const uint32_t* b,
+                           uint64_t nb);
+
+/**
+ * Returns true if key is in the sorted range [a, a + n). Branch-free binary
+ * search; used for single membership tests where intersecting whole sets
+ * would be wasteful.
+ */
+inline bool containsSorted(const uint32_t* a, uint64_t n, uint32_t key) {
+  if (n == 0)
+    return false;
+  const uint32_t* base = a;
+  while (n > 1) {
+    uint64_t half = n / 2;
+    base          = (base[half] <= key) ? base + half : base;
+    n -= half;
+  }
+  return *base == key;
+}
+
+namespace internal {
+
+//! Intersection kernel of a single instruction set; exposed for testing
+uint64_t countIntersectionISA(IntersectISA isa, const uint32_t* a, uint64_t na,
+                              const uint32_t* b, uint64_t nb);
+
+//! Galloping intersection; exposed for testing
+uint64_t countIntersectionGalloping(const uint32_t* small, uint64_t ns,
+                                    const uint32_t* large, uint64_t nl);
+
+} // namespace internal
+
+} // namespace graphs
+} // namespace galois
+
+#endif
@@ -31,9 +31,14 @@
 
 #include "galois/config.h"
 #include "galois/Galois.h"
+#include "galois/ParallelSTL.h"
 #include "galois/graphs/Details.h"
 #include "galois/graphs/FileGraph.h"
 #include "galois/graphs/GraphHelpers.h"
+#include "galois/graphs/HubIndex.h"
+#include "galois/graphs/Intersection.h"
+#include "galois/graphs/ParallelFileReader.h"
+#include "galois/substrate/NumaMem.h"
 #include "galois/PODResizeableArray.h"
 
 namespace galois::graphs {
@@ -157,10 +162,15 @@ public:
   typedef iterator const_local_iterator;
 
 protected:
+  //! Backing store of the topology when mapped with mapGraphFromGRFile;
+  //! declared first so it outlives the arrays pointing into it
+  substrate::LAptr fileMapping;
   NodeData nodeData;
   EdgeIndData edgeIndData;
   EdgeDst edgeDst;
   EdgeData edgeData;
+  //! Optional adjacency bitmaps of high degree nodes; see buildHubIndex
+  HubIndex hubIndex;
 
   uint64_t numNodes;
   uint64_t numEdges;
@@ -377,10 +387,12 @@ public:
   }
 
   friend void swap(LC_CSR_Graph& lhs, LC_CSR_Graph& rhs) {
+    std::swap(lhs.fileMapping, rhs.fileMapping);
     swap(lhs.nodeData, rhs.nodeData);
     swap(lhs.edgeIndData, rhs.edgeIndData);
     swap(lhs.edgeDst, rhs.edgeDst);
     swap(lhs.edgeData, rhs.edgeData);
+    std::swap(lhs.hubIndex, rhs.hubIndex);
     std::swap(lhs.numNodes, rhs.numNodes);
     std::swap(lhs.numEdges, rhs.numEdges);
   }
@@ -441,6 +453,73 @@ public:
 
   uint64_t getDegree(GraphNode N) const { return (raw_end(N) - raw_begin(N)); }
 
+  /**
+   * Raw pointer to the destinations of the edges of N, which are stored
+   * contiguously up to edge_dst_end(N). Used by kernels that operate on whole
+   * adjacency lists, such as the set intersections in Intersection.h. Does
+   * not acquire any locks.
+   */
+  const uint32_t* edge_dst_begin(GraphNode N) const {
+    return edgeDst.data() + *raw_begin(N);
+  }
+
+  //! End of the destinations of the edges of N; see edge_dst_begin
+  const uint32_t* edge_dst_end(GraphNode N) const {
+    return edgeDst.data() + *raw_end(N);
+  }
+
+  /**
+   * Builds bitmaps of the adjacency of the highest degree nodes so that
+   * hasEdge and countCommonNeighbors on them take constant time per
+   * neighbor. Replaces any previous index; the index is dropped when the
+   * topology is reallocated, transposed or permuted.
+   *
+   * @param minDegree only nodes with at least this degree get a bitmap
+   * @param memoryBudget maximum bytes used by the index; nodes are indexed
+   * in order of decreasing degree until it is used up
+   */
+  void buildHubIndex(uint64_t minDegree, uint64_t memoryBudget) {
+    hubIndex.build(numNodes, edgeIndData.data(), edgeDst.data(), minDegree,
+                   memoryBudget);
+  }
+
+  //! Drops the hub index
+  void clearHubIndex() { hubIndex.clear(); }
+
+  const HubIndex& getHubIndex() const { return hubIndex; }
+
+  /**
+   * True if there is an edge from src to dst. Constant time if src is in the
+   * hub index, otherwise a binary search, so edges must be sorted by
+   * destination (see sortAllEdgesByDst).
+   */
+  bool hasEdge(GraphNode src, GraphNode dst) const {
+    if (hubIndex.isHub(src))
+      return hubIndex.hasEdge(src, dst);
+    return containsSorted(edge_dst_begin(src), getDegree(src), dst);
+  }
+
+  /**
+   * Number of common destinations of the edges of a and b. Uses the hub
+   * bitmaps when a or b is indexed and the intersection kernels of
+   * Intersection.h otherwise; edges must be sorted by destination.
+   */
+  uint64_t countCommonNeighbors(GraphNode a, GraphNode b) const {
+    bool hubA = hubIndex.isHub(a);
+    bool hubB = hubIndex.isHub(b);
+    if (hubA && hubB &&
+        hubIndex.bitmapWords() < getDegree(a) + getDegree(b)) {
+      return hubIndex.countCommonHubs(a, b);
+    }
+    // probe the bitmap of the larger hub with the list of the other node
+    if (hubA && (!hubB || getDegree(a) >= getDegree(b)))
+      return hubIndex.countCommon(a, edge_dst_begin(b), getDegree(b));
+    if (hubB)
+      return hubIndex.countCommon(b, edge_dst_begin(a), getDegree(a));
+    return countIntersection(edge_dst_begin(a), getDegree(a),
+                             edge_dst_begin(b), getDegree(b));
+  }
+
   edge_iterator findEdge(GraphNode N1, GraphNode N2) {
     return std::find_if(edge_begin(N1), edge_end(N1),
                         [=](edge_iterator e) { return getEdgeDst(e) == N2; });
@@ -513,6 +592,7 @@ public:
   }
 
   void allocateFrom(const FileGraph& graph) {
+    hubIndex.clear();
     numNodes = graph.size();
     numEdges = graph.sizeEdges();
     if (UseNumaAlloc) {
@@ -531,6 +611,7 @@ public:
   }
 
   void allocateFrom(uint32_t nNodes, uint64_t nEdges) {
+    hubIndex.clear();
     numNodes = nNodes;
     numEdges = nEdges;
 
@@ -598,17 +679,29 @@ public:
 
     edgeData.deallocate();
     edgeData.destroy();
+
+    hubIndex.clear();
+    fileMapping.reset();
   }
 
+  // constructEdge and fixEndEdge fill a topology set up by allocateFrom,
+  // which drops the hub index
   void constructEdge(uint64_t e, uint32_t dst,
                      const typename EdgeData::value_type& val) {
+    assert(hubIndex.empty());
     edgeData.set(e, val);
     edgeDst[e] = dst;
   }
 
-  void constructEdge(uint64_t e, uint32_t dst) { edgeDst[e] = dst; }
+  void constructEdge(uint64_t e, uint32_t dst) {
+    assert(hubIndex.empty());
+    edgeDst[e] = dst;
+  }
 
-  void fixEndEdge(uint32_t n, uint64_t e) { edgeIndData[n] = e; }
+  void fixEndEdge(uint32_t n, uint64_t e) {
+    assert(hubIndex.empty());
+    edgeIndData[n] = e;
+  }
 
   /**
    * Perform an in-memory transpose of the graph, replacing the original
@@ -617,6 +710,7 @@ public:
   void transpose(const char* regionName = NULL) {
     galois::StatTimer timer("TIMER_GRAPH_TRANSPOSE", regionName);
     timer.start();
+    hubIndex.clear();
 
     EdgeDst edgeDst_old;
     EdgeData edgeData_new;
@@ -711,6 +805,91 @@ public:
     timer.stop();
   }
 
+  /**
+   * Relabels the nodes of the graph in memory: node n becomes node perm[n].
+   * Node data, edges and edge data move with their nodes; the edges of a
+   * node keep their relative order. Node data that is not move constructible
+   * (e.g., contains atomics) is default constructed instead, so such graphs
+   * should be relabeled before their node data is initialized. The new arrays are built in parallel
+   * (parallel prefix sum of the permuted degrees and a parallel edge
+   * scatter), so the graph temporarily needs twice its memory.
+   *
+   * @param perm permutation with perm[n] the new id of node n
+   * @param regionName region to report the timer under
+   */
+  template <typename PermTy>
+  void permute(const PermTy& perm, const char* regionName = NULL) {
+    galois::StatTimer timer("TIMER_GRAPH_PERMUTE", regionName);
+    timer.start();
+
+    NodeData nodeData_new;
+    EdgeIndData edgeIndData_new;
+    EdgeDst edgeDst_new;
+    EdgeData edgeData_new;
+
+    if (UseNumaAlloc) {
+      nodeData_new.allocateBlocked(numNodes);
+      edgeIndData_new.allocateBlocked(numNodes);
+      edgeDst_new.allocateBlocked(numEdges);
+      edgeData_new.allocateBlocked(numEdges);
+    } else {
+      nodeData_new.allocateInterleaved(numNodes);
+      edgeIndData_new.allocateInterleaved(numNodes);
+      edgeDst_new.allocateInterleaved(numEdges);
+      edgeData_new.allocateInterleaved(numEdges);
+    }
+
+    // degrees of the relabeled nodes; prefix sum gives the new edge index
+    galois::do_all(
+        galois::iterate(UINT64_C(0), numNodes),
+        [&](uint64_t n) {
+          edgeIndData_new[perm[n]] =
+              edgeIndData[n] - (n == 0 ? 0 : edgeIndData[n - 1]);
+        },
+        galois::no_stats(), galois::loopname("PERMUTE_DEGREES"));
+    galois::ParallelSTL::partial_sum(edgeIndData_new.begin(),
+                                     edgeIndData_new.end(),
+                                     edgeIndData_new.begin());
+
+    galois::do_all(
+        galois::iterate(UINT64_C(0), numNodes),
+        [&](uint64_t n) {
+          uint64_t dst   = perm[n];
+          uint64_t e_new = (dst == 0) ? 0 : edgeIndData_new[dst - 1];
+          for (uint64_t e = (n == 0) ? 0 : edgeIndData[n - 1];
+               e < edgeIndData[n]; ++e, ++e_new) {
+            edgeDst_new[e_new] = perm[edgeDst[e]];
+            edgeDataCopy(edgeData_new, edgeData, e_new, e);
+          }
+          if constexpr (std::is_void<NodeTy>::value ||
+                        !std::is_move_constructible<NodeTy>::value) {
+            nodeData_new.constructAt(dst);
+          } else {
+            nodeData_new.constructAt(dst, std::move(nodeData[n].getData()));
+          }
+        },
+        galois::steal(), galois::no_stats(), galois::loopname("PERMUTE_EDGES"));
+
+    using std::swap;
+    swap(nodeData, nodeData_new);
+    swap(edgeIndData, edgeIndData_new);
+    swap(edgeDst, edgeDst_new);
+    swap(edgeData, edgeData_new);
+
+    // release the old arrays before the file they may point into
+    nodeData_new.destroy();
+    nodeData_new.deallocate();
+    edgeDst_new.deallocate();
+    edgeIndData_new.deallocate();
+    edgeData_new.destroy();
+    edgeData_new.deallocate();
+    fileMapping.reset();
+    hubIndex.clear();
+
+    initializeLocalRanges();
+    timer.stop();
+  }
+
   template <bool is_non_void = EdgeData::has_value>
   void edgeDataCopy(EdgeData& edgeData_new, EdgeData& edgeData, uint64_t e_new,
                     uint64_t e,
@@ -869,145 +1048,198 @@ public:
     initializeLocalRanges();
   }
 
+private:
   /**
-   * Reads the GR files directly into in-memory
-   * data-structures of LC_CSR graphs using freads.
-   *
-   * Edge is not void.
+   * Reads the header and topology of a GR file, allocating the graph and
+   * constructing its nodes.
    *
+   * @returns offset of the edge data array in the file
    */
-  template <
-      typename U                                                      = void,
-      typename std::enable_if<!std::is_void<EdgeTy>::value, U>::type* = nullptr>
-  void readGraphFromGRFile(const std::string& filename) {
-    std::ifstream graphFile(filename.c_str());
-    if (!graphFile.is_open()) {
-      GALOIS_DIE("failed to open file");
-    }
+  uint64_t readGRTopology(ParallelFileReader& reader) {
     uint64_t header[4];
-    graphFile.read(reinterpret_cast<char*>(header), sizeof(uint64_t) * 4);
+    reader.readSerial(header, 0, sizeof(uint64_t) * 4);
     uint64_t version = header[0];
-    numNodes         = header[2];
-    numEdges         = header[3];
+    if (version == 2) {
+      GALOIS_DIE("cannot read gr version 2 (64-bit destinations) into 32-bit "
+                 "edge destinations");
+    } else if (version != 1) {
+      GALOIS_DIE("unknown file version: ", version);
+    }
+    numNodes = header[2];
+    numEdges = header[3];
     galois::gPrint("Number of Nodes: ", numNodes,
                    ", Number of Edges: ", numEdges, "\n");
     allocateFrom(numNodes, numEdges);
     constructNodes();
-    /**
-     * Load outIndex array
-     **/
-    assert(edgeIndData.data());
-    if (!edgeIndData.data()) {
-      GALOIS_DIE("out of memory");
-    }
 
-    // start position to read index data
-    uint64_t readPosition = (4 * sizeof(uint64_t));
-    graphFile.seekg(readPosition);
-    graphFile.read(reinterpret_cast<char*>(edgeIndData.data()),
-                   sizeof(uint64_t) * numNodes);
-    /**
-     * Load edgeDst array
-     **/
-    assert(edgeDst.data());
-    if (!edgeDst.data()) {
+    if (!edgeIndData.data() || !edgeDst.data()) {
       GALOIS_DIE("out of memory");
     }
 
-    readPosition = ((4 + numNodes) * sizeof(uint64_t));
-    graphFile.seekg(readPosition);
-    if (version == 1) {
-      graphFile.read(reinterpret_cast<char*>(edgeDst.data()),
-                     sizeof(uint32_t) * numEdges);
-      readPosition =
-          ((4 + numNodes) * sizeof(uint64_t) + numEdges * sizeof(uint32_t));
-      // version 1 padding TODO make version agnostic
-      if (numEdges % 2) {
-        readPosition += sizeof(uint32_t);
-      }
-    } else if (version == 2) {
-      graphFile.read(reinterpret_cast<char*>(edgeDst.data()),
-                     sizeof(uint64_t) * numEdges);
-      readPosition =
-          ((4 + numNodes) * sizeof(uint64_t) + numEdges * sizeof(uint64_t));
-      if (numEdges % 2) {
-        readPosition += sizeof(uint64_t);
-      }
-    } else {
-      GALOIS_DIE("unknown file version: ", version);
+    // index data starts after the header
+    uint64_t readPosition = 4 * sizeof(uint64_t);
+    reader.read(edgeIndData.data(), readPosition, sizeof(uint64_t) * numNodes);
+    readPosition += sizeof(uint64_t) * numNodes;
+    reader.read(edgeDst.data(), readPosition, sizeof(uint32_t) * numEdges);
+    readPosition += sizeof(uint32_t) * numEdges;
+    // version 1 padding
+    if (numEdges % 2) {
+      readPosition += sizeof(uint32_t);
     }
+    return readPosition;
+  }
+
+public:
+  /**
+   * Reads the GR files directly into in-memory data-structures of LC_CSR
+   * graphs.
+   *
+   * The arrays are read in parallel with pread, each thread reading the part
+   * of each array that was placed on its NUMA node (see ParallelFileReader).
+   * Read throughput is reported as a statistic.
+   *
+   * Edge is not void.
+   *
+   * @param filename GR file to read
+   * @param direct if true, bypass the page cache with O_DIRECT
+   */
+  template <
+      typename U                                                      = void,
+      typename std::enable_if<!std::is_void<EdgeTy>::value, U>::type* = nullptr>
+  void readGraphFromGRFile(const std::string& filename, bool direct = false) {
+    ParallelFileReader reader(filename, direct);
+    uint64_t readPosition = readGRTopology(reader);
     /**
      * Load edge data array
      **/
-    assert(edgeData.data());
     if (!edgeData.data()) {
       GALOIS_DIE("out of memory");
     }
-    graphFile.seekg(readPosition);
-    graphFile.read(reinterpret_cast<char*>(edgeData.data()),
-                   sizeof(EdgeTy) * numEdges);
+    reader.read(edgeData.data(), readPosition, sizeof(EdgeTy) * numEdges);
 
     initializeLocalRanges();
-    graphFile.close();
+    reader.reportStats("ReadGraphFromGRFile");
   }
 
   /**
-   * Reads the GR files directly into in-memory
-   * data-structures of LC_CSR graphs using freads.
+   * Reads the GR files directly into in-memory data-structures of LC_CSR
+   * graphs.
+   *
+   * The arrays are read in parallel with pread, each thread reading the part
+   * of each array that was placed on its NUMA node (see ParallelFileReader).
+   * Read throughput is reported as a statistic.
    *
    * Edge is void.
    *
+   * @param filename GR file to read
+   * @param direct if true, bypass the page cache with O_DIRECT
    */
   template <
       typename U                                                     = void,
       typename std::enable_if<std::is_void<EdgeTy>::value, U>::type* = nullptr>
-  void readGraphFromGRFile(const std::string& filename) {
-    std::ifstream graphFile(filename.c_str());
-    if (!graphFile.is_open()) {
-      GALOIS_DIE("failed to open file");
+  void readGraphFromGRFile(const std::string& filename, bool direct = false) {
+    ParallelFileReader reader(filename, direct);
+    readGRTopology(reader);
+
+    initializeLocalRanges();
+    reader.reportStats("ReadGraphFromGRFile");
+  }
+
+  /**
+   * Maps a GR file into memory and uses the mapping directly as the edge
+   * index, edge destination and edge data arrays instead of copying them into
+   * freshly allocated memory. Only node data is allocated.
+   *
+   * Pages are faulted in in parallel, each thread touching the part of the
+   * arrays that belongs to its local range, so the page cache is spread
+   * across NUMA nodes the same way allocateBlocked would place the arrays.
+   *
+   * Only version 1 files are supported: version 2 files (64-bit
+   * destinations) do not fit the 32-bit destination array.
+   *
+   * @param filename GR file to map
+   * @param shared if true, use a read-only MAP_SHARED mapping so that several
+   * processes on a host share the same pages; the topology and edge data
+   * must then not be modified. Otherwise use a copy-on-write MAP_PRIVATE
+   * mapping.
+   */
+  void mapGraphFromGRFile(const std::string& filename, bool shared = false) {
+    galois::StatTimer timer("TIMER_GRAPH_MAP");
+    timer.start();
+
+    size_t fileSize;
+    substrate::LAptr mapping =
+        substrate::largeMapFile(filename, shared, fileSize);
+    if (fileSize < 4 * sizeof(uint64_t)) {
+      GALOIS_DIE("not a gr file: ", filename);
     }
-    uint64_t header[4];
-    graphFile.read(reinterpret_cast<char*>(header), sizeof(uint64_t) * 4);
+    uint64_t* header = static_cast<uint64_t*>(mapping.get());
     uint64_t version = header[0];
-    numNodes         = header[2];
-    numEdges         = header[3];
+    if (version != 1) {
+      GALOIS_DIE("cannot map gr version ", version, ": ", filename);
+    }
+    if (EdgeData::has_value && header[1] != EdgeData::size_of::value) {
+      GALOIS_DIE("edge data size mismatch: file has ", header[1],
+                 " bytes per edge");
+    }
+
+    deallocate();
+    numNodes = header[2];
+    numEdges = header[3];
     galois::gPrint("Number of Nodes: ", numNodes,
                    ", Number of Edges: ", numEdges, "\n");
-    allocateFrom(numNodes, numEdges);
-    constructNodes();
-    /**
-     * Load outIndex array
-     **/
-    assert(edgeIndData.data());
-    if (!edgeIndData.data()) {
-      GALOIS_DIE("out of memory");
+
+    char* base = static_cast<char*>(mapping.get());
+    uint64_t* outIdx = header + 4;
+    uint32_t* outs   = reinterpret_cast<uint32_t*>(outIdx + numNodes);
+    // version 1 pads the destinations to 8 bytes
+    char* outData = reinterpret_cast<char*>(outs + numEdges + numEdges % 2);
+    if (outData + EdgeData::size_of::value * numEdges > base + fileSize) {
+      GALOIS_DIE("truncated gr file: ", filename);
     }
-    // start position to read index data
-    uint64_t readPosition = (4 * sizeof(uint64_t));
-    graphFile.seekg(readPosition);
-    graphFile.read(reinterpret_cast<char*>(edgeIndData.data()),
-                   sizeof(uint64_t) * numNodes);
-    /**
-     * Load edgeDst array
-     **/
-    assert(edgeDst.data());
-    if (!edgeDst.data()) {
-      GALOIS_DIE("out of memory");
+
+    fileMapping = std::move(mapping);
+    edgeIndData = EdgeIndData(outIdx, numNodes);
+    edgeDst     = EdgeDst(outs, numEdges);
+    if constexpr (EdgeData::has_value) {
+      edgeData = EdgeData(outData, numEdges);
     }
-    readPosition = ((4 + numNodes) * sizeof(uint64_t));
-    graphFile.seekg(readPosition);
-    if (version == 1) {
-      graphFile.read(reinterpret_cast<char*>(edgeDst.data()),
-                     sizeof(uint32_t) * numEdges);
-    } else if (version == 2) {
-      graphFile.read(reinterpret_cast<char*>(edgeDst.data()),
-                     sizeof(uint64_t) * numEdges);
+
+    if (UseNumaAlloc) {
+      nodeData.allocateBlocked(numNodes);
+      this->outOfLineAllocateBlocked(numNodes);
     } else {
-      GALOIS_DIE("unknown file version: ", version);
+      nodeData.allocateInterleaved(numNodes);
+      this->outOfLineAllocateInterleaved(numNodes);
     }
 
-    initializeLocalRanges();
-    graphFile.close();
+    galois::on_each([&](unsigned tid, unsigned total) {
+      auto r = divideByNode(NodeData::size_of::value +
+                                EdgeIndData::size_of::value +
+                                LC_CSR_Graph::size_of_out_of_line::value,
+                            EdgeDst::size_of::value + EdgeData::size_of::value,
+                            tid, total)
+                   .first;
+      this->setLocalRange(*r.first, *r.second);
+
+      uint64_t nbegin = *r.first;
+      uint64_t nend   = *r.second;
+      uint64_t ebegin = (nbegin == 0) ? 0 : edgeIndData[nbegin - 1];
+      uint64_t eend   = (nend == 0) ? 0 : edgeIndData[nend - 1];
+      substrate::prefaultMapped(outIdx + nbegin,
+                                (nend - nbegin) * sizeof(uint64_t));
+      substrate::prefaultMapped(outs + ebegin,
+                                (eend - ebegin) * sizeof(uint32_t));
+      substrate::prefaultMapped(outData + ebegin * EdgeData::size_of::value,
+                                (eend - ebegin) * EdgeData::size_of::value);
+
+      for (uint64_t n = nbegin; n < nend; ++n) {
+        nodeData.constructAt(n);
+        this->outOfLineConstructAt(n);
+      }
+    });
+
+    timer.stop();
   }
 
   /**
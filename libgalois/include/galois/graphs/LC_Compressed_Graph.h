@@ -0,0 +1,751 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_GRAPHS_LC_COMPRESSED_GRAPH_H
+#define GALOIS_GRAPHS_LC_COMPRESSED_GRAPH_H
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <vector>
+
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+
+#include "galois/config.h"
+#include "galois/Galois.h"
+#include "galois/ParallelSTL.h"
+#include "galois/graphs/Details.h"
+#include "galois/graphs/FileGraph.h"
+#include "galois/graphs/GraphHelpers.h"
+
+namespace galois::graphs {
+
+namespace internal {
+
+//! Number of edges per independently decodable block of an adjacency list
+constexpr uint32_t compressedBlockSize = 64;
+
+//! Version tag written at the start of compressed graph files
+constexpr uint64_t compressedFileVersion = 0x43475231; // "CGR1"
+
+//! Number of bytes needed to varint encode x
+inline size_t varintSize(uint64_t x) {
+  size_t n = 1;
+  while (x >= 0x80) {
+    x >>= 7;
+    ++n;
+  }
+  return n;
+}
+
+//! LEB128 encodes x at out and advances out past the written bytes
+inline void encodeVarint(uint8_t*& out, uint64_t x) {
+  while (x >= 0x80) {
+    *out++ = static_cast<uint8_t>(x) | 0x80;
+    x >>= 7;
+  }
+  *out++ = static_cast<uint8_t>(x);
+}
+
+//! Decodes a LEB128 value at in and advances in past the read bytes
+inline uint64_t decodeVarint(const uint8_t*& in) {
+  uint64_t x = *in++;
+  // fast path: deltas of sorted neighbor lists mostly fit in one byte
+  if (x < 0x80)
+    return x;
+  x &= 0x7f;
+  unsigned shift = 7;
+  uint64_t b;
+  do {
+    b = *in++;
+    x |= (b & 0x7f) << shift;
+    shift += 7;
+  } while (b & 0x80);
+  return x;
+}
+
+inline uint64_t zigzagEncode(int64_t x) {
+  return (static_cast<uint64_t>(x) << 1) ^ static_cast<uint64_t>(x >> 63);
+}
+
+inline int64_t zigzagDecode(uint64_t x) {
+  return static_cast<int64_t>(x >> 1) ^ -static_cast<int64_t>(x & 1);
+}
+
+/**
+ * Forward iterator over one delta+varint encoded adjacency list. Dereferencing
+ * yields the global edge index (like the counting iterators of
+ * {@link LC_CSR_Graph}) so edge data can still be stored uncompressed; the
+ * destination decoded so far is carried in the iterator itself.
+ */
+class CompressedEdgeIterator
+    : public boost::iterator_facade<CompressedEdgeIterator, uint64_t,
+                                    boost::forward_traversal_tag, uint64_t> {
+  const uint8_t* cur;
+  uint64_t at;
+  uint64_t end;
+  uint32_t src;
+  uint32_t dst;
+  //! edges left in the current block after the one at dst
+  uint32_t left;
+
+  void decodeBlockHead() {
+    dst  = static_cast<uint32_t>(src + zigzagDecode(decodeVarint(cur)));
+    left = compressedBlockSize - 1;
+  }
+
+public:
+  CompressedEdgeIterator()
+      : cur(nullptr), at(0), end(0), src(0), dst(0), left(0) {}
+
+  //! Past-the-end iterator
+  explicit CompressedEdgeIterator(uint64_t x)
+      : cur(nullptr), at(x), end(x), src(0), dst(0), left(0) {}
+
+  //! Iterator positioned at the head of the block starting at p
+  CompressedEdgeIterator(const uint8_t* p, uint64_t x, uint64_t e, uint32_t s)
+      : cur(p), at(x), end(e), src(s), dst(0), left(0) {
+    if (at != end)
+      decodeBlockHead();
+  }
+
+  uint32_t getDst() const { return dst; }
+
+private:
+  friend class boost::iterator_core_access;
+
+  bool equal(const CompressedEdgeIterator& other) const {
+    return at == other.at;
+  }
+  uint64_t dereference() const { return at; }
+
+  void increment() {
+    if (++at == end)
+      return;
+    if (left == 0) {
+      decodeBlockHead();
+    } else {
+      dst += static_cast<uint32_t>(decodeVarint(cur));
+      --left;
+    }
+  }
+};
+
+} // namespace internal
+
+/**
+ * Read-only local computation graph whose adjacency lists are sorted and
+ * stored as delta+varint encoded blocks. Each block of
+ * internal::compressedBlockSize edges can be decoded independently; nodes with
+ * more than one block are prefixed with a table of block offsets so
+ * {@link findEdge} can skip to the right block.
+ *
+ * Exposes the same iteration API as {@link LC_CSR_Graph} (edge_begin,
+ * edge_end, edges, getEdgeDst, getEdgeData) so applications can switch to it
+ * by changing the graph typedef. Edge data is kept uncompressed and is
+ * reordered to follow the sorted destinations.
+ *
+ * Graphs can be read from a .gr file through {@link readGraph}, in which case
+ * they are compressed while loading, or from a file written by
+ * {@link writeToCompressedFile} (see graph-convert -gr2compressedgr).
+ *
+ * @tparam NodeTy data on nodes
+ * @tparam EdgeTy data on out edges
+ */
+template <typename NodeTy, typename EdgeTy, bool HasNoLockable = false,
+          bool UseNumaAlloc = false, bool HasOutOfLineLockable = false,
+          typename FileEdgeTy = EdgeTy>
+class LC_Compressed_Graph
+    : private boost::noncopyable,
+      private internal::LocalIteratorFeature<UseNumaAlloc>,
+      private internal::OutOfLineLockableFeature<HasOutOfLineLockable &&
+                                                 !HasNoLockable> {
+public:
+  template <bool _has_id>
+  struct with_id {
+    typedef LC_Compressed_Graph type;
+  };
+
+  template <typename _node_data>
+  struct with_node_data {
+    typedef LC_Compressed_Graph<_node_data, EdgeTy, HasNoLockable,
+                                UseNumaAlloc, HasOutOfLineLockable, FileEdgeTy>
+        type;
+  };
+
+  template <typename _edge_data>
+  struct with_edge_data {
+    typedef LC_Compressed_Graph<NodeTy, _edge_data, HasNoLockable,
+                                UseNumaAlloc, HasOutOfLineLockable, FileEdgeTy>
+        type;
+  };
+
+  template <typename _file_edge_data>
+  struct with_file_edge_data {
+    typedef LC_Compressed_Graph<NodeTy, EdgeTy, HasNoLockable, UseNumaAlloc,
+                                HasOutOfLineLockable, _file_edge_data>
+        type;
+  };
+
+  //! If true, do not use abstract locks in graph
+  template <bool _has_no_lockable>
+  struct with_no_lockable {
+    typedef LC_Compressed_Graph<NodeTy, EdgeTy, _has_no_lockable,
+                                UseNumaAlloc, HasOutOfLineLockable, FileEdgeTy>
+        type;
+  };
+
+  //! If true, use NUMA-aware graph allocation; otherwise, use NUMA interleaved
+  //! allocation.
+  template <bool _use_numa_alloc>
+  struct with_numa_alloc {
+    typedef LC_Compressed_Graph<NodeTy, EdgeTy, HasNoLockable,
+                                _use_numa_alloc, HasOutOfLineLockable,
+                                FileEdgeTy>
+        type;
+  };
+
+  //! If true, store abstract locks separate from nodes
+  template <bool _has_out_of_line_lockable>
+  struct with_out_of_line_lockable {
+    typedef LC_Compressed_Graph<NodeTy, EdgeTy, HasNoLockable, UseNumaAlloc,
+                                _has_out_of_line_lockable, FileEdgeTy>
+        type;
+  };
+
+  typedef read_compressed_graph_tag read_tag;
+
+protected:
+  typedef LargeArray<EdgeTy> EdgeData;
+  typedef LargeArray<uint8_t> EdgeBytes;
+  typedef internal::NodeInfoBaseTypes<NodeTy,
+                                      !HasNoLockable && !HasOutOfLineLockable>
+      NodeInfoTypes;
+  typedef internal::NodeInfoBase<NodeTy,
+                                 !HasNoLockable && !HasOutOfLineLockable>
+      NodeInfo;
+  typedef LargeArray<uint64_t> EdgeIndData;
+  typedef LargeArray<NodeInfo> NodeData;
+
+public:
+  typedef uint32_t GraphNode;
+  typedef EdgeTy edge_data_type;
+  typedef FileEdgeTy file_edge_data_type;
+  typedef NodeTy node_data_type;
+  typedef typename EdgeData::reference edge_data_reference;
+  typedef typename NodeInfoTypes::reference node_data_reference;
+  typedef internal::CompressedEdgeIterator edge_iterator;
+  typedef boost::counting_iterator<GraphNode> iterator;
+  typedef iterator const_iterator;
+  typedef iterator local_iterator;
+  typedef iterator const_local_iterator;
+  typedef int ReadGraphAuxData;
+
+protected:
+  NodeData nodeData;
+  //! prefix sum of degrees, as in LC_CSR_Graph
+  EdgeIndData edgeIndData;
+  //! prefix sum of encoded adjacency list sizes in bytes
+  EdgeIndData byteIndData;
+  EdgeBytes edgeBytes;
+  EdgeData edgeData;
+
+  uint64_t numNodes;
+  uint64_t numEdges;
+
+  static uint64_t numBlocks(uint64_t degree) {
+    return (degree + internal::compressedBlockSize - 1) /
+           internal::compressedBlockSize;
+  }
+
+  //! Bytes taken by the block offset table in front of a node's blocks
+  static uint64_t skipTableSize(uint64_t degree) {
+    uint64_t blocks = numBlocks(degree);
+    return blocks > 1 ? (blocks - 1) * sizeof(uint32_t) : 0;
+  }
+
+  /**
+   * Returns the number of bytes needed to encode the sorted neighbor list
+   * [dsts, dsts + degree) of src.
+   */
+  static uint64_t encodedSize(GraphNode src, const uint32_t* dsts,
+                              uint64_t degree) {
+    uint64_t bytes = skipTableSize(degree);
+    for (uint64_t i = 0; i < degree; ++i) {
+      if (i % internal::compressedBlockSize == 0) {
+        bytes += internal::varintSize(internal::zigzagEncode(
+            static_cast<int64_t>(dsts[i]) - static_cast<int64_t>(src)));
+      } else {
+        bytes += internal::varintSize(dsts[i] - dsts[i - 1]);
+      }
+    }
+    return bytes;
+  }
+
+  //! Encodes the sorted neighbor list [dsts, dsts + degree) of src at out
+  static void encode(GraphNode src, const uint32_t* dsts, uint64_t degree,
+                     uint8_t* out) {
+    uint8_t* table = out;
+    uint8_t* data  = out + skipTableSize(degree);
+    uint8_t* p     = data;
+    for (uint64_t i = 0; i < degree; ++i) {
+      if (i % internal::compressedBlockSize == 0) {
+        if (i != 0) {
+          uint32_t offset = p - data;
+          std::memcpy(table, &offset, sizeof(offset));
+          table += sizeof(offset);
+        }
+        internal::encodeVarint(p, internal::zigzagEncode(
+                                      static_cast<int64_t>(dsts[i]) -
+                                      static_cast<int64_t>(src)));
+      } else {
+        internal::encodeVarint(p, dsts[i] - dsts[i - 1]);
+      }
+    }
+  }
+
+  uint64_t edgeIndexBegin(GraphNode N) const {
+    return (N == 0) ? 0 : edgeIndData[N - 1];
+  }
+
+  uint64_t edgeIndexEnd(GraphNode N) const { return edgeIndData[N]; }
+
+  //! Start of the encoded bytes of block blk of node N
+  const uint8_t* blockBegin(GraphNode N, uint64_t blk) const {
+    const uint8_t* base =
+        edgeBytes.data() + ((N == 0) ? 0 : byteIndData[N - 1]);
+    uint64_t degree     = edgeIndexEnd(N) - edgeIndexBegin(N);
+    const uint8_t* data = base + skipTableSize(degree);
+    if (blk == 0)
+      return data;
+    uint32_t offset;
+    std::memcpy(&offset, base + (blk - 1) * sizeof(uint32_t), sizeof(offset));
+    return data + offset;
+  }
+
+  edge_iterator raw_begin(GraphNode N) const {
+    return edge_iterator(blockBegin(N, 0), edgeIndexBegin(N), edgeIndexEnd(N),
+                         N);
+  }
+
+  edge_iterator raw_end(GraphNode N) const {
+    return edge_iterator(edgeIndexEnd(N));
+  }
+
+  template <bool _A1 = HasNoLockable, bool _A2 = HasOutOfLineLockable>
+  void acquireNode(GraphNode N, MethodFlag mflag,
+                   typename std::enable_if<!_A1 && !_A2>::type* = 0) {
+    galois::runtime::acquire(&nodeData[N], mflag);
+  }
+
+  template <bool _A1 = HasOutOfLineLockable, bool _A2 = HasNoLockable>
+  void acquireNode(GraphNode N, MethodFlag mflag,
+                   typename std::enable_if<_A1 && !_A2>::type* = 0) {
+    this->outOfLineAcquire(getId(N), mflag);
+  }
+
+  template <bool _A1 = HasOutOfLineLockable, bool _A2 = HasNoLockable>
+  void acquireNode(GraphNode, MethodFlag,
+                   typename std::enable_if<_A2>::type* = 0) {}
+
+  template <bool _A1 = EdgeData::has_value,
+            bool _A2 = LargeArray<FileEdgeTy>::has_value>
+  void constructEdgeValue(FileGraph& graph, uint64_t e,
+                          typename FileGraph::edge_iterator nn,
+                          typename std::enable_if<!_A1 || _A2>::type* = 0) {
+    typedef LargeArray<FileEdgeTy> FED;
+    if (EdgeData::has_value)
+      edgeData.set(e, graph.getEdgeData<typename FED::value_type>(nn));
+  }
+
+  template <bool _A1 = EdgeData::has_value,
+            bool _A2 = LargeArray<FileEdgeTy>::has_value>
+  void constructEdgeValue(FileGraph&, uint64_t e, typename FileGraph::edge_iterator,
+                          typename std::enable_if<_A1 && !_A2>::type* = 0) {
+    edgeData.set(e, {});
+  }
+
+  size_t getId(GraphNode N) { return N; }
+
+  GraphNode getNode(size_t n) { return n; }
+
+  void allocateArrays() {
+    if (UseNumaAlloc) {
+      nodeData.allocateBlocked(numNodes);
+      edgeIndData.allocateBlocked(numNodes);
+      byteIndData.allocateBlocked(numNodes);
+      edgeData.allocateBlocked(numEdges);
+      this->outOfLineAllocateBlocked(numNodes);
+    } else {
+      nodeData.allocateInterleaved(numNodes);
+      edgeIndData.allocateInterleaved(numNodes);
+      byteIndData.allocateInterleaved(numNodes);
+      edgeData.allocateInterleaved(numEdges);
+      this->outOfLineAllocateInterleaved(numNodes);
+    }
+  }
+
+  void allocateBytes() {
+    uint64_t numBytes = numNodes ? byteIndData[numNodes - 1] : 0;
+    if (UseNumaAlloc) {
+      edgeBytes.allocateBlocked(numBytes);
+    } else {
+      edgeBytes.allocateInterleaved(numBytes);
+    }
+  }
+
+  auto divideFileGraph(FileGraph& graph, unsigned tid, unsigned total) {
+    // balance by uncompressed edges: encoding cost is per file edge
+    return graph
+        .divideByNode(NodeData::size_of::value +
+                          2 * EdgeIndData::size_of::value +
+                          LC_Compressed_Graph::size_of_out_of_line::value,
+                      sizeof(uint32_t) + EdgeData::size_of::value, tid, total)
+        .first;
+  }
+
+public:
+  LC_Compressed_Graph(LC_Compressed_Graph&& rhs) = default;
+
+  LC_Compressed_Graph() : numNodes(0), numEdges(0) {}
+
+  LC_Compressed_Graph& operator=(LC_Compressed_Graph&&) = default;
+
+  node_data_reference getData(GraphNode N,
+                              MethodFlag mflag = MethodFlag::WRITE) {
+    NodeInfo& NI = nodeData[N];
+    acquireNode(N, mflag);
+    return NI.getData();
+  }
+
+  edge_data_reference
+  getEdgeData(const edge_iterator& ni,
+              MethodFlag GALOIS_UNUSED(mflag) = MethodFlag::UNPROTECTED) {
+    return edgeData[*ni];
+  }
+
+  GraphNode getEdgeDst(const edge_iterator& ni) const { return ni.getDst(); }
+
+  size_t size() const { return numNodes; }
+  size_t sizeEdges() const { return numEdges; }
+
+  //! Bytes used by the encoded adjacency lists and their byte offsets
+  size_t sizeTopologyBytes() const {
+    return edgeBytes.size() + byteIndData.size() * sizeof(uint64_t);
+  }
+
+  iterator begin() const { return iterator(0); }
+  iterator end() const { return iterator(numNodes); }
+
+  const_local_iterator local_begin() const {
+    return const_local_iterator(this->localBegin(numNodes));
+  }
+
+  const_local_iterator local_end() const {
+    return const_local_iterator(this->localEnd(numNodes));
+  }
+
+  local_iterator local_begin() {
+    return local_iterator(this->localBegin(numNodes));
+  }
+
+  local_iterator local_end() {
+    return local_iterator(this->localEnd(numNodes));
+  }
+
+  edge_iterator edge_begin(GraphNode N, MethodFlag mflag = MethodFlag::WRITE) {
+    acquireNode(N, mflag);
+    if (!HasNoLockable && galois::runtime::shouldLock(mflag)) {
+      for (edge_iterator ii = raw_begin(N), ee = raw_end(N); ii != ee; ++ii) {
+        acquireNode(ii.getDst(), mflag);
+      }
+    }
+    return raw_begin(N);
+  }
+
+  edge_iterator edge_end(GraphNode N, MethodFlag mflag = MethodFlag::WRITE) {
+    acquireNode(N, mflag);
+    return raw_end(N);
+  }
+
+  uint64_t getDegree(GraphNode N) const {
+    return edgeIndexEnd(N) - edgeIndexBegin(N);
+  }
+
+  /**
+   * Finds the edge N1->N2 by binary searching the heads of the blocks of N1
+   * and then decoding a single block.
+   *
+   * @returns iterator to the edge or edge_end(N1) if there is none
+   */
+  edge_iterator findEdge(GraphNode N1, GraphNode N2,
+                         MethodFlag mflag = MethodFlag::WRITE) {
+    acquireNode(N1, mflag);
+    uint64_t first = edgeIndexBegin(N1);
+    uint64_t last  = edgeIndexEnd(N1);
+    if (first == last)
+      return raw_end(N1);
+
+    // find the last block whose head is <= N2
+    uint64_t lo = 0;
+    uint64_t hi = numBlocks(last - first);
+    while (hi - lo > 1) {
+      uint64_t mid = lo + (hi - lo) / 2;
+      edge_iterator head(blockBegin(N1, mid),
+                         first + mid * internal::compressedBlockSize, last, N1);
+      if (head.getDst() <= N2)
+        lo = mid;
+      else
+        hi = mid;
+    }
+
+    uint64_t at = first + lo * internal::compressedBlockSize;
+    uint64_t blockLast =
+        std::min<uint64_t>(at + internal::compressedBlockSize, last);
+    edge_iterator ii(blockBegin(N1, lo), at, last, N1);
+    for (; at != blockLast; ++at, ++ii) {
+      if (ii.getDst() == N2)
+        return ii;
+      if (ii.getDst() > N2)
+        break;
+    }
+    return raw_end(N1);
+  }
+
+  //! Neighbors are always sorted in this graph; same as {@link findEdge}
+  edge_iterator findEdgeSortedByDst(GraphNode N1, GraphNode N2) {
+    return findEdge(N1, N2);
+  }
+
+  runtime::iterable<NoDerefIterator<edge_iterator>>
+  edges(GraphNode N, MethodFlag mflag = MethodFlag::WRITE) {
+    return internal::make_no_deref_range(edge_begin(N, mflag),
+                                         edge_end(N, mflag));
+  }
+
+  runtime::iterable<NoDerefIterator<edge_iterator>>
+  out_edges(GraphNode N, MethodFlag mflag = MethodFlag::WRITE) {
+    return edges(N, mflag);
+  }
+
+  /**
+   * Computes the size of every encoded adjacency list of graph and allocates
+   * memory. Node and edge contents are filled in by constructNodesFrom and
+   * constructEdgesFrom.
+   */
+  void allocateFrom(FileGraph& graph, ReadGraphAuxData&) {
+    numNodes = graph.size();
+    numEdges = graph.sizeEdges();
+    allocateArrays();
+
+    galois::substrate::PerThreadStorage<std::vector<uint32_t>> buffers;
+    galois::do_all(
+        galois::iterate(UINT64_C(0), numNodes),
+        [&](uint64_t n) {
+          std::vector<uint32_t>& dsts = *buffers.getLocal();
+          dsts.clear();
+          for (auto nn : graph.edges(n)) {
+            dsts.push_back(graph.getEdgeDst(nn));
+          }
+          std::sort(dsts.begin(), dsts.end());
+          edgeIndData[n] = *graph.edge_end(n);
+          byteIndData[n] = encodedSize(n, dsts.data(), dsts.size());
+        },
+        galois::no_stats(), galois::steal(),
+        galois::loopname("COMPRESSED_GRAPH_SIZES"));
+
+    galois::ParallelSTL::partial_sum(byteIndData.begin(), byteIndData.end(),
+                                     byteIndData.begin());
+    allocateBytes();
+  }
+
+  void constructNodesFrom(FileGraph& graph, unsigned tid, unsigned total,
+                          ReadGraphAuxData&) {
+    auto r = divideFileGraph(graph, tid, total);
+
+    this->setLocalRange(*r.first, *r.second);
+
+    for (FileGraph::iterator ii = r.first, ei = r.second; ii != ei; ++ii) {
+      nodeData.constructAt(*ii);
+      this->outOfLineConstructAt(*ii);
+    }
+  }
+
+  void constructEdgesFrom(FileGraph& graph, unsigned tid, unsigned total,
+                          const ReadGraphAuxData&) {
+    auto r = divideFileGraph(graph, tid, total);
+
+    std::vector<std::pair<uint32_t, uint64_t>> sorted;
+    std::vector<uint32_t> dsts;
+    for (FileGraph::iterator ii = r.first, ei = r.second; ii != ei; ++ii) {
+      GraphNode src = *ii;
+      sorted.clear();
+      for (FileGraph::edge_iterator nn = graph.edge_begin(src),
+                                    en = graph.edge_end(src);
+           nn != en; ++nn) {
+        sorted.emplace_back(graph.getEdgeDst(nn), *nn);
+      }
+      std::stable_sort(sorted.begin(), sorted.end(),
+                       [](const auto& a, const auto& b) {
+                         return a.first < b.first;
+                       });
+
+      uint64_t e = edgeIndexBegin(src);
+      dsts.clear();
+      for (auto& p : sorted) {
+        dsts.push_back(p.first);
+        constructEdgeValue(graph, e++, FileGraph::edge_iterator(p.second));
+      }
+      encode(src, dsts.data(), dsts.size(),
+             edgeBytes.data() + ((src == 0) ? 0 : byteIndData[src - 1]));
+    }
+  }
+
+  void constructNodes() {
+    for (uint64_t x = 0; x < numNodes; ++x) {
+      nodeData.constructAt(x);
+      this->outOfLineConstructAt(x);
+    }
+  }
+
+  /**
+   * Returns true if filename starts with the compressed graph file header.
+   */
+  static bool isCompressedFile(const std::string& filename) {
+    std::ifstream graphFile(filename.c_str());
+    uint64_t version = 0;
+    graphFile.read(reinterpret_cast<char*>(&version), sizeof(uint64_t));
+    return graphFile && version == internal::compressedFileVersion;
+  }
+
+  /**
+   * Writes the compressed graph to a file. The layout is a header of six
+   * uint64_t (version, sizeof edge data, nodes, edges, encoded bytes, block
+   * size) followed by the degree prefix sum, the byte prefix sum, the encoded
+   * adjacency lists padded to 8 bytes and finally the edge data.
+   */
+  void writeToCompressedFile(const std::string& filename) const {
+    std::ofstream graphFile(filename.c_str(), std::ios::binary);
+    if (!graphFile.is_open()) {
+      GALOIS_DIE("failed to open file: ", filename);
+    }
+    uint64_t header[6] = {internal::compressedFileVersion,
+                          EdgeData::size_of::value,
+                          numNodes,
+                          numEdges,
+                          edgeBytes.size(),
+                          internal::compressedBlockSize};
+    graphFile.write(reinterpret_cast<const char*>(header), sizeof(header));
+    graphFile.write(reinterpret_cast<const char*>(edgeIndData.data()),
+                    sizeof(uint64_t) * numNodes);
+    graphFile.write(reinterpret_cast<const char*>(byteIndData.data()),
+                    sizeof(uint64_t) * numNodes);
+    graphFile.write(reinterpret_cast<const char*>(edgeBytes.data()),
+                    edgeBytes.size());
+    uint64_t padding = 0;
+    graphFile.write(reinterpret_cast<const char*>(&padding),
+                    (8 - edgeBytes.size() % 8) % 8);
+    if (EdgeData::has_value) {
+      graphFile.write(reinterpret_cast<const char*>(edgeData.data()),
+                      EdgeData::size_of::value * numEdges);
+    }
+    if (!graphFile) {
+      GALOIS_DIE("failed to write file: ", filename);
+    }
+  }
+
+  /**
+   * Reads a file written by {@link writeToCompressedFile} directly into the
+   * in-memory arrays of this graph.
+   */
+  void readGraphFromCompressedFile(const std::string& filename) {
+    std::ifstream graphFile(filename.c_str(), std::ios::binary);
+    if (!graphFile.is_open()) {
+      GALOIS_DIE("failed to open file: ", filename);
+    }
+    uint64_t header[6];
+    graphFile.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (header[0] != internal::compressedFileVersion) {
+      GALOIS_DIE("not a compressed graph file: ", filename);
+    }
+    if (header[5] != internal::compressedBlockSize) {
+      GALOIS_DIE("unsupported block size: ", header[5]);
+    }
+    if (EdgeData::has_value && header[1] != EdgeData::size_of::value) {
+      GALOIS_DIE("edge data size mismatch: file has ", header[1],
+                 " bytes per edge");
+    }
+    numNodes = header[2];
+    numEdges = header[3];
+    galois::gPrint("Number of Nodes: ", numNodes,
+                   ", Number of Edges: ", numEdges, "\n");
+
+    allocateArrays();
+    constructNodes();
+    graphFile.read(reinterpret_cast<char*>(edgeIndData.data()),
+                   sizeof(uint64_t) * numNodes);
+    graphFile.read(reinterpret_cast<char*>(byteIndData.data()),
+                   sizeof(uint64_t) * numNodes);
+    allocateBytes();
+    if (edgeBytes.size() != header[4]) {
+      GALOIS_DIE("corrupt compressed graph file: ", filename);
+    }
+    graphFile.read(reinterpret_cast<char*>(edgeBytes.data()), header[4]);
+    if (EdgeData::has_value) {
+      uint64_t pos = (6 + 2 * numNodes) * sizeof(uint64_t) +
+                     (header[4] + 7) / 8 * 8;
+      graphFile.seekg(pos);
+      graphFile.read(reinterpret_cast<char*>(edgeData.data()),
+                     EdgeData::size_of::value * numEdges);
+    }
+    if (!graphFile) {
+      GALOIS_DIE("failed to read file: ", filename);
+    }
+
+    initializeLocalRanges();
+  }
+
+  /**
+   * Returns the reference to the edgeIndData LargeArray
+   * (a prefix sum of edges)
+   */
+  const EdgeIndData& getEdgePrefixSum() const { return edgeIndData; }
+
+  auto divideByNode(size_t nodeSize, size_t edgeSize, size_t id, size_t total) {
+    return galois::graphs::divideNodesBinarySearch(
+        numNodes, numEdges, nodeSize, edgeSize, id, total, edgeIndData);
+  }
+
+  /**
+   * Initialize the local ranges on this graph so that threads can iterate
+   * over a balanced number of vertices.
+   */
+  void initializeLocalRanges() {
+    galois::on_each([&](unsigned tid, unsigned total) {
+      auto r = divideByNode(0, 1, tid, total).first;
+      this->setLocalRange(*r.first, *r.second);
+    });
+  }
+};
+
+} // namespace galois::graphs
+
+#endif
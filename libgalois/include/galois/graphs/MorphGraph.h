@@ -234,6 +234,10 @@ struct EdgeFactory<void, false> {
  * }
  * \endcode
  *
+ * Methods that change the graph acquire the nodes they touch and then write
+ * without checking UserContext::isConflicted(), so loops with the
+ * galois::flag_conflicts trait must hold those nodes before calling them.
+ *
  * @tparam NodeTy Type of node data
  * @tparam EdgeTy Type of edge data
  * @tparam Directional true if graph is directed
@@ -0,0 +1,113 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_GRAPHS_PARALLELFILEREADER_H
+#define GALOIS_GRAPHS_PARALLELFILEREADER_H
+
+#include <cstdint>
+#include <string>
+
+#include "galois/config.h"
+
+namespace galois {
+namespace graphs {
+
+/**
+ * Reads byte ranges of a file into memory with all active threads.
+ *
+ * Each range is split into one contiguous block per thread using the same
+ * blocked distribution as LargeArray::allocateBlocked, and every thread reads
+ * its block with pread. The bytes a thread copies therefore land in pages
+ * that were first touched by (and so are local to) that thread, and memory
+ * that has not been touched yet is first touched by its reader.
+ *
+ * Optionally the file is opened with O_DIRECT to bypass the page cache. File
+ * offsets and lengths of graph arrays are not aligned to the device block
+ * size, so direct reads go through an aligned per-thread bounce buffer. If
+ * the file system does not support O_DIRECT, the reader falls back to
+ * buffered reads.
+ *
+ * The number of bytes read and the time spent in read are accumulated and
+ * can be reported as statistics with reportStats.
+ */
+class ParallelFileReader {
+  int fd;
+  int directFd;
+  uint64_t fileSize;
+  uint64_t bytesRead;
+  uint64_t readNanos;
+
+  void readBlock(void* dst, uint64_t offset, uint64_t length);
+  void readBlockDirect(void* dst, uint64_t offset, uint64_t length);
+
+public:
+  /**
+   * Opens a file for reading.
+   *
+   * @param filename file to read
+   * @param direct if true, read with O_DIRECT bypassing the page cache
+   */
+  explicit ParallelFileReader(const std::string& filename,
+                              bool direct = false);
+  ~ParallelFileReader();
+
+  ParallelFileReader(const ParallelFileReader&) = delete;
+  ParallelFileReader& operator=(const ParallelFileReader&) = delete;
+
+  //! Size of the opened file in bytes
+  uint64_t size() const { return fileSize; }
+
+  //! True if reads bypass the page cache
+  bool isDirect() const { return directFd >= 0; }
+
+  /**
+   * Reads length bytes from offset into dst in parallel; dies if the file is
+   * shorter than offset + length. Cannot be called during parallel
+   * execution.
+   *
+   * @param dst destination of the bytes; if it was allocated with
+   * allocateBlocked, reads are local to the thread owning each page
+   * @param offset offset into the file to start reading at
+   * @param length number of bytes to read
+   */
+  void read(void* dst, uint64_t offset, uint64_t length);
+
+  /**
+   * Reads length bytes from offset into dst with the calling thread only.
+   * Used for small reads such as file headers.
+   */
+  void readSerial(void* dst, uint64_t offset, uint64_t length);
+
+  //! Number of bytes read so far
+  uint64_t getBytesRead() const { return bytesRead; }
+
+  //! Read throughput so far in GB/s
+  double getThroughput() const;
+
+  /**
+   * Reports bytes read, read time (in milliseconds) and throughput (in GB/s)
+   * as statistics of the given region.
+   */
+  void reportStats(const std::string& region) const;
+};
+
+} // namespace graphs
+} // namespace galois
+
+#endif
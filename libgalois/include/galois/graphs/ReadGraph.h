@@ -192,6 +192,25 @@ void readGraphDispatch(GraphTy& graph, read_with_aux_first_graph_tag tag,
   readGraphDispatch(graph, tag, f);
 }
 
+template <typename GraphTy>
+void readGraphDispatch(GraphTy& graph, read_compressed_graph_tag,
+                       FileGraph& f) {
+  readGraphDispatch(graph, read_with_aux_graph_tag(), f);
+}
+
+//! Reads either a compressed graph file directly or compresses a .gr file
+template <typename GraphTy>
+void readGraphDispatch(GraphTy& graph, read_compressed_graph_tag tag,
+                       const std::string& filename) {
+  if (GraphTy::isCompressedFile(filename)) {
+    graph.readGraphFromCompressedFile(filename);
+    return;
+  }
+  FileGraph f;
+  f.fromFileInterleaved<typename GraphTy::file_edge_data_type>(filename);
+  readGraphDispatch(graph, tag, f);
+}
+
 template <typename GraphTy>
 void readGraphDispatch(GraphTy& graph, read_lc_inout_graph_tag,
                        const std::string& f1, const std::string& f2) {
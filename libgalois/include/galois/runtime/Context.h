@@ -136,6 +136,9 @@ class SimpleRuntimeContext : public LockManagerBase {
   //! The locks we hold
   Lockable* locks;
   bool customAcquire;
+  //! Report conflicts through conflicted instead of signalConflict
+  bool flagConflicts;
+  bool conflicted;
 
 protected:
   friend void doAcquire(Lockable*, galois::MethodFlag);
@@ -161,6 +164,8 @@ protected:
       if (i == AcquireStatus::NEW_OWNER) {
         addToNhood(lockable);
       }
+    } else if (flagConflicts) {
+      conflicted = true;
     } else {
       signalConflict(lockable);
     }
@@ -169,10 +174,27 @@ protected:
   void release(Lockable* lockable);
 
 public:
-  SimpleRuntimeContext(bool child = false) : locks(0), customAcquire(child) {}
+  SimpleRuntimeContext(bool child = false)
+      : locks(0), customAcquire(child), flagConflicts(false),
+        conflicted(false) {}
   virtual ~SimpleRuntimeContext() {}
 
-  void startIteration() { assert(!locks); }
+  void startIteration() {
+    assert(!locks);
+    conflicted = false;
+  }
+
+  //! Makes failed acquires set a flag that the iteration has to check
+  //! instead of aborting it with signalConflict
+  void setFlagConflicts(bool b) { flagConflicts = b; }
+
+  bool isFlaggingConflicts() const { return flagConflicts; }
+
+  //! True if an acquire failed since the iteration started; only set when
+  //! flagging conflicts
+  bool isConflicted() const { return conflicted; }
+
+  void markConflicted() { conflicted = true; }
 
   unsigned cancelIteration();
   unsigned commitIteration();
@@ -20,13 +20,20 @@
 #ifndef GALOIS_RUNTIME_EXECUTOR_DOALL_H
 #define GALOIS_RUNTIME_EXECUTOR_DOALL_H
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+
 #include "galois/config.h"
 #include "galois/gIO.h"
 #include "galois/runtime/Executor_OnEach.h"
 #include "galois/runtime/OperatorReferenceTypes.h"
+#include "galois/runtime/PagePool.h"
+#include "galois/runtime/Range.h"
 #include "galois/runtime/Statistics.h"
 #include "galois/substrate/Barrier.h"
 #include "galois/substrate/CompilerSpecific.h"
+#include "galois/substrate/EventTrace.h"
 #include "galois/substrate/PaddedLock.h"
 #include "galois/substrate/PerThreadStorage.h"
 #include "galois/substrate/Termination.h"
@@ -50,6 +57,17 @@ class DoAllStealingExec {
   constexpr static const bool MORE_STATS =
       NEED_STATS && has_trait<more_stats_tag, ArgsTuple>();
   constexpr static const bool USE_TERM = false;
+  constexpr static const bool ADAPTIVE =
+      has_trait<adaptive_chunk_size_tag, ArgsTuple>();
+  //! Report chunking statistics by default only in the adaptive mode
+  constexpr static const bool CHUNK_STATS =
+      ADAPTIVE ? NEED_STATS : MORE_STATS;
+
+  //! Adaptive mode aims for chunks taking between these many nanoseconds:
+  //! long enough to amortize the work lock, short enough that work stays
+  //! visible to thieves
+  constexpr static const uint64_t CHUNK_MIN_NS = 10000;
+  constexpr static const uint64_t CHUNK_MAX_NS = 50000;
 
   struct ThreadContext {
 
@@ -59,31 +77,60 @@ class DoAllStealingExec {
     Iter shared_beg;
     Iter shared_end;
     Diff_ty m_size;
-    size_t num_iter;
+    //! Current chunk size in adaptive mode; only the owner changes it
+    Diff_ty adaptive_size;
+    //! Set by thieves, cleared by the owner, both holding work_mutex
+    bool stolen_from;
 
     // Stats
+    size_t num_iter;
+    size_t num_chunks;
+    size_t num_steals;
+    Diff_ty max_chunk;
 
     ThreadContext()
         : work_mutex(), id(substrate::getThreadPool().getMaxThreads()),
-          shared_beg(), shared_end(), m_size(0), num_iter(0) {
+          shared_beg(), shared_end(), m_size(0), adaptive_size(0),
+          stolen_from(false), num_iter(0), num_chunks(0), num_steals(0),
+          max_chunk(0) {
       // TODO: fix this initialization problem,
       // see initThread
     }
 
-    ThreadContext(unsigned id, Iter beg, Iter end)
+    ThreadContext(unsigned id, Iter beg, Iter end, Diff_ty chunk_size)
         : work_mutex(), id(id), shared_beg(beg), shared_end(end),
-          m_size(std::distance(beg, end)), num_iter(0) {}
+          m_size(std::distance(beg, end)), adaptive_size(chunk_size),
+          stolen_from(false), num_iter(0), num_chunks(0), num_steals(0),
+          max_chunk(0) {}
 
     bool doWork(F func, const unsigned chunk_size) {
       Iter beg(shared_beg);
       Iter end(shared_end);
 
       bool didwork = false;
+      Diff_ty size = 0;
 
-      while (getWork(beg, end, chunk_size)) {
+      while (getWork(beg, end, chunk_size, size)) {
 
         didwork = true;
 
+        if (CHUNK_STATS) {
+          ++num_chunks;
+          max_chunk = std::max(max_chunk, size);
+        }
+
+        if (ADAPTIVE) {
+          auto start = std::chrono::steady_clock::now();
+          for (; beg != end; ++beg) {
+            if (NEED_STATS) {
+              ++num_iter;
+            }
+            func(*beg);
+          }
+          adaptChunkSize(size, std::chrono::steady_clock::now() - start);
+          continue;
+        }
+
         for (; beg != end; ++beg) {
           if (NEED_STATS) {
             ++num_iter;
@@ -114,7 +161,39 @@ class DoAllStealingExec {
     }
 
   private:
-    bool getWork(Iter& priv_beg, Iter& priv_end, const unsigned chunk_size) {
+    //! Doubles or halves the chunk size when a full-sized chunk ran outside
+    //! of [CHUNK_MIN_NS, CHUNK_MAX_NS]
+    void adaptChunkSize(Diff_ty size,
+                        std::chrono::steady_clock::duration elapsed) {
+      uint64_t ns =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+              .count();
+      if (ns > CHUNK_MAX_NS) {
+        adaptive_size =
+            std::max(adaptive_size / 2, Diff_ty{chunk_size_tag::MIN});
+      } else if (ns < CHUNK_MIN_NS && size == adaptive_size) {
+        adaptive_size =
+            std::min(adaptive_size * 2, Diff_ty{chunk_size_tag::MAX});
+      }
+    }
+
+    //! Guided self-scheduling: take no more than an even share of the
+    //! remaining local work among all threads, so that the tail of the range
+    //! is left in small pieces for thieves. Called holding work_mutex.
+    Diff_ty guidedChunkSize() {
+      if (stolen_from) {
+        // others ran dry, so expose work sooner
+        adaptive_size =
+            std::max(adaptive_size / 2, Diff_ty{chunk_size_tag::MIN});
+        stolen_from = false;
+      }
+      Diff_ty share = (m_size + activeThreads - 1) / activeThreads;
+      return std::max(std::min(adaptive_size, share),
+                      Diff_ty{chunk_size_tag::MIN});
+    }
+
+    bool getWork(Iter& priv_beg, Iter& priv_end, Diff_ty chunk_size,
+                 Diff_ty& size) {
       bool succ = false;
 
       work_mutex.lock();
@@ -122,13 +201,19 @@ class DoAllStealingExec {
         if (hasWorkWeak()) {
           succ = true;
 
+          if (ADAPTIVE) {
+            chunk_size = guidedChunkSize();
+          }
+
           Iter nbeg = shared_beg;
           if (m_size <= chunk_size) {
             nbeg   = shared_end;
+            size   = m_size;
             m_size = 0;
 
           } else {
             std::advance(nbeg, chunk_size);
+            size = chunk_size;
             m_size -= chunk_size;
             assert(m_size > 0);
           }
@@ -182,7 +267,8 @@ class DoAllStealingExec {
       if (work_mutex.try_lock()) {
 
         if (hasWorkWeak()) {
-          succ = true;
+          succ        = true;
+          stolen_from = true;
 
           if (amount == HALF && m_size > (Diff_ty)chunk_size) {
             steal_size = m_size / 2;
@@ -250,6 +336,9 @@ private:
       assert(std::distance(steal_beg, steal_end) == steal_size);
 
       poor.assignWork(steal_beg, steal_end, steal_size);
+      if (CHUNK_STATS) {
+        ++poor.num_steals;
+      }
     }
 
     return succ;
@@ -386,8 +475,8 @@ public:
 
     unsigned id = substrate::ThreadPool::getTID();
 
-    *workers.getLocal(id) =
-        ThreadContext(id, range.local_begin(), range.local_end());
+    *workers.getLocal(id) = ThreadContext(id, range.local_begin(),
+                                          range.local_end(), chunk_size);
 
     initTime.stop();
   }
@@ -406,6 +495,7 @@ public:
 
   void operator()(void) {
 
+    substrate::TraceLoop trace(loopname);
     ThreadContext& ctx = *workers.getLocal();
     totalTime.start();
 
@@ -454,6 +544,17 @@ public:
     if (NEED_STATS) {
       galois::runtime::reportStat_Tsum(loopname, "Iterations", ctx.num_iter);
     }
+
+    if (CHUNK_STATS) {
+      galois::runtime::reportStat_Tsum(loopname, "Chunks", ctx.num_chunks);
+      galois::runtime::reportStat_Tsum(loopname, "Steals", ctx.num_steals);
+      galois::runtime::reportStat_Tmax(loopname, "ChunkSizeMax",
+                                       ctx.max_chunk);
+      if (ctx.num_chunks > 0) {
+        galois::runtime::reportStat_Tavg(loopname, "ChunkSize",
+                                         ctx.num_iter / ctx.num_chunks);
+      }
+    }
   }
 };
 
@@ -489,6 +590,7 @@ struct ChooseDoAllImpl<false> {
               NEED_STATS && has_trait<more_stats_tag, ArgsT>();
 
           const char* const loopname = galois::internal::getLoopName(argsTuple);
+          substrate::TraceLoop trace(loopname);
 
           PerThreadTimer<MORE_STATS> totalTime(loopname, "Total");
           PerThreadTimer<MORE_STATS> initTime(loopname, "Init");
@@ -551,6 +653,92 @@ void do_all_gen(const R& range, F&& func, const ArgsTuple& argsTuple) {
   internal::ChooseDoAllImpl<STEAL>::call(range, func_ref, argsT);
 
   timer.stop();
+
+  pagePoolTrim();
+}
+
+/**
+ * do_all over an EdgeBalancedRange: runs the blocks of the range as the
+ * iterations of a do_all loop, one block per chunk, and combines the pieces
+ * of split nodes with the edge_reduce trait if there is one. The pieces are
+ * combined in edge order, so the result is deterministic even if combine is
+ * not associative (e.g., floating point addition).
+ */
+template <typename Graph, bool InEdges, typename F, typename ArgsTuple>
+void do_all_gen(const EdgeBalancedRange<Graph, InEdges>& range, F&& func,
+                const ArgsTuple& argsTuple) {
+  typedef typename EdgeBalancedRange<Graph, InEdges>::GraphNode GraphNode;
+  typedef typename EdgeBalancedRange<Graph, InEdges>::edge_iterator Iter;
+  typedef std::invoke_result_t<F&, GraphNode, Iter, Iter> Result;
+
+  auto blocks =
+      makeStandardRange(boost::counting_iterator<uint64_t>(0),
+                        boost::counting_iterator<uint64_t>(range.numBlocks()));
+  // a block is already a chunk
+  auto argsT = std::tuple_cat(std::make_tuple(chunk_size<1>()), argsTuple);
+
+  if constexpr (!has_trait<edge_reduce_tag, ArgsTuple>()) {
+    static_assert(std::is_void<Result>::value,
+                  "operator returns a value but there is no edge_reduce");
+
+    do_all_gen(
+        blocks,
+        [&](uint64_t k) {
+          range.for_each_in_block(
+              k, [&](GraphNode n, Iter ii, Iter ei, bool split) {
+                if (!split || ii != ei) {
+                  func(n, ii, ei);
+                }
+              });
+        },
+        argsT);
+  } else {
+    typedef std::decay_t<Result> T;
+    // slice j > 0 of a split node is the only continued slice in its block,
+    // so each slice has a slot of its own
+    struct Partial {
+      std::atomic<uint64_t> slices{0};
+      T first{};     //!< first slice of the split node beginning in the block
+      T continued{}; //!< slice of the split node continued into the block
+    };
+
+    auto reduce = get_trait_value<edge_reduce_tag>(argsTuple);
+    // indexed by block and shared by all threads of the loop
+    std::unique_ptr<Partial[]> partials(new Partial[range.numBlocks()]);
+
+    do_all_gen(
+        blocks,
+        [&](uint64_t k) {
+          range.for_each_in_block(
+              k, [&](GraphNode n, Iter ii, Iter ei, bool split) {
+                if (!split) {
+                  reduce.finish(n, func(n, ii, ei));
+                  return;
+                }
+                T value        = ii != ei ? T(func(n, ii, ei)) : T();
+                uint64_t first = range.firstBlock(n);
+                if (k == first) {
+                  partials[k].first = std::move(value);
+                } else {
+                  partials[k].continued = std::move(value);
+                }
+                // the last slice to finish combines all of them in order, so
+                // the result does not depend on scheduling
+                uint64_t numSlices = range.numSlices(n);
+                Partial& p         = partials[first];
+                if (p.slices.fetch_add(1, std::memory_order_acq_rel) + 1 !=
+                    numSlices) {
+                  return;
+                }
+                T sum = std::move(p.first);
+                for (uint64_t j = 1; j < numSlices; ++j) {
+                  sum = reduce.combine(sum, partials[first + j].continued);
+                }
+                reduce.finish(n, sum);
+              });
+        },
+        argsT);
+  }
 }
 
 } // namespace galois::runtime
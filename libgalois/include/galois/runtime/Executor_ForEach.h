@@ -31,11 +31,13 @@
 #include "galois/runtime/Context.h"
 #include "galois/runtime/LoopStatistics.h"
 #include "galois/runtime/OperatorReferenceTypes.h"
+#include "galois/runtime/PagePool.h"
 #include "galois/runtime/Range.h"
 #include "galois/runtime/Statistics.h"
 #include "galois/runtime/Substrate.h"
 #include "galois/runtime/ThreadTimer.h"
 #include "galois/runtime/UserContextAccess.h"
+#include "galois/substrate/EventTrace.h"
 #include "galois/substrate/Termination.h"
 #include "galois/substrate/ThreadPool.h"
 #include "galois/Threads.h"
@@ -153,6 +155,8 @@ public:
   static constexpr bool needsPush = !has_trait<no_pushes_tag, ArgsTy>();
   static constexpr bool needsAborts =
       !has_trait<disable_conflict_detection_tag, ArgsTy>();
+  static constexpr bool flagConflicts =
+      has_trait<flag_conflicts_tag, ArgsTy>();
   static constexpr bool needsPia   = has_trait<per_iter_alloc_tag, ArgsTy>();
   static constexpr bool needsBreak = has_trait<parallel_break_tag, ArgsTy>();
   static constexpr bool MORE_STATS =
@@ -223,6 +227,7 @@ protected:
   GALOIS_ATTRIBUTE_NOINLINE void abortIteration(const Item& item,
                                                 ThreadLocalData& tld) {
     assert(needsAborts);
+    substrate::traceEvent(substrate::TraceEvent::ABORT);
     tld.ctx.cancelIteration();
     tld.inc_conflicts();
     aborted.push(item);
@@ -278,10 +283,34 @@ protected:
 #endif
   }
 
+  //! Like doProcess for operators that check for conflicts themselves;
+  //! returns false if the iteration has to be aborted
+  inline bool doProcessFlagged(value_type& val, ThreadLocalData& tld) {
+    tld.ctx.startIteration();
+    tld.inc_iterations();
+    tld.function(val, tld.facing.data());
+    if (tld.ctx.isConflicted())
+      return false;
+    commitIteration(tld);
+    return true;
+  }
+
+  template <unsigned int limit, typename WL>
+  void runQueueFlagged(ThreadLocalData& tld, WL& lwl, RunQueueState<WL>& s) {
+    while ((!limit || s.num < limit) && (s.item = lwl.pop())) {
+      ++s.num;
+      if (!doProcessFlagged(aborted.value(*s.item), tld))
+        abortIteration(*s.item, tld);
+    }
+  }
+
   template <unsigned int limit, typename WL>
   bool runQueue(ThreadLocalData& tld, WL& lwl) {
     RunQueueState<WL> s;
-    runQueueDispatch<limit>(tld, lwl, s);
+    if (flagConflicts)
+      runQueueFlagged<limit>(tld, lwl, s);
+    else
+      runQueueDispatch<limit>(tld, lwl, s);
     return s.num > 0;
   }
 
@@ -303,6 +332,13 @@ protected:
     return wl.empty();
   }
 
+  void reportStats(WorkListTy&, ...) {}
+
+  template <typename WL>
+  auto reportStats(WL& wl, int) -> decltype(wl.reportStats(loopname), void()) {
+    wl.reportStats(loopname);
+  }
+
   template <bool couldAbort, bool isLeader>
   void go() {
 
@@ -312,8 +348,10 @@ protected:
     ThreadLocalData tld(origFunction, loopname);
     if (needsBreak)
       tld.facing.setBreakFlag(&broke);
-    if (couldAbort)
+    if (couldAbort) {
+      tld.ctx.setFlagConflicts(flagConflicts);
       setThreadContext(&tld.ctx);
+    }
     if (needsPush && !couldAbort)
       tld.facing.setFastPushBack(std::bind(&ForEachExecutor::fastPushBack, this,
                                            std::placeholders::_1));
@@ -358,6 +396,9 @@ protected:
 
     if (couldAbort)
       setThreadContext(0);
+
+    if (needStats)
+      reportStats(wl, 0);
   }
 
   struct T1 {};
@@ -402,6 +443,7 @@ public:
   }
 
   void operator()() {
+    substrate::TraceLoop trace(loopname);
     bool isLeader   = substrate::ThreadPool::isLeader();
     bool couldAbort = needsAborts && activeThreads > 1;
     if (couldAbort && isLeader)
@@ -483,6 +525,8 @@ void for_each_gen(const RangeTy& r, FunctionTy&& fn, const TupleTy& tpl) {
   runtime::for_each_impl(r, std::forward<FunctionTy>(fn), xtpl);
 
   timer.stop();
+
+  pagePoolTrim();
 }
 
 } // end namespace runtime
@@ -23,8 +23,10 @@
 #include "galois/config.h"
 #include "galois/gIO.h"
 #include "galois/runtime/OperatorReferenceTypes.h"
+#include "galois/runtime/PagePool.h"
 #include "galois/runtime/Statistics.h"
 #include "galois/runtime/ThreadTimer.h"
+#include "galois/substrate/EventTrace.h"
 #include "galois/substrate/ThreadPool.h"
 #include "galois/Threads.h"
 #include "galois/Timer.h"
@@ -58,7 +60,14 @@ inline void on_each_impl(FunctionTy&& fn, const ArgsTy& argsTuple) {
   auto runFun = [&] {
     execTime.start();
 
-    fn_ref(substrate::ThreadPool::getTID(), numT);
+    if (NEEDS_STATS) {
+      // unnamed on_each runs inside other loops (e.g., do_all); do not
+      // trace it separately
+      substrate::TraceLoop trace(loopname);
+      fn_ref(substrate::ThreadPool::getTID(), numT);
+    } else {
+      fn_ref(substrate::ThreadPool::getTID(), numT);
+    }
 
     execTime.stop();
   };
@@ -66,6 +75,8 @@ inline void on_each_impl(FunctionTy&& fn, const ArgsTy& argsTuple) {
   timer.start();
   substrate::getThreadPool().run(numT, runFun);
   timer.stop();
+
+  pagePoolTrim();
 }
 
 } // namespace internal
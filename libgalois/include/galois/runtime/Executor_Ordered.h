@@ -20,31 +20,354 @@
 #ifndef GALOIS_RUNTIME_EXECUTOR_ORDERED_H
 #define GALOIS_RUNTIME_EXECUTOR_ORDERED_H
 
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <vector>
+
 #include "galois/config.h"
+#include "galois/gstl.h"
+#include "galois/optional.h"
+#include "galois/runtime/Context.h"
+#include "galois/runtime/PagePool.h"
+#include "galois/runtime/Statistics.h"
+#include "galois/runtime/Substrate.h"
+#include "galois/runtime/UserContextAccess.h"
+#include "galois/substrate/Barrier.h"
+#include "galois/substrate/PerThreadStorage.h"
+#include "galois/substrate/ThreadPool.h"
 
 namespace galois {
 namespace runtime {
 
-// TODO(ddn): Pull in and integrate in executors from exp
+//! Implementation of ordered execution
+namespace internal {
 
-template <typename Iter, typename Cmp, typename NhFunc, typename OpFunc>
-void for_each_ordered_impl(Iter GALOIS_UNUSED(beg), Iter GALOIS_UNUSED(end),
-                           const Cmp& GALOIS_UNUSED(cmp),
-                           const NhFunc& GALOIS_UNUSED(nhFunc),
-                           const OpFunc& GALOIS_UNUSED(opFunc),
-                           const char* GALOIS_UNUSED(loopname)) {
-  GALOIS_DIE("not yet implemented");
-}
+/**
+ * Conflict detection context of one task of the ordered executor. Marking
+ * the neighborhood of a task steals the locks of later tasks and gives up
+ * on the locks of earlier tasks, so after every task of a window has marked
+ * its neighborhood, the tasks that still own all their locks do not
+ * conflict with any earlier task of the window.
+ */
+template <typename T, typename Cmp>
+class OrderedContext : public SimpleRuntimeContext {
+  const Cmp& cmp;
+  //! tie breaker among tasks with equal priority
+  uint64_t id;
+  bool notReady;
+
+public:
+  T item;
+
+  OrderedContext(const T& i, const Cmp& c, uint64_t _id)
+      : SimpleRuntimeContext(true), cmp(c), id(_id), notReady(false),
+        item(i) {}
+
+  //! True if no earlier task conflicted with this one
+  bool isReady() const { return !notReady; }
+
+  //! Total order on tasks: by priority, then by id
+  bool precedes(const OrderedContext& o) const {
+    bool a = cmp(item, o.item);
+    bool b = cmp(o.item, item);
+    if (a != b)
+      return a;
+    return id < o.id;
+  }
+
+  virtual void subAcquire(Lockable* lockable, galois::MethodFlag) {
+    if (this->tryLock(lockable))
+      this->addToNhood(lockable);
+
+    OrderedContext* other;
+    do {
+      other = static_cast<OrderedContext*>(this->getOwner(lockable));
+      if (other == this)
+        return;
+      if (other && other->precedes(*this)) {
+        // A lock that an earlier task holds
+        notReady = true;
+        return;
+      }
+    } while (!this->stealByCAS(lockable, other));
+
+    // Disable loser
+    if (other) {
+      // Only need atomic write
+      other->notReady = true;
+    }
+  }
+};
+
+/**
+ * Speculative executor for ordered loops (an implicit KDG, kinetic
+ * dependence graph, executor).
+ *
+ * Pending tasks are kept in per-thread heaps. Execution proceeds in rounds
+ * over a window made of the earliest pending tasks of the whole loop:
+ *
+ *  1. Every thread takes its share of the window from its heap. The window
+ *     is then cut to a prefix of the global priority order, so every
+ *     pending task earlier than a window task is also in the window.
+ *  2. The neighborhood function of every window task is run under an
+ *     OrderedContext. Conflicts are resolved in favor of the earlier task.
+ *  3. Tasks that kept their whole neighborhood (sources) run the operator
+ *     without further conflict detection. The other tasks go back to the
+ *     heaps, and new work is spread over the heaps of all threads.
+ *
+ * The earliest task of a window is always a source, so every round makes
+ * progress. The window grows while most of its tasks commit and shrinks
+ * while most abort.
+ *
+ * Executing the sources of a window in any order is equivalent to executing
+ * them in priority order if sources are stable: new tasks are not earlier
+ * than the task that creates them, and a task that has no conflict with any
+ * earlier pending task cannot gain one from tasks created later. When that
+ * is not true of every task, a stability test picks the sources that may
+ * run out of order; the other sources wait until they are the earliest
+ * task of a window.
+ */
+template <typename T, typename Cmp, typename NhFunc, typename OpFunc,
+          typename StableTest>
+class OrderedExecutor {
+  typedef OrderedContext<T, Cmp> Context;
+
+  //! Bounds on the number of window tasks per thread
+  static constexpr size_t minWindow = 4;
+  static constexpr size_t maxWindow = 1 << 16;
+
+  struct ThreadData {
+    //! pending tasks; a heap with the earliest task on top
+    std::vector<T> heap;
+    //! new tasks to spread over all threads at the next round
+    std::vector<T> outbox;
+    std::deque<Context> window;
+    UserContextAccess<T> facing;
+    //! earliest task taken from the heap and earliest task left behind
+    galois::optional<T> first;
+    galois::optional<T> rest;
+    size_t rounds     = 0;
+    size_t iterations = 0;
+    size_t commits    = 0;
+    size_t pushes     = 0;
+  };
+
+  const Cmp& cmp;
+  const NhFunc& nhFunc;
+  const OpFunc& opFunc;
+  const StableTest& stabilityTest;
+  const char* loopname;
+  substrate::Barrier& barrier;
+  substrate::PerThreadStorage<ThreadData> data;
+  //! number of window tasks per thread; written by thread 0 only
+  size_t windowSize;
+  //! totals over all threads when windowSize was last updated
+  size_t lastIterations;
+  size_t lastCommits;
+
+  bool later(const T& a, const T& b) const { return cmp(b, a) && !cmp(a, b); }
+
+  void pushHeap(ThreadData& td, const T& item) {
+    td.heap.push_back(item);
+    std::push_heap(td.heap.begin(), td.heap.end(),
+                   [this](const T& a, const T& b) { return later(a, b); });
+  }
+
+  T popHeap(ThreadData& td) {
+    std::pop_heap(td.heap.begin(), td.heap.end(),
+                  [this](const T& a, const T& b) { return later(a, b); });
+    T item = td.heap.back();
+    td.heap.pop_back();
+    return item;
+  }
+
+  void updateWindowSize() {
+    size_t iterations = 0;
+    size_t commits    = 0;
+    for (unsigned i = 0; i < activeThreads; ++i) {
+      iterations += data.getRemote(i)->iterations;
+      commits += data.getRemote(i)->commits;
+    }
+    size_t tried     = iterations - lastIterations;
+    size_t committed = commits - lastCommits;
+    lastIterations   = iterations;
+    lastCommits      = commits;
+
+    if (committed * 4 >= tried * 3)
+      windowSize = std::min(windowSize * 2, maxWindow);
+    else if (committed * 2 < tried)
+      windowSize = std::max(windowSize / 2, minWindow);
+  }
+
+  //! Phase 1: take a share of the window from the heap
+  void takeWindow(ThreadData& td, unsigned tid) {
+    // collect the new work of every thread, interleaved across threads
+    for (unsigned i = 0; i < activeThreads; ++i) {
+      std::vector<T>& out = data.getRemote(i)->outbox;
+      for (size_t j = tid; j < out.size(); j += activeThreads)
+        pushHeap(td, out[j]);
+    }
+
+    td.window.clear();
+    td.first = galois::optional<T>();
+    td.rest  = galois::optional<T>();
+    uint64_t base = uint64_t(tid) << 40;
+    for (size_t k = 0; k < windowSize && !td.heap.empty(); ++k)
+      td.window.emplace_back(popHeap(td), cmp, base + k);
+    if (!td.window.empty())
+      td.first = td.window.front().item;
+    if (!td.heap.empty())
+      td.rest = td.heap.front();
+  }
+
+  /**
+   * Phase 2: cut the window to the tasks that are not later than any task
+   * left in a heap and mark their neighborhoods. Returns false if there is
+   * no work left anywhere. Sets earliest if this thread holds the earliest
+   * task of the window.
+   */
+  bool markWindow(ThreadData& td, unsigned tid, bool& earliest) {
+    const T* limit  = nullptr;
+    int earliestTid = -1;
+    for (unsigned i = 0; i < activeThreads; ++i) {
+      ThreadData& o = *data.getRemote(i);
+      if (o.rest && (!limit || later(*limit, *o.rest)))
+        limit = &*o.rest;
+      if (o.first &&
+          (earliestTid < 0 ||
+           later(*data.getRemote(earliestTid)->first, *o.first)))
+        earliestTid = i;
+    }
+    if (earliestTid < 0)
+      return false;
+    earliest = earliestTid == int(tid);
+
+    if (limit) {
+      while (!td.window.empty() && later(td.window.back().item, *limit)) {
+        pushHeap(td, td.window.back().item);
+        td.window.pop_back();
+      }
+    }
+
+    for (auto& ctx : td.window) {
+      ctx.startIteration();
+      setThreadContext(&ctx);
+      nhFunc(ctx.item);
+    }
+    setThreadContext(nullptr);
+    return true;
+  }
+
+  //! Phase 3: run the sources and release the neighborhoods
+  void executeWindow(ThreadData& td, bool earliest) {
+    td.outbox.clear();
+    bool first = true;
+    for (auto& ctx : td.window) {
+      ++td.iterations;
+      if (ctx.isReady() && ((earliest && first) || stabilityTest(ctx.item))) {
+        opFunc(ctx.item, td.facing.data());
+        auto& pb = td.facing.getPushBuffer();
+        td.pushes += pb.size();
+        td.outbox.insert(td.outbox.end(), pb.begin(), pb.end());
+        td.facing.resetPushBuffer();
+        td.facing.resetAlloc();
+        ++td.commits;
+      } else {
+        pushHeap(td, ctx.item);
+      }
+      first = false;
+    }
+    // The locks of a task are released by the task that first took them;
+    // no task looks at a lock until the next round
+    for (auto& ctx : td.window)
+      ctx.commitIteration();
+  }
+
+public:
+  OrderedExecutor(const Cmp& c, const NhFunc& nh, const OpFunc& op,
+                  const StableTest& st, const char* ln)
+      : cmp(c), nhFunc(nh), opFunc(op), stabilityTest(st), loopname(ln),
+        barrier(getBarrier(activeThreads)), windowSize(minWindow),
+        lastIterations(0), lastCommits(0) {}
+
+  template <typename Iter>
+  void initThread(Iter b, Iter e) {
+    ThreadData& td = *data.getLocal();
+    auto r = galois::block_range(b, e, substrate::ThreadPool::getTID(),
+                                 activeThreads);
+    for (; r.first != r.second; ++r.first)
+      pushHeap(td, *r.first);
+  }
+
+  void operator()() {
+    unsigned tid   = substrate::ThreadPool::getTID();
+    ThreadData& td = *data.getLocal();
+
+    while (true) {
+      takeWindow(td, tid);
+      barrier.wait();
+
+      if (tid == 0)
+        updateWindowSize();
+      bool earliest = false;
+      if (!markWindow(td, tid, earliest))
+        break;
+      barrier.wait();
+
+      executeWindow(td, earliest);
+      ++td.rounds;
+      barrier.wait();
+    }
+
+    const char* ln = loopname ? loopname : "ANON_LOOP";
+    reportStat_Tsum(ln, "Iterations", td.iterations);
+    reportStat_Tsum(ln, "Commits", td.commits);
+    reportStat_Tsum(ln, "Pushes", td.pushes);
+    reportStat_Tsum(ln, "Conflicts", td.iterations - td.commits);
+    if (tid == 0)
+      reportStat_Single(ln, "RoundsExecuted", td.rounds);
+  }
+};
+
+//! Stability test of loops whose sources are all stable
+struct AlwaysStable {
+  template <typename T>
+  bool operator()(const T&) const {
+    return true;
+  }
+};
+
+} // namespace internal
 
 template <typename Iter, typename Cmp, typename NhFunc, typename OpFunc,
           typename StableTest>
-void for_each_ordered_impl(Iter GALOIS_UNUSED(beg), Iter GALOIS_UNUSED(end),
-                           const Cmp& GALOIS_UNUSED(cmp),
-                           const NhFunc& GALOIS_UNUSED(nhFunc),
-                           const OpFunc& GALOIS_UNUSED(opFunc),
-                           const StableTest& GALOIS_UNUSED(stabilityTest),
-                           const char* GALOIS_UNUSED(loopname)) {
-  GALOIS_DIE("not yet implemented");
+void for_each_ordered_impl(Iter beg, Iter end, const Cmp& cmp,
+                           const NhFunc& nhFunc, const OpFunc& opFunc,
+                           const StableTest& stabilityTest,
+                           const char* loopname) {
+  typedef typename std::iterator_traits<Iter>::value_type value_type;
+  typedef internal::OrderedExecutor<value_type, Cmp, NhFunc, OpFunc,
+                                    StableTest>
+      WorkTy;
+
+  auto& barrier = getBarrier(activeThreads);
+  {
+    WorkTy W(cmp, nhFunc, opFunc, stabilityTest, loopname);
+    substrate::getThreadPool().run(
+        activeThreads, [&W, beg, end]() { W.initThread(beg, end); },
+        std::ref(barrier), std::ref(W));
+  }
+  pagePoolTrim();
+}
+
+template <typename Iter, typename Cmp, typename NhFunc, typename OpFunc>
+void for_each_ordered_impl(Iter beg, Iter end, const Cmp& cmp,
+                           const NhFunc& nhFunc, const OpFunc& opFunc,
+                           const char* loopname) {
+  for_each_ordered_impl(beg, end, cmp, nhFunc, opFunc,
+                        internal::AlwaysStable(), loopname);
 }
 
 } // end namespace runtime
@@ -20,11 +20,13 @@
 #ifndef GALOIS_RUNTIME_PAGEPOOL_H
 #define GALOIS_RUNTIME_PAGEPOOL_H
 
+#include <atomic>
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <mutex>
 #include <numeric>
-#include <unordered_map>
 #include <vector>
 
 #include "galois/config.h"
@@ -53,6 +55,16 @@ int numPagePoolAllocTotal();
 //! subsystem
 int numPagePoolAllocForThread(unsigned tid);
 
+/**
+ * Sets the high water mark of the page pool: the number of idle pages each
+ * thread keeps on top of the pages it preallocated. Idle pages above the mark
+ * are returned to the OS between parallel regions. A negative value (the
+ * default, unless GALOIS_PAGE_POOL_HIGH_WATER is set) never returns pages.
+ */
+void setPagePoolHighWater(int pages);
+//! Returns idle pages above the high water mark to the OS
+void pagePoolTrim();
+
 namespace internal {
 
 struct FreeNode {
@@ -60,28 +72,101 @@ struct FreeNode {
 };
 
 typedef galois::substrate::PtrLock<FreeNode> HeadPtr;
-typedef galois::substrate::CacheLineStorage<HeadPtr> HeadPtrStorage;
+
+//! Free list of a thread and the number of pages on it
+struct FreeList {
+  HeadPtr head;
+  //! protected by head
+  size_t numFree = 0;
+  //! idle pages the thread asked to keep with pagePoolPreAlloc
+  size_t reserved = 0;
+};
+
+typedef galois::substrate::CacheLineStorage<FreeList> FreeListStorage;
+
+/**
+ * Lock-free map from page address to the thread that allocated the page.
+ * Pages are at least allocSize apart, so the page number of an address
+ * indexes a two level radix tree whose leaves are created on first use.
+ */
+class PageOwnerMap {
+  static constexpr unsigned ADDR_BITS = 48;
+  static constexpr unsigned LEAF_BITS = 15;
+  static constexpr size_t LEAF_SIZE   = size_t(1) << LEAF_BITS;
+
+  struct Leaf {
+    // owner tid + 1; 0 means the page is not from the pool
+    std::atomic<int> owner[LEAF_SIZE];
+  };
+
+  unsigned pageBits;
+  std::vector<std::atomic<Leaf*>> roots;
+
+  std::atomic<int>& entry(void* ptr) {
+    uintptr_t page = reinterpret_cast<uintptr_t>(ptr) >> pageBits;
+    auto& root     = roots[page >> LEAF_BITS];
+    Leaf* leaf     = root.load(std::memory_order_acquire);
+    if (!leaf) {
+      Leaf* fresh = new Leaf();
+      if (root.compare_exchange_strong(leaf, fresh)) {
+        leaf = fresh;
+      } else {
+        delete fresh;
+      }
+    }
+    return leaf->owner[page & (LEAF_SIZE - 1)];
+  }
+
+public:
+  explicit PageOwnerMap(size_t pageSize)
+      : pageBits(__builtin_ctzll(pageSize)),
+        roots(size_t(1) << (ADDR_BITS - pageBits - LEAF_BITS)) {
+    assert((pageSize & (pageSize - 1)) == 0);
+  }
+
+  ~PageOwnerMap() {
+    for (auto& root : roots) {
+      delete root.load();
+    }
+  }
+
+  PageOwnerMap(const PageOwnerMap&) = delete;
+  PageOwnerMap& operator=(const PageOwnerMap&) = delete;
+
+  void set(void* ptr, int tid) {
+    assert(reinterpret_cast<uintptr_t>(ptr) >> ADDR_BITS == 0);
+    entry(ptr).store(tid + 1, std::memory_order_release);
+  }
+
+  void clear(void* ptr) { entry(ptr).store(0, std::memory_order_release); }
+
+  int get(void* ptr) {
+    int owner = entry(ptr).load(std::memory_order_acquire);
+    assert(owner && "page not allocated by the page pool");
+    return owner - 1;
+  }
+};
 
 // Tracks pages allocated
 template <typename _UNUSED = void>
 class PageAllocState {
   std::deque<std::atomic<int>> counts;
-  std::vector<HeadPtrStorage> pool;
-  std::unordered_map<void*, int> ownerMap;
-  galois::substrate::SimpleLock mapLock;
+  std::vector<FreeListStorage> pool;
+  PageOwnerMap ownerMap;
+  std::atomic<int> highWater;
 
   void* allocFromOS() {
     void* ptr = galois::substrate::allocPages(1, true);
     assert(ptr);
     auto tid = galois::substrate::ThreadPool::getTID();
     counts[tid] += 1;
-    std::lock_guard<galois::substrate::SimpleLock> lg(mapLock);
-    ownerMap[ptr] = tid;
+    ownerMap.set(ptr, tid);
     return ptr;
   }
 
 public:
-  PageAllocState() {
+  PageAllocState()
+      : ownerMap(galois::substrate::allocSize()), highWater(-1) {
     auto num = galois::substrate::getThreadPool().getMaxThreads();
     counts.resize(num);
     pool.resize(num);
@@ -94,12 +179,14 @@ public:
   }
 
   void* pageAlloc() {
-    auto tid    = galois::substrate::ThreadPool::getTID();
-    HeadPtr& hp = pool[tid].data;
+    auto tid     = galois::substrate::ThreadPool::getTID();
+    FreeList& fl = pool[tid].data;
+    HeadPtr& hp  = fl.head;
     if (hp.getValue()) {
       hp.lock();
       FreeNode* h = hp.getValue();
       if (h) {
+        fl.numFree -= 1;
         hp.unlock_and_set(h->next);
         return h;
       }
@@ -110,18 +197,63 @@ public:
 
   void pageFree(void* ptr) {
     assert(ptr);
-    mapLock.lock();
-    assert(ownerMap.count(ptr));
-    int i = ownerMap[ptr];
-    mapLock.unlock();
-    HeadPtr& hp = pool[i].data;
+    FreeList& fl = pool[ownerMap.get(ptr)].data;
+    HeadPtr& hp  = fl.head;
     hp.lock();
     FreeNode* nh = reinterpret_cast<FreeNode*>(ptr);
     nh->next     = hp.getValue();
+    fl.numFree += 1;
     hp.unlock_and_set(nh);
   }
 
-  void pagePreAlloc() { pageFree(allocFromOS()); }
+  void pagePreAlloc() {
+    pageFree(allocFromOS());
+    auto tid = galois::substrate::ThreadPool::getTID();
+    pool[tid].data.head.lock();
+    pool[tid].data.reserved += 1;
+    pool[tid].data.head.unlock();
+  }
+
+  void setHighWater(int pages) { highWater = pages; }
+
+  int getHighWater() const { return highWater; }
+
+  //! Unmaps the idle pages of each thread above its reserve plus the high
+  //! water mark. Idle pages are only counted per thread, under the free list
+  //! lock, so allocation and free never touch shared counters.
+  void trim() {
+    int hw = highWater.load(std::memory_order_relaxed);
+    if (hw < 0)
+      return;
+
+    for (unsigned tid = 0; tid < pool.size(); ++tid) {
+      FreeList& fl = pool[tid].data;
+      HeadPtr& hp  = fl.head;
+      hp.lock();
+      size_t keep = fl.reserved + hw;
+      if (fl.numFree <= keep) {
+        hp.unlock();
+        continue;
+      }
+      FreeNode* trimmed = nullptr;
+      while (fl.numFree > keep) {
+        FreeNode* h = hp.getValue();
+        hp.setValue(h->next);
+        h->next = trimmed;
+        trimmed = h;
+        fl.numFree -= 1;
+      }
+      hp.unlock();
+
+      while (trimmed) {
+        FreeNode* next = trimmed->next;
+        ownerMap.clear(trimmed);
+        galois::substrate::freePages(trimmed, 1);
+        counts[tid] -= 1;
+        trimmed = next;
+      }
+    }
+  }
 };
 
 //! Initialize PagePool, used by runtime::init();
@@ -20,12 +20,16 @@
 #ifndef GALOIS_RUNTIME_RANGE_H
 #define GALOIS_RUNTIME_RANGE_H
 
+#include <algorithm>
+#include <cstdint>
 #include <iterator>
+#include <utility>
 
 #include <boost/iterator/counting_iterator.hpp>
 
 #include "galois/config.h"
 #include "galois/gstl.h"
+#include "galois/MethodFlags.h"
 #include "galois/substrate/ThreadPool.h"
 
 namespace galois {
@@ -221,6 +225,146 @@ inline SpecificRange<IterTy> makeSpecificRange(IterTy begin, IterTy end,
   return SpecificRange<IterTy>(begin, end, thread_ranges);
 }
 
+namespace internal {
+
+//! Edge iterator of an EdgeBalancedRange: what edge_begin returns, or
+//! in_edge_begin when balancing in-edges
+template <typename Graph, bool InEdges>
+struct EdgeBalancedIterator {
+  typedef typename Graph::edge_iterator type;
+};
+
+template <typename Graph>
+struct EdgeBalancedIterator<Graph, true> {
+  typedef decltype(std::declval<Graph&>().in_edge_begin(
+      std::declval<typename Graph::GraphNode>(), MethodFlag::UNPROTECTED))
+      type;
+};
+
+} // namespace internal
+
+/**
+ * EdgeBalancedRange divides the nodes of a CSR graph, together with their
+ * edges, into blocks of equal weight, where a node weighs one unit for itself
+ * plus one unit per edge. The units are laid out in node order, so the unit
+ * offsets are the prefix sums of the edge index array shifted by node id.
+ *
+ * A node whose units fit in a block is processed whole by the block its first
+ * unit falls in. The adjacency list of a larger node is cut at block
+ * boundaries, so that several threads can work on its edges; such a node is
+ * split. At most one split node begins in any block.
+ *
+ * @tparam Graph CSR graph whose edge iterators count edges from 0
+ * @tparam InEdges balance the in-edges (in_edge_begin, in_edge_end) of the
+ * graph instead of its out-edges
+ */
+template <typename Graph, bool InEdges = false>
+class EdgeBalancedRange {
+public:
+  typedef typename Graph::GraphNode GraphNode;
+  typedef typename internal::EdgeBalancedIterator<Graph, InEdges>::type
+      edge_iterator;
+
+private:
+  Graph* graph;
+  uint64_t blockSize;
+  uint64_t numNodes;
+  uint64_t numUnits;
+
+public:
+  EdgeBalancedRange(Graph& g, uint64_t bs)
+      : graph(&g), blockSize(std::max(bs, uint64_t{1})), numNodes(g.size()),
+        numUnits(numNodes ? unitEnd(numNodes - 1) : 0) {}
+
+  Graph& get_graph() const { return *graph; }
+
+  edge_iterator edge_begin(GraphNode n) const {
+    if constexpr (InEdges) {
+      return graph->in_edge_begin(n, MethodFlag::UNPROTECTED);
+    } else {
+      return graph->edge_begin(n, MethodFlag::UNPROTECTED);
+    }
+  }
+
+  edge_iterator edge_end(GraphNode n) const {
+    if constexpr (InEdges) {
+      return graph->in_edge_end(n, MethodFlag::UNPROTECTED);
+    } else {
+      return graph->edge_end(n, MethodFlag::UNPROTECTED);
+    }
+  }
+
+  //! First unit of n, which stands for the node itself; its edges follow
+  uint64_t unitBegin(GraphNode n) const { return *edge_begin(n) + n; }
+  uint64_t unitEnd(GraphNode n) const { return *edge_end(n) + n + 1; }
+
+  uint64_t numBlocks() const { return (numUnits + blockSize - 1) / blockSize; }
+
+  bool isSplit(GraphNode n) const {
+    return unitEnd(n) - unitBegin(n) > blockSize;
+  }
+
+  //! Block that n begins in; unique among split nodes
+  uint64_t firstBlock(GraphNode n) const { return unitBegin(n) / blockSize; }
+
+  //! Number of blocks the units of n are cut into
+  uint64_t numSlices(GraphNode n) const {
+    return (unitEnd(n) - 1) / blockSize - firstBlock(n) + 1;
+  }
+
+  //! Node whose units include unit u
+  GraphNode nodeOf(uint64_t u) const {
+    uint64_t lo = 0;
+    uint64_t hi = numNodes - 1;
+    while (lo < hi) {
+      uint64_t mid = lo + (hi - lo) / 2;
+      if (unitEnd(mid) <= u) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  /**
+   * Calls fn(n, ii, ei, split) for the nodes of block k. Nodes that are not
+   * split are passed with all their edges. Split nodes are passed with the
+   * slice of their edges that falls in the block, which may be empty.
+   */
+  template <typename Fn>
+  void for_each_in_block(uint64_t k, Fn&& fn) const {
+    uint64_t beg = k * blockSize;
+    uint64_t end = std::min(beg + blockSize, numUnits);
+
+    GraphNode n = nodeOf(beg);
+    if (unitBegin(n) < beg) {
+      // the previous block processes n unless n is split
+      if (isSplit(n)) {
+        slice(n, beg, end, fn);
+      }
+      ++n;
+    }
+    for (; n < numNodes && unitBegin(n) < end; ++n) {
+      if (isSplit(n)) {
+        slice(n, beg, end, fn);
+      } else {
+        fn(n, edge_begin(n), edge_end(n), false);
+      }
+    }
+  }
+
+private:
+  template <typename Fn>
+  void slice(GraphNode n, uint64_t beg, uint64_t end, Fn& fn) const {
+    uint64_t first = unitBegin(n) + 1;
+    uint64_t ii    = std::max(beg, first);
+    uint64_t ei    = std::max(std::min(end, unitEnd(n)), ii);
+    edge_iterator base(edge_begin(n));
+    fn(n, base + (ii - first), base + (ei - first), true);
+  }
+};
+
 } // end namespace runtime
 
 namespace internal {
@@ -299,6 +443,21 @@ public:
   }
 };
 
+template <typename Graph, bool InEdges>
+class EdgeBalancedRangeMaker {
+  Graph& m_graph;
+  uint64_t m_blockSize;
+
+public:
+  EdgeBalancedRangeMaker(Graph& g, uint64_t blockSize)
+      : m_graph(g), m_blockSize(blockSize) {}
+
+  template <typename Arg>
+  auto operator()(const Arg&) const {
+    return runtime::EdgeBalancedRange<Graph, InEdges>(m_graph, m_blockSize);
+  }
+};
+
 template <typename C>
 class HasLocalIter {
 
@@ -335,5 +494,38 @@ auto iterate(const I& beg, const I& end) {
   return internal::IteratorRangeMaker<I, std::is_integral<I>::value>(beg, end);
 }
 
+/**
+ * Iterates over the nodes of a CSR graph in blocks of about blockSize edges,
+ * cutting the adjacency list of a node with more edges than that into several
+ * blocks. Only {@link do_all()} accepts this range. Its operator takes a node
+ * and a range of its edges, <code>fn(n, ii, ei)</code>, and is called more
+ * than once, possibly concurrently, for a split node. An operator that
+ * returns a value must come with a galois::edge_reduce trait, which combines
+ * the values of all the calls for a node and passes the result to a hook.
+ *
+ * \code
+ * galois::do_all(
+ *     galois::iterate_edges_balanced(graph),
+ *     [&](GNode n, auto ii, auto ei) {
+ *       float sum = 0;
+ *       for (; ii != ei; ++ii)
+ *         sum += contribution(graph.getEdgeDst(ii));
+ *       return sum;
+ *     },
+ *     galois::edge_reduce([&](GNode n, float sum) { rank[n] = f(sum); }),
+ *     galois::steal());
+ * \endcode
+ */
+template <typename Graph>
+auto iterate_edges_balanced(Graph& graph, uint64_t blockSize = 1024) {
+  return internal::EdgeBalancedRangeMaker<Graph, false>(graph, blockSize);
+}
+
+//! Like iterate_edges_balanced(), but over the in-edges of the graph
+template <typename Graph>
+auto iterate_in_edges_balanced(Graph& graph, uint64_t blockSize = 1024) {
+  return internal::EdgeBalancedRangeMaker<Graph, true>(graph, blockSize);
+}
+
 } // end namespace galois
 #endif
@@ -41,6 +41,7 @@ public:
   }
 
   ~SharedMem() {
+    reportThreadPoolStats();
     m_sm.print();
     internal::setSysStatManager(nullptr);
     internal::setPagePoolState(nullptr);
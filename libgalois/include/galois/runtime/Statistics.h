@@ -20,8 +20,10 @@
 #ifndef GALOIS_STAT_MANAGER_H
 #define GALOIS_STAT_MANAGER_H
 
+#include <algorithm>
 #include <limits>
 #include <map>
+#include <ostream>
 #include <string>
 #include <type_traits>
 
@@ -330,8 +332,31 @@ struct ScalarStat {
 template <typename T>
 using ScalarStatManager = BasicStatMap<ScalarStat<T>>;
 
+//! Thread ids of the values of a merged stat
+using ThreadIdStat = AggregStat<unsigned>::with_mem;
+
+void printJSONValue(std::ostream& out, int64_t v);
+void printJSONValue(std::ostream& out, double v);
+void printJSONValue(std::ostream& out, const gstl::Str& v);
+
+void printCSVField(std::ostream& out, int64_t v);
+void printCSVField(std::ostream& out, double v);
+void printCSVField(std::ostream& out, const gstl::Str& v);
+
 } // end namespace internal
 
+//! Output formats of StatManager
+enum class StatFormat {
+  //! one comma separated line per stat, with per-thread values on a second
+  //! line when PRINT_PER_THREAD_STATS is set (default)
+  TEXT,
+  //! a JSON document with run metadata and, for each stat, its total and
+  //! its per-thread values
+  JSON,
+  //! a CSV table (RFC 4180) with one row per stat and one column per thread
+  CSV
+};
+
 class StatManager {
 
 public:
@@ -360,6 +385,7 @@ private:
     substrate::PerThreadStorage<internal::ScalarStatManager<T>>
         perThreadManagers;
     MergedStats result;
+    internal::BasicStatMap<internal::ThreadIdStat> threadIds;
     bool merged = false;
 
     void addToStat(const Str& region, const Str& category, const T& val,
@@ -381,6 +407,7 @@ private:
              ++i) {
           result.addToStat(manager->region(i), manager->category(i),
                            T(manager->stat(i)), manager->stat(i).totalTy());
+          threadIds.addToStat(manager->region(i), manager->category(i), t);
         }
       }
 
@@ -400,6 +427,23 @@ private:
 
     const Stat& stat(const const_iterator& i) const { return result.stat(i); }
 
+    //! Ids of the threads that reported the values of stat(i), in order
+    const gstl::Vector<unsigned>& threads(const const_iterator& i) const {
+      return threadIds.getStat(region(i), category(i)).values();
+    }
+
+    //! One more than the largest id of a thread that reported a stat
+    unsigned numThreads(void) const {
+      unsigned n = 0;
+      for (auto i = threadIds.cbegin(), end_i = threadIds.cend(); i != end_i;
+           ++i) {
+        for (unsigned t : threadIds.stat(i).values()) {
+          n = std::max(n, t + 1);
+        }
+      }
+      return n;
+    }
+
     template <typename S, typename V>
     void readStat(const const_iterator& i, S& region, S& category, T& total,
                   StatTotal::Type& type, V& thrdVals) const {
@@ -440,6 +484,68 @@ private:
         }
       }
     }
+
+    void printJSON(std::ostream& out, const char*& sep) const {
+
+      for (auto i = cbegin(), end_i = cend(); i != end_i; ++i) {
+        const auto& s = this->stat(i);
+
+        out << sep << "\n    {\"kind\": ";
+        internal::printJSONValue(out, Str(statKind<T>()));
+        out << ", \"region\": ";
+        internal::printJSONValue(out, this->region(i));
+        out << ", \"category\": ";
+        internal::printJSONValue(out, this->category(i));
+        out << ", \"totalType\": ";
+        internal::printJSONValue(out, Str(StatTotal::str(s.totalTy())));
+        out << ", \"total\": ";
+        internal::printJSONValue(out, s.total());
+
+        out << ", \"threads\": [";
+        const char* vsep = "";
+        for (unsigned t : threads(i)) {
+          out << vsep << t;
+          vsep = ", ";
+        }
+        out << "], \"values\": [";
+        vsep = "";
+        for (const auto& v : s.values()) {
+          out << vsep;
+          internal::printJSONValue(out, v);
+          vsep = ", ";
+        }
+        out << "]}";
+
+        sep = ",";
+      }
+    }
+
+    void printCSV(std::ostream& out, unsigned numThreads) const {
+
+      for (auto i = cbegin(), end_i = cend(); i != end_i; ++i) {
+        const auto& s = this->stat(i);
+
+        out << statKind<T>() << ",";
+        internal::printCSVField(out, this->region(i));
+        out << ",";
+        internal::printCSVField(out, this->category(i));
+        out << "," << StatTotal::str(s.totalTy()) << ",";
+        internal::printCSVField(out, s.total());
+
+        const auto& tids = threads(i);
+        const auto& vals = s.values();
+        size_t k         = 0;
+        for (unsigned t = 0; t < numThreads; ++t) {
+          out << ",";
+          if (k < tids.size() && tids[k] == t) {
+            internal::printCSVField(out, vals[k]);
+            ++k;
+          }
+        }
+
+        out << "\r\n";
+      }
+    }
   };
 
   using IntStats     = StatManagerImpl<int64_t>;
@@ -450,6 +556,7 @@ private:
   using str_iterator = typename StrStats::const_iterator;
 
   std::string m_outfile;
+  StatFormat m_format;
   IntStats intStats;
   FPstats fpStats;
   StrStats strStats;
@@ -495,6 +602,10 @@ protected:
 
   void printHeader(std::ostream& out) const;
 
+  void printJSON(std::ostream& out) const;
+
+  void printCSV(std::ostream& out) const;
+
 public:
   explicit StatManager(const std::string& outfile = "");
 
@@ -502,6 +613,8 @@ public:
 
   void setStatFile(const std::string& outfile);
 
+  void setStatFormat(StatFormat format);
+
   template <typename S1, typename S2, typename T,
             typename = std::enable_if_t<std::is_integral<T>::value ||
                                         std::is_floating_point<T>::value>>
@@ -619,6 +732,9 @@ void reportParam(const S1& region, const S2& category, const V& value) {
 
 void setStatFile(const std::string& f);
 
+//! Selects the format in which stats are printed at the end of the run
+void setStatFormat(StatFormat format);
+
 //! Reports maximum resident set size and page faults stats using
 //! rusage
 //! @param id Identifier to prefix stat with in statistics output
@@ -629,6 +745,9 @@ void reportRUsage(const std::string& id);
 void reportPageAlloc(const char* category);
 //! Reports NUMA memory stats for all NUMA nodes
 void reportNumaAlloc(const char* category);
+//! Reports how often thread pool threads slept, and how long they spun and
+//! took to wake up in nanoseconds
+void reportThreadPoolStats();
 
 } // end namespace runtime
 } // end namespace galois
@@ -0,0 +1,146 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file EventTrace.h
+ *
+ * Low overhead tracing of runtime events.
+ *
+ * Each thread records fixed-size binary records into its own ring buffer,
+ * without locks or I/O. The buffers are written out once, at exit, in the
+ * Chrome trace event format (JSON), which chrome://tracing and the Perfetto
+ * UI can open.
+ *
+ * Tracing is compiled in only when GALOIS_ENABLE_EVENT_TRACE is defined
+ * (cmake -DGALOIS_ENABLE_EVENT_TRACE=ON); otherwise every tracing call is an
+ * empty inline function. At run time, the following environment variables
+ * apply:
+ *
+ *  - GALOIS_EVENT_TRACE: output file (default: galois-trace.PID.json)
+ *  - GALOIS_EVENT_TRACE_SIZE: records kept per thread, rounded up to a
+ *    power of two (default: 65536); older records are overwritten
+ */
+
+#ifndef GALOIS_SUBSTRATE_EVENTTRACE_H
+#define GALOIS_SUBSTRATE_EVENTTRACE_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "galois/config.h"
+
+namespace galois {
+namespace substrate {
+
+//! Kinds of traced events
+enum class TraceEvent : uint8_t {
+  LOOP_BEGIN,    //!< a thread starts its part of a parallel loop
+  LOOP_END,      //!< a thread finishes its part of a parallel loop
+  BARRIER_BEGIN, //!< a thread enters a barrier
+  BARRIER_END,   //!< a thread leaves a barrier
+  CHUNK_PUSH,    //!< a full chunk is published; arg is its size
+  CHUNK_POP,     //!< a chunk is taken from the local queue
+  CHUNK_STEAL,   //!< a chunk is taken from another queue; arg is its index
+  ABORT          //!< an iteration aborts on a conflict
+};
+
+#ifdef GALOIS_ENABLE_EVENT_TRACE
+
+namespace internal {
+
+struct TraceRecord {
+  //! nanoseconds of the steady clock
+  uint64_t time;
+  const char* name;
+  uint32_t arg;
+  TraceEvent event;
+};
+
+struct TraceBuffer;
+
+extern thread_local TraceBuffer* localTraceBuffer;
+
+//! Allocates and registers the buffer of the calling thread
+TraceBuffer* createTraceBuffer();
+
+//! Next record to fill in the buffer
+TraceRecord& nextTraceRecord(TraceBuffer* b);
+
+//! Returns a copy of name that lives until the trace is written
+const char* internTraceName(TraceBuffer* b, const char* name);
+
+} // namespace internal
+
+/**
+ * Records an event in the buffer of the calling thread.
+ *
+ * @param e event
+ * @param name loop name for LOOP_BEGIN and LOOP_END, otherwise ignored
+ * @param arg event argument
+ */
+inline void traceEvent(TraceEvent e, const char* name = nullptr,
+                       uint32_t arg = 0) {
+  internal::TraceBuffer* b = internal::localTraceBuffer;
+  if (!b)
+    b = internal::createTraceBuffer();
+  if (name)
+    name = internal::internTraceName(b, name);
+  internal::TraceRecord& r = internal::nextTraceRecord(b);
+  r.time  = std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+               .count();
+  r.name  = name;
+  r.arg   = arg;
+  r.event = e;
+}
+
+#else
+
+inline void traceEvent(TraceEvent, const char* = nullptr, uint32_t = 0) {}
+
+#endif
+
+/**
+ * Writes the events recorded so far to filename in Chrome trace event
+ * format. Called automatically at exit; does nothing when tracing is
+ * compiled out.
+ */
+void writeEventTrace(const std::string& filename);
+
+//! Traces the part of a parallel loop run by the calling thread
+class TraceLoop {
+#ifdef GALOIS_ENABLE_EVENT_TRACE
+  const char* name;
+
+public:
+  explicit TraceLoop(const char* n) : name(n) {
+    traceEvent(TraceEvent::LOOP_BEGIN, name);
+  }
+  ~TraceLoop() { traceEvent(TraceEvent::LOOP_END, name); }
+#else
+public:
+  explicit TraceLoop(const char*) {}
+#endif
+};
+
+} // end namespace substrate
+} // end namespace galois
+
+#endif
@@ -22,6 +22,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "galois/config.h"
@@ -50,6 +51,12 @@ template <typename RangeArrayTy>
 LAptr largeMallocSpecified(size_t bytes, uint32_t numThreads,
                            RangeArrayTy& threadRanges, size_t elementSize);
 
+// map a whole file without faulting it in and return its size in bytes;
+// shared mappings are read only, private mappings are copy-on-write
+LAptr largeMapFile(const std::string& filename, bool shared, size_t& bytes);
+// read ahead and fault in the pages of a file mapping from the calling thread
+void prefaultMapped(const void* ptr, size_t bytes);
+
 } // namespace substrate
 } // namespace galois
 
@@ -23,8 +23,10 @@
 #include <atomic>
 #include <cassert>
 #include <condition_variable>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -62,39 +64,41 @@ protected:
     std::function<void(void)> fn;
   }; //! type to switch to dedicated mode
 
-  //! Per-thread mailboxes for notification
+public:
+  //! How long threads waited for work, accumulated since the pool started
+  struct WaitStats {
+    //! Number of times the thread was woken up
+    uint64_t wakeups = 0;
+    //! Number of times the thread went to sleep after spinning
+    uint64_t parks = 0;
+    //! Nanoseconds spent spinning for work
+    uint64_t spinNs = 0;
+    //! Nanoseconds from wakeup() to the thread running, summed and maximum
+    uint64_t wakeLatencyNs    = 0;
+    uint64_t maxWakeLatencyNs = 0;
+  };
+
+protected:
+  //! Per-thread mailboxes for notification.
+  //!
+  //! A waiting thread spins on release for up to the spin budget of the pool
+  //! and then parks: it sleeps on a futex on Linux, and on a condition
+  //! variable elsewhere. In fastmode it spins without a budget.
   struct per_signal {
+    enum : uint32_t { IDLE = 0, RELEASED, PARKED };
+
     std::condition_variable cv;
     std::mutex m;
     unsigned wbegin, wend;
     std::atomic<int> done;
-    std::atomic<int> fastRelease;
+    std::atomic<uint32_t> release{IDLE};
+    //! steady clock time of the last wakeup() in nanoseconds
+    uint64_t wakeTime = 0;
     ThreadTopoInfo topo;
+    WaitStats stats;
 
-    void wakeup(bool fastmode) {
-      if (fastmode) {
-        done        = 0;
-        fastRelease = 1;
-      } else {
-        std::lock_guard<std::mutex> lg(m);
-        done = 0;
-        cv.notify_one();
-        // start.release();
-      }
-    }
-
-    void wait(bool fastmode) {
-      if (fastmode) {
-        while (!fastRelease.load(std::memory_order_relaxed)) {
-          asmPause();
-        }
-        fastRelease = 0;
-      } else {
-        std::unique_lock<std::mutex> lg(m);
-        cv.wait(lg, [=] { return !done; });
-        // start.acquire();
-      }
-    }
+    void wakeup();
+    void wait(bool fastmode, uint64_t spinBudgetNs);
   };
 
   thread_local static per_signal my_box;
@@ -105,6 +109,7 @@ protected:
   unsigned reserved;
   unsigned masterFastmode;
   bool running;
+  std::atomic<uint64_t> spinBudgetNs;
   std::function<void(void)> work;
 
   //! destroy all threads
@@ -117,7 +122,7 @@ protected:
   void threadLoop(unsigned tid);
 
   //! spin up for run
-  void cascade(bool fastmode);
+  void cascade();
 
   //! spin down after run
   void decascade();
@@ -169,6 +174,20 @@ public:
   // experimental: leave busy wait
   void beKind();
 
+  /**
+   * Sets how long idle threads spin for new work before they sleep. Spinning
+   * keeps the start of back-to-back parallel loops fast; sleeping frees the
+   * CPU between jobs. Defaults to the GALOIS_SPIN_BUDGET environment variable
+   * (in microseconds) or to 50us.
+   */
+  void setSpinBudget(uint64_t usec) { spinBudgetNs = usec * 1000; }
+  uint64_t getSpinBudget() const { return spinBudgetNs / 1000; }
+
+  //! Wait statistics of thread tid; read them while the pool is not running
+  const WaitStats& getWaitStats(unsigned tid) const {
+    return signals[tid]->stats;
+  }
+
   bool isRunning() const { return running; }
 
   //! return the number of non-reserved threads in the pool
@@ -200,6 +219,7 @@ public:
   unsigned getNumaNode(unsigned tid) const {
     return signals[tid]->topo.numaNode;
   }
+  unsigned getCore(unsigned tid) const { return signals[tid]->topo.core; }
 
   static unsigned getTID() { return my_box.topo.tid; }
   static bool isLeader() { return my_box.topo.tid == my_box.topo.socketLeader; }
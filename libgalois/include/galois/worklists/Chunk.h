@@ -20,9 +20,14 @@
 #ifndef GALOIS_WORKLIST_CHUNK_H
 #define GALOIS_WORKLIST_CHUNK_H
 
+#include <algorithm>
+#include <chrono>
+
 #include "galois/config.h"
 #include "galois/FixedSizeRing.h"
 #include "galois/runtime/Mem.h"
+#include "galois/runtime/Statistics.h"
+#include "galois/substrate/EventTrace.h"
 #include "galois/substrate/PaddedLock.h"
 #include "galois/worklists/WLCompileCheck.h"
 #include "galois/worklists/WorkListHelpers.h"
@@ -54,23 +59,38 @@ struct squeue<false, PS, TQ> {
   int size() { return 0; }
 };
 
-//! Common functionality to all chunked worklists
+/**
+ * Common functionality to all chunked worklists.
+ *
+ * In the adaptive mode, ChunkSize is only the capacity of a chunk. Each
+ * thread publishes its chunks once they reach a target size, which it doubles
+ * when its chunks are consumed faster than CHUNK_MIN_NS and halves when they
+ * take longer than CHUNK_MAX_NS or when it has to steal chunks from another
+ * queue.
+ */
 template <typename T, template <typename, bool> class QT, bool Distributed,
-          bool IsStack, int ChunkSize, bool Concurrent>
+          bool IsStack, int ChunkSize, bool Concurrent, bool Adaptive = false>
 struct ChunkMaster {
   template <typename _T>
-  using retype =
-      ChunkMaster<_T, QT, Distributed, IsStack, ChunkSize, Concurrent>;
+  using retype = ChunkMaster<_T, QT, Distributed, IsStack, ChunkSize,
+                             Concurrent, Adaptive>;
 
   template <int _chunk_size>
-  using with_chunk_size =
-      ChunkMaster<T, QT, Distributed, IsStack, _chunk_size, Concurrent>;
+  using with_chunk_size = ChunkMaster<T, QT, Distributed, IsStack, _chunk_size,
+                                      Concurrent, Adaptive>;
 
   template <bool _Concurrent>
-  using rethread =
-      ChunkMaster<T, QT, Distributed, IsStack, ChunkSize, _Concurrent>;
+  using rethread = ChunkMaster<T, QT, Distributed, IsStack, ChunkSize,
+                               _Concurrent, Adaptive>;
+
+  template <bool _adaptive>
+  using with_adaptive = ChunkMaster<T, QT, Distributed, IsStack, ChunkSize,
+                                    Concurrent, _adaptive>;
 
 private:
+  static constexpr uint64_t CHUNK_MIN_NS = 10000;
+  static constexpr uint64_t CHUNK_MAX_NS = 50000;
+
   class Chunk : public FixedSizeRing<T, ChunkSize>,
                 public QT<Chunk, Concurrent>::ListNode {};
 
@@ -79,7 +99,16 @@ private:
   struct p {
     Chunk* cur;
     Chunk* next;
-    p() : cur(0), next(0) {}
+    // adaptive mode
+    unsigned target;
+    bool busy;
+    std::chrono::steady_clock::time_point lastPop;
+    size_t chunks;
+    size_t items;
+    size_t steals;
+    p()
+        : cur(0), next(0), target(ChunkSize), busy(false), lastPop(),
+          chunks(0), items(0), steals(0) {}
   };
 
   typedef QT<Chunk, Concurrent> LevelItem;
@@ -99,6 +128,8 @@ private:
   }
 
   void pushChunk(Chunk* C) {
+    substrate::traceEvent(substrate::TraceEvent::CHUNK_PUSH, nullptr,
+                          C->size());
     LevelItem& I = Q.get();
     I.push(C);
   }
@@ -108,34 +139,81 @@ private:
     return I.pop();
   }
 
-  Chunk* popChunk() {
+  Chunk* popChunk(bool* stole = nullptr) {
     int id   = Q.myEffectiveID();
     Chunk* r = popChunkByID(id);
-    if (r)
+    if (r) {
+      substrate::traceEvent(substrate::TraceEvent::CHUNK_POP);
       return r;
+    }
 
     for (int i = id + 1; i < (int)Q.size(); ++i) {
       r = popChunkByID(i);
-      if (r)
+      if (r) {
+        substrate::traceEvent(substrate::TraceEvent::CHUNK_STEAL, nullptr, i);
+        if (stole)
+          *stole = true;
         return r;
+      }
     }
 
     for (int i = 0; i < id; ++i) {
       r = popChunkByID(i);
-      if (r)
+      if (r) {
+        substrate::traceEvent(substrate::TraceEvent::CHUNK_STEAL, nullptr, i);
+        if (stole)
+          *stole = true;
         return r;
+      }
     }
 
     return 0;
   }
 
+  void pushChunk(p& n, Chunk* C) {
+    if (Adaptive) {
+      ++n.chunks;
+      n.items += C->size();
+    }
+    pushChunk(C);
+  }
+
+  //! Pops the next chunk for this thread and adapts its target chunk size
+  Chunk* popChunk(p& n) {
+    if (!Adaptive)
+      return popChunk();
+
+    bool stole = false;
+    Chunk* r   = popChunk(&stole);
+    auto now   = std::chrono::steady_clock::now();
+    if (r) {
+      // the time since the last pop is the time spent on the last chunk,
+      // provided that pop returned one
+      uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        now - n.lastPop)
+                        .count();
+      if (stole) {
+        ++n.steals;
+        n.target = std::max(n.target / 2, 1U);
+      } else if (n.busy && ns > CHUNK_MAX_NS) {
+        n.target = std::max(n.target / 2, 1U);
+      } else if (n.busy && ns < CHUNK_MIN_NS) {
+        n.target = std::min(n.target * 2, unsigned(ChunkSize));
+      }
+    }
+    n.busy    = r != nullptr;
+    n.lastPop = now;
+    return r;
+  }
+
   template <typename... Args>
   T* emplacei(p& n, Args&&... args) {
     T* retval = 0;
-    if (n.next && (retval = n.next->emplace_back(std::forward<Args>(args)...)))
+    if (n.next && (!Adaptive || n.next->size() < n.target) &&
+        (retval = n.next->emplace_back(std::forward<Args>(args)...)))
       return retval;
     if (n.next)
-      pushChunk(n.next);
+      pushChunk(n, n.next);
     n.next = mkChunk();
     retval = n.next->emplace_back(std::forward<Args>(args)...);
     assert(retval);
@@ -152,10 +230,22 @@ public:
   void flush() {
     p& n = data.get();
     if (n.next)
-      pushChunk(n.next);
+      pushChunk(n, n.next);
     n.next = 0;
   }
 
+  //! Reports the chunk sizes this thread chose in the adaptive mode
+  void reportStats(const char* loopname) {
+    if (!Adaptive)
+      return;
+    p& n = data.get();
+    runtime::reportStat_Tsum(loopname, "Chunks", n.chunks);
+    runtime::reportStat_Tsum(loopname, "ChunkSteals", n.steals);
+    if (n.chunks > 0)
+      runtime::reportStat_Tavg(loopname, "ChunkSize", n.items / n.chunks);
+    n.chunks = n.items = n.steals = 0;
+  }
+
   /**
    * Construct an item on the worklist and return a pointer to its value.
    *
@@ -181,7 +271,7 @@ public:
         return &n.next->back();
       if (n.next)
         delChunk(n.next);
-      n.next = popChunk();
+      n.next = popChunk(n);
       if (n.next && !n.next->empty())
         return &n.next->back();
       return NULL;
@@ -190,7 +280,7 @@ public:
         return &n.cur->front();
       if (n.cur)
         delChunk(n.cur);
-      n.cur = popChunk();
+      n.cur = popChunk(n);
       if (!n.cur) {
         n.cur  = n.next;
         n.next = 0;
@@ -243,7 +333,7 @@ public:
         return retval;
       if (n.next)
         delChunk(n.next);
-      n.next = popChunk();
+      n.next = popChunk(n);
       if (n.next)
         return n.next->extract_back();
       return galois::optional<value_type>();
@@ -252,7 +342,7 @@ public:
         return retval;
       if (n.cur)
         delChunk(n.cur);
-      n.cur = popChunk();
+      n.cur = popChunk(n);
       if (!n.cur) {
         n.cur  = n.next;
         n.next = 0;
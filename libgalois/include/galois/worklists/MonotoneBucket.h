@@ -0,0 +1,219 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_WORKLIST_MONOTONEBUCKET_H
+#define GALOIS_WORKLIST_MONOTONEBUCKET_H
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "galois/config.h"
+#include "galois/optional.h"
+#include "galois/substrate/PerThreadStorage.h"
+#include "galois/worklists/Chunk.h"
+#include "galois/worklists/WorkListHelpers.h"
+
+namespace galois {
+namespace worklists {
+
+/**
+ * Priority scheduling for integer priorities that (mostly) do not decrease,
+ * such as the buckets of delta-stepping or the levels of a BFS.
+ *
+ * Instead of the ordered map of OrderedByIntegerMetric, the buckets for the
+ * priorities [cur, cur + NumBuckets) live in a circular array indexed
+ * directly by priority. Threads take work from bucket cur, stealing chunks
+ * from each other through the bucket container. A thread that finds bucket
+ * cur empty scans ahead and moves cur to the first bucket in which it finds
+ * work; cur never moves backwards. Work pushed at a priority below cur goes
+ * to bucket cur, and work beyond the window goes to an overflow container
+ * that is re-bucketed once the window runs dry.
+ *
+ * Because cur only advances lazily and some of a bucket may still sit in
+ * other threads' chunks when it does, the order is approximate like that of
+ * OrderedByIntegerMetric; no item is ever lost.
+ *
+ * The Indexer interface is the same as that of OrderedByIntegerMetric:
+ * \code
+ * struct Indexer {
+ *   unsigned operator()(const Item& i) const { return i.dist >> shift; }
+ * };
+ *
+ * typedef galois::worklists::MonotoneBucketWL<Indexer> WL;
+ * galois::for_each(galois::iterate(items), Fn, galois::wl<WL>());
+ * \endcode
+ *
+ * @tparam Indexer    Indexer class; must return an integral priority
+ * @tparam Container  Scheduler for each bucket
+ * @tparam NumBuckets Size of the window of priorities; a power of two
+ */
+template <class Indexer      = DummyIndexer<int>,
+          typename Container = PerSocketChunkFIFO<>,
+          unsigned NumBuckets = 256, typename T = int, typename Index = int,
+          bool Concurrent = true>
+struct MonotoneBucketWL : private boost::noncopyable {
+  static_assert(std::is_integral<Index>::value,
+                "only integral priorities supported");
+  static_assert(NumBuckets && !(NumBuckets & (NumBuckets - 1)),
+                "NumBuckets must be a power of two");
+
+  template <typename _T>
+  using retype =
+      MonotoneBucketWL<Indexer, typename Container::template retype<_T>,
+                       NumBuckets, _T,
+                       typename std::result_of<Indexer(_T)>::type, Concurrent>;
+
+  template <bool _b>
+  using rethread =
+      MonotoneBucketWL<Indexer, Container, NumBuckets, T, Index, _b>;
+
+  template <typename _container>
+  struct with_container {
+    typedef MonotoneBucketWL<Indexer, _container, NumBuckets, T, Index,
+                             Concurrent>
+        type;
+  };
+
+  template <typename _indexer>
+  struct with_indexer {
+    typedef MonotoneBucketWL<_indexer, Container, NumBuckets, T, Index,
+                             Concurrent>
+        type;
+  };
+
+  template <unsigned _num_buckets>
+  struct with_num_buckets {
+    typedef MonotoneBucketWL<Indexer, Container, _num_buckets, T, Index,
+                             Concurrent>
+        type;
+  };
+
+  typedef T value_type;
+  typedef Index index_type;
+
+private:
+  typedef typename Container::template rethread<Concurrent> CTy;
+  typedef typename std::make_unsigned<Index>::type UIndex;
+
+  std::unique_ptr<CTy[]> buckets;
+  CTy overflow;
+  //! earliest priority of the window
+  std::atomic<Index> cur;
+  Indexer indexer;
+  substrate::PerThreadStorage<std::vector<T>> spill;
+
+  CTy& bucket(Index i) { return buckets[UIndex(i) & (NumBuckets - 1)]; }
+
+  //! Moves cur forward to i unless another thread moved it further
+  void advance(Index i) {
+    Index c = cur.load(std::memory_order_relaxed);
+    while (c < i && !cur.compare_exchange_weak(c, i, std::memory_order_relaxed))
+      ;
+  }
+
+  /**
+   * Moves the overflow items this thread can see into the window after
+   * advancing the window to the earliest of them. Returns false if there
+   * were none.
+   */
+  bool refill() {
+    std::vector<T>& items = *spill.getLocal();
+    galois::optional<T> item;
+    while ((item = overflow.pop()))
+      items.push_back(*item);
+    if (items.empty())
+      return false;
+
+    Index earliest = indexer(items.front());
+    for (auto& x : items) {
+      Index i = indexer(x);
+      if (i < earliest)
+        earliest = i;
+    }
+    advance(earliest);
+    for (auto& x : items)
+      push(x);
+    items.clear();
+    return true;
+  }
+
+  GALOIS_ATTRIBUTE_NOINLINE
+  galois::optional<T> slowPop() {
+    // A failed pop must have looked at everything this thread may hold in
+    // its own chunks: the whole window and the overflow
+    do {
+      Index c = cur.load(std::memory_order_relaxed);
+      for (unsigned k = 0; k < NumBuckets; ++k) {
+        galois::optional<T> item;
+        if ((item = bucket(c + k).pop())) {
+          if (k)
+            advance(c + k);
+          return item;
+        }
+      }
+    } while (refill());
+    return galois::optional<T>();
+  }
+
+public:
+  MonotoneBucketWL(const Indexer& x = Indexer())
+      : buckets(new CTy[NumBuckets]),
+        cur(std::numeric_limits<Index>::min()), indexer(x) {}
+
+  void push(const value_type& val) {
+    Index i = indexer(val);
+    Index c = cur.load(std::memory_order_relaxed);
+    if (i < c) {
+      // late work for a bucket already passed
+      bucket(c).push(val);
+    } else if (UIndex(i) - UIndex(c) < NumBuckets) {
+      bucket(i).push(val);
+    } else {
+      overflow.push(val);
+    }
+  }
+
+  template <typename Iter>
+  void push(Iter b, Iter e) {
+    while (b != e)
+      push(*b++);
+  }
+
+  template <typename RangeTy>
+  void push_initial(const RangeTy& range) {
+    auto rp = range.local_pair();
+    push(rp.first, rp.second);
+  }
+
+  galois::optional<value_type> pop() {
+    galois::optional<value_type> item;
+    if ((item = bucket(cur.load(std::memory_order_relaxed)).pop()))
+      return item;
+    return slowPop();
+  }
+};
+GALOIS_WLCOMPILECHECK(MonotoneBucketWL)
+
+} // end namespace worklists
+} // end namespace galois
+
+#endif
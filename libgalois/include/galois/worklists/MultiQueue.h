@@ -0,0 +1,199 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_WORKLIST_MULTIQUEUE_H
+#define GALOIS_WORKLIST_MULTIQUEUE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "galois/config.h"
+#include "galois/optional.h"
+#include "galois/runtime/Substrate.h"
+#include "galois/substrate/CacheLineStorage.h"
+#include "galois/substrate/PerThreadStorage.h"
+#include "galois/substrate/SimpleLock.h"
+#include "galois/worklists/WLCompileCheck.h"
+
+namespace galois {
+namespace worklists {
+
+/**
+ * Relaxed concurrent priority queue for arbitrary priorities (MultiQueue,
+ * Rihani, Sanders and Dementiev, 2015).
+ *
+ * Items are kept in QueuesPerThread * activeThreads binary heaps, each with
+ * its own lock. A push goes to a random heap that can be locked without
+ * waiting. A pop locks two random heaps and takes the earlier of their two
+ * earliest items, so it returns one of the earliest items of the whole
+ * worklist with high probability without any global synchronization. If the
+ * random choices keep turning up empty heaps, every heap is checked before
+ * pop reports that the worklist is empty.
+ *
+ * Items are ordered by Compare like in OrderedList: pop favors items that
+ * compare less than others. An example:
+ * \code
+ * struct Earlier {
+ *   bool operator()(const Req& a, const Req& b) const {
+ *     return a.dist < b.dist;
+ *   }
+ * };
+ *
+ * typedef galois::worklists::MultiQueue<Earlier, Req> WL;
+ * galois::for_each(galois::iterate(items), Fn, galois::wl<WL>());
+ * \endcode
+ *
+ * @tparam Compare         Strict weak order on items
+ * @tparam QueuesPerThread Number of heaps per active thread
+ */
+template <class Compare = std::less<int>, typename T = int,
+          unsigned QueuesPerThread = 2, bool Concurrent = true>
+class MultiQueue : private boost::noncopyable {
+  static_assert(QueuesPerThread > 0, "need at least one queue per thread");
+
+  struct Queue {
+    substrate::CondLock<Concurrent> lock;
+    std::vector<T> heap;
+  };
+
+  //! Random pairs to try before checking every heap in pop
+  static constexpr unsigned popAttempts = 8;
+
+  std::vector<substrate::CacheLineStorage<Queue>> queues;
+  substrate::PerThreadStorage<uint64_t> seeds;
+  Compare compare;
+
+  //! Heap order: the top of a heap is its earliest item
+  bool later(const T& a, const T& b) const { return compare(b, a); }
+
+  Queue& pick() {
+    // xorshift64
+    uint64_t& x = *seeds.getLocal();
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return queues[x % queues.size()].get();
+  }
+
+  void pushTo(Queue& q, const T& val) {
+    q.heap.push_back(val);
+    std::push_heap(q.heap.begin(), q.heap.end(),
+                   [this](const T& a, const T& b) { return later(a, b); });
+  }
+
+  galois::optional<T> popFrom(Queue& q) {
+    if (q.heap.empty())
+      return galois::optional<T>();
+    std::pop_heap(q.heap.begin(), q.heap.end(),
+                  [this](const T& a, const T& b) { return later(a, b); });
+    galois::optional<T> item(q.heap.back());
+    q.heap.pop_back();
+    return item;
+  }
+
+  GALOIS_ATTRIBUTE_NOINLINE
+  galois::optional<T> popAny() {
+    galois::optional<T> item;
+    for (auto& pq : queues) {
+      Queue& q = pq.get();
+      q.lock.lock();
+      item = popFrom(q);
+      q.lock.unlock();
+      if (item)
+        break;
+    }
+    return item;
+  }
+
+public:
+  template <typename _T>
+  using retype = MultiQueue<Compare, _T, QueuesPerThread, Concurrent>;
+
+  template <bool _b>
+  using rethread = MultiQueue<Compare, T, QueuesPerThread, _b>;
+
+  template <unsigned _queues>
+  struct with_queues_per_thread {
+    typedef MultiQueue<Compare, T, _queues, Concurrent> type;
+  };
+
+  typedef T value_type;
+
+  MultiQueue(const Compare& c = Compare())
+      : queues(Concurrent ? QueuesPerThread * runtime::activeThreads : 1),
+        compare(c) {
+    for (unsigned i = 0; i < seeds.size(); ++i)
+      *seeds.getRemote(i) = UINT64_C(0x9E3779B97F4A7C15) * (i + 1);
+  }
+
+  void push(const value_type& val) {
+    for (;;) {
+      Queue& q = pick();
+      if (q.lock.try_lock()) {
+        pushTo(q, val);
+        q.lock.unlock();
+        return;
+      }
+    }
+  }
+
+  template <typename Iter>
+  void push(Iter b, Iter e) {
+    while (b != e)
+      push(*b++);
+  }
+
+  template <typename RangeTy>
+  void push_initial(const RangeTy& range) {
+    auto rp = range.local_pair();
+    push(rp.first, rp.second);
+  }
+
+  galois::optional<value_type> pop() {
+    galois::optional<value_type> item;
+    for (unsigned i = 0; i < popAttempts; ++i) {
+      Queue& a = pick();
+      Queue& b = pick();
+      if (!a.lock.try_lock())
+        continue;
+      if (&a != &b && b.lock.try_lock()) {
+        Queue* q = &a;
+        if (a.heap.empty() ||
+            (!b.heap.empty() && later(a.heap.front(), b.heap.front())))
+          q = &b;
+        item = popFrom(*q);
+        b.lock.unlock();
+      } else {
+        item = popFrom(a);
+      }
+      a.lock.unlock();
+      if (item)
+        return item;
+    }
+    return popAny();
+  }
+};
+GALOIS_WLCOMPILECHECK(MultiQueue)
+
+} // end namespace worklists
+} // end namespace galois
+
+#endif
@@ -20,9 +20,13 @@
 #ifndef GALOIS_WORKLIST_OBIM_H
 #define GALOIS_WORKLIST_OBIM_H
 
+#include <algorithm>
+#include <atomic>
 #include <deque>
 #include <limits>
+#include <mutex>
 #include <type_traits>
+#include <vector>
 
 #include "galois/FlatMap.h"
 #include "galois/runtime/Substrate.h"
@@ -119,6 +123,11 @@ struct OrderedByIntegerMetricComparator<Index, true> {
  * <code>operator==</code> and item is an element from the Galois set
  * iterator.
  *
+ * Buckets that are found empty before the first bucket with work are retired
+ * and their containers reused for later priorities, so memory and scan cost
+ * follow the range of priorities with pending work rather than every priority
+ * seen so far.
+ *
  * An example:
  * \code
  * struct Item { int index; };
@@ -232,6 +241,33 @@ private:
       Comparator;
   typedef typename Comparator::template with_local_map<CTy*>::type LMapTy;
 
+  //! Buckets that appear empty are retired once a thread scans past this
+  //! many of them
+  static constexpr size_t retireWindow = 32;
+
+  struct LogEntry {
+    Index index;
+    CTy* container;
+    //! true if the bucket was retired, false if it was created
+    bool retire;
+  };
+
+  struct Bucket : public CTy {
+    //! version of the log entry that created the bucket
+    unsigned int created;
+  };
+
+  //! Segment of the master log; freed once every thread has replayed it
+  struct LogBlock {
+    static constexpr unsigned int size = 256;
+    LogEntry entries[size];
+    LogBlock* next;
+    //! version of entries[0]
+    unsigned int base;
+
+    explicit LogBlock(unsigned int b) : next(nullptr), base(b) {}
+  };
+
   struct ThreadData
       : public internal::OrderedByIntegerMetricData<T, Index,
                                                     UseBarrier>::ThreadData {
@@ -239,43 +275,191 @@ private:
     Index curIndex;
     Index scanStart;
     CTy* current;
-    unsigned int lastMasterVersion;
+    //! log block holding entry lastMasterVersion
+    LogBlock* logBlock;
+    //! true once the thread has copied the master map; set under masterLock
+    bool joined;
+    std::atomic<unsigned int> lastMasterVersion;
     unsigned int numPops;
+    //! local map size at which to next look for buckets to retire
+    size_t retireMark;
+    //! items recovered from buckets retired by other threads
+    std::vector<T> drained;
+    std::vector<std::pair<Index, CTy*>> retireCandidates;
 
     ThreadData(Index initial)
-        : curIndex(initial), scanStart(initial), current(0),
-          lastMasterVersion(0), numPops(0) {}
+        : curIndex(initial), scanStart(initial), current(0), logBlock(0),
+          joined(false), lastMasterVersion(0), numPops(0),
+          retireMark(retireWindow) {}
   };
 
-  typedef std::deque<std::pair<Index, CTy*>> MasterLog;
-
-  // NB: Place dynamically growing masterLog after fixed-size PerThreadStorage
-  // members to give higher likelihood of reclaiming PerThreadStorage
+  // NB: Place dynamically growing master state after fixed-size
+  // PerThreadStorage members to give higher likelihood of reclaiming
+  // PerThreadStorage
   substrate::PerThreadStorage<ThreadData> data;
   substrate::PaddedLock<Concurrent> masterLock;
-  MasterLog masterLog;
+  //! live buckets; protected by masterLock
+  LMapTy masterMap;
+  //! oldest log block that some thread may still read
+  LogBlock* logHead;
+  LogBlock* logTail;
+  //! retired buckets and the version of their retire entry
+  std::vector<std::pair<unsigned int, Bucket*>> retired;
+  //! size of retired at which reclaim looks at it again
+  size_t reclaimMark;
+  //! empty buckets no thread refers to anymore
+  std::vector<Bucket*> freeList;
+  //! every bucket ever allocated
+  std::vector<Bucket*> containers;
+  std::vector<unsigned int> versions;
 
   std::atomic<unsigned int> masterVersion;
   Indexer indexer;
 
+  //! Appends an entry to the master log; masterLock must be held
+  void appendLog(Index i, CTy* C, bool retire) {
+    unsigned int v = masterVersion.load(std::memory_order_relaxed);
+    if (v - logTail->base == LogBlock::size) {
+      trimLog();
+      logTail->next = new LogBlock(v);
+      logTail       = logTail->next;
+    }
+    logTail->entries[v - logTail->base] = LogEntry{i, C, retire};
+    if (retire) {
+      masterMap.erase(i);
+      retired.emplace_back(v, static_cast<Bucket*>(C));
+    } else {
+      masterMap[i]                      = C;
+      static_cast<Bucket*>(C)->created = v;
+    }
+    masterVersion.store(v + 1, std::memory_order_release);
+  }
+
+  //! Collects the log versions of the threads using the worklist
+  void readVersions() {
+    versions.clear();
+    for (unsigned i = 0; i < data.size(); ++i) {
+      ThreadData& o = *data.getRemote(i);
+      if (o.joined)
+        versions.push_back(
+            o.lastMasterVersion.load(std::memory_order_acquire));
+    }
+  }
+
+  //! Frees the log blocks that every thread has replayed; masterLock must be
+  //! held
+  void trimLog() {
+    readVersions();
+    unsigned int minVersion = masterVersion.load(std::memory_order_relaxed);
+    for (unsigned int v : versions)
+      minVersion = std::min(minVersion, v);
+    // A thread at version base + size may still point to the block it
+    // finished; it moves on when it reads the next entry
+    while (logHead != logTail && logHead->base + LogBlock::size < minVersion) {
+      LogBlock* next = logHead->next;
+      delete logHead;
+      logHead = next;
+    }
+  }
+
+  //! Moves retired buckets that every thread has forgotten to the free list;
+  //! masterLock must be held
+  void reclaim() {
+    readVersions();
+
+    // A thread may still refer to a bucket if it has replayed its creation
+    // but not its retirement. Buckets that came and went while a thread was
+    // busy elsewhere do not have to wait for it.
+    auto inUse = [&](const std::pair<unsigned int, Bucket*>& r) {
+      for (unsigned int v : versions) {
+        if (r.second->created < v && v <= r.first)
+          return true;
+      }
+      return false;
+    };
+    auto ii = std::partition(retired.begin(), retired.end(), inUse);
+    for (auto jj = ii; jj != retired.end(); ++jj)
+      freeList.push_back(jj->second);
+    retired.erase(ii, retired.end());
+    reclaimMark = retired.size() + retireWindow;
+  }
+
+  //! Starts replaying the log from the current state of the master map
+  GALOIS_ATTRIBUTE_NOINLINE
+  void join(ThreadData& p) {
+    masterLock.lock();
+    p.local = masterMap;
+    p.lastMasterVersion.store(masterVersion.load(std::memory_order_relaxed),
+                              std::memory_order_relaxed);
+    p.logBlock = logTail;
+    p.joined   = true;
+    masterLock.unlock();
+  }
+
+  void retireLocal(ThreadData& p, const LogEntry& e) {
+    auto it = p.local.find(e.index);
+    if (it != p.local.end() && it->second == e.container)
+      p.local.erase(it);
+    if (p.current == e.container)
+      p.current = nullptr;
+    // Items this thread pushed before it saw the retirement may still be in
+    // its part of the bucket
+    galois::optional<T> item;
+    while ((item = e.container->pop()))
+      p.drained.push_back(*item);
+  }
+
   bool updateLocal(ThreadData& p) {
-    if (p.lastMasterVersion != masterVersion.load(std::memory_order_relaxed)) {
-      for (;
-           p.lastMasterVersion < masterVersion.load(std::memory_order_relaxed);
-           ++p.lastMasterVersion) {
-        // XXX(ddn): Somehow the second block is better than
-        // the first for bipartite matching (GCC 4.7.2)
-#if 0
-        p.local.insert(masterLog[p.lastMasterVersion]);
-#else
-        std::pair<Index, CTy*> logEntry = masterLog[p.lastMasterVersion];
-        p.local[logEntry.first]         = logEntry.second;
-        assert(logEntry.second);
-#endif
+    assert(p.joined);
+    unsigned int v    = masterVersion.load(std::memory_order_acquire);
+    unsigned int last = p.lastMasterVersion.load(std::memory_order_relaxed);
+    if (last == v)
+      return false;
+    for (; last < v; ++last) {
+      if (last - p.logBlock->base == LogBlock::size)
+        p.logBlock = p.logBlock->next;
+      const LogEntry& e = p.logBlock->entries[last - p.logBlock->base];
+      assert(e.container);
+      if (e.retire)
+        retireLocal(p, e);
+      else
+        p.local[e.index] = e.container;
+    }
+    p.lastMasterVersion.store(last, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Retires the buckets of the local map that are earlier than the first
+   * bucket with work, so that memory and scan cost track the active range of
+   * priorities. Returns an item if a bucket with work was found.
+   */
+  GALOIS_ATTRIBUTE_NOINLINE
+  galois::optional<T> retireBuckets(ThreadData& p) {
+    galois::optional<T> item;
+    p.retireCandidates.clear();
+    for (auto ii = p.local.begin(), ei = p.local.end(); ii != ei; ++ii) {
+      if ((item = ii->second->pop())) {
+        p.current   = ii->second;
+        p.curIndex  = ii->first;
+        p.scanStart = ii->first;
+        break;
       }
-      return true;
+      p.retireCandidates.push_back(*ii);
     }
-    return false;
+
+    if (!p.retireCandidates.empty() && masterLock.try_lock()) {
+      for (auto& c : p.retireCandidates) {
+        auto it = masterMap.find(c.first);
+        if (it != masterMap.end() && it->second == c.second)
+          appendLog(c.first, c.second, true);
+      }
+      updateLocal(p);
+      masterLock.unlock();
+    }
+
+    p.retireMark = p.local.size() + retireWindow;
+    return item;
   }
 
   GALOIS_ATTRIBUTE_NOINLINE
@@ -283,8 +467,22 @@ private:
     bool localLeader = substrate::ThreadPool::isLeader();
     Index msS        = this->earliest;
 
+    if (!p.joined)
+      join(p);
     updateLocal(p);
 
+    if (!UseBarrier && p.local.size() >= p.retireMark) {
+      galois::optional<T> item = retireBuckets(p);
+      if (item)
+        return item;
+    }
+
+    if (!p.drained.empty()) {
+      galois::optional<T> item(p.drained.back());
+      p.drained.pop_back();
+      return item;
+    }
+
     if (BSP && !UseMonotonic) {
       msS = p.scanStart;
       if (localLeader) {
@@ -300,22 +498,29 @@ private:
       }
     }
 
+    size_t skipped = 0;
     for (auto ii = p.local.lower_bound(msS), ei = p.local.end(); ii != ei;
-         ++ii) {
+         ++ii, ++skipped) {
       galois::optional<T> item;
       if ((item = ii->second->pop())) {
         p.current   = ii->second;
         p.curIndex  = ii->first;
         p.scanStart = ii->first;
+        if (skipped >= retireWindow)
+          p.retireMark = 0;
         return item;
       }
     }
+    if (skipped >= retireWindow)
+      p.retireMark = 0;
 
     return galois::optional<value_type>();
   }
 
   GALOIS_ATTRIBUTE_NOINLINE
   CTy* slowUpdateLocalOrCreate(ThreadData& p, Index i) {
+    if (!p.joined)
+      join(p);
     // update local until we find it or we get the write lock
     do {
       updateLocal(p);
@@ -323,17 +528,23 @@ private:
       if (it != p.local.end())
         return it->second;
     } while (!masterLock.try_lock());
-    // we have the write lock, update again then create
-    updateLocal(p);
-    auto it = p.local.find(i);
-    CTy* C2 = (it != p.local.end()) ? it->second : nullptr;
+    // we have the write lock, find or create the bucket and then catch up
+    // with the log while no one can retire it
+    auto it = masterMap.find(i);
+    CTy* C2 = (it != masterMap.end()) ? it->second : nullptr;
     if (!C2) {
-      C2                  = new CTy();
-      p.local[i]          = C2;
-      p.lastMasterVersion = masterVersion.load(std::memory_order_relaxed) + 1;
-      masterLog.push_back(std::make_pair(i, C2));
-      masterVersion.fetch_add(1);
+      if (freeList.empty() && retired.size() >= reclaimMark)
+        reclaim();
+      if (!freeList.empty()) {
+        C2 = freeList.back();
+        freeList.pop_back();
+      } else {
+        containers.push_back(new Bucket());
+        C2 = containers.back();
+      }
+      appendLog(i, C2, false);
     }
+    updateLocal(p);
     masterLock.unlock();
     return C2;
   }
@@ -350,16 +561,29 @@ private:
 
 public:
   OrderedByIntegerMetric(const Indexer& x = Indexer())
-      : data(this->earliest), masterVersion(0), indexer(x) {}
+      : data(this->earliest), logHead(new LogBlock(0)), logTail(logHead),
+        reclaimMark(0), masterVersion(0), indexer(x) {}
 
   ~OrderedByIntegerMetric() {
     // Deallocate in LIFO order to give opportunity for simple garbage
     // collection
-    for (auto ii = masterLog.rbegin(), ei = masterLog.rend(); ii != ei; ++ii) {
-      delete ii->second;
+    for (auto ii = containers.rbegin(), ei = containers.rend(); ii != ei;
+         ++ii) {
+      delete *ii;
+    }
+    while (logHead) {
+      LogBlock* next = logHead->next;
+      delete logHead;
+      logHead = next;
     }
   }
 
+  //! Number of buckets currently allocated, live or awaiting reuse
+  size_t numBuckets() {
+    std::lock_guard<substrate::PaddedLock<Concurrent>> lg(masterLock);
+    return containers.size();
+  }
+
   void push(const value_type& val) {
     Index index   = indexer(val);
     ThreadData& p = *data.getLocal();
@@ -0,0 +1,235 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_WORKLIST_STEALINGDEQUE_H
+#define GALOIS_WORKLIST_STEALINGDEQUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "galois/config.h"
+#include "galois/optional.h"
+#include "galois/runtime/Substrate.h"
+#include "galois/substrate/CacheLineStorage.h"
+#include "galois/substrate/PerThreadStorage.h"
+#include "galois/substrate/SimpleLock.h"
+#include "galois/substrate/ThreadPool.h"
+#include "galois/worklists/WLCompileCheck.h"
+
+namespace galois {
+namespace worklists {
+
+/**
+ * Per-thread work-stealing deques with topology-aware victim selection.
+ *
+ * Each thread pushes and pops items at the bottom of its own deque (LIFO),
+ * so recursive divide-and-conquer operators run depth first on data that is
+ * still in cache. A thread whose deque is empty steals the oldest item, which
+ * for such operators is also the largest piece of work, from another thread:
+ * first from the SMT siblings on its own core, then from the other threads
+ * of its socket, then from other sockets, nearest socket id first. Within a
+ * level, thieves start at rotating positions so they do not converge on the
+ * same victim.
+ *
+ * The deques follow the THE protocol of Cilk-5 (Frigo, Leiserson and
+ * Randall, 1998): the owner pushes and pops without locks or atomic
+ * read-modify-write operations and only takes the deque lock when it races
+ * with a thief for the last item; thieves serialize on the lock. Unlike a
+ * Chase-Lev deque, a thief copies its item while holding the lock, so items
+ * need not be trivially copyable (e.g., std::pair ranges of ParallelSTL::sort).
+ *
+ * \code
+ * galois::for_each(galois::iterate(roots), Fn,
+ *                  galois::wl<galois::worklists::StealingDeque<>>());
+ * \endcode
+ */
+template <typename T = int, bool Concurrent = true>
+class StealingDeque : private boost::noncopyable {
+
+  struct Deque {
+    //! Next item to steal; written only while holding lock
+    substrate::CacheLineStorage<std::atomic<int64_t>> top;
+    //! One past the newest item; written only by the owner
+    std::atomic<int64_t> bottom;
+    substrate::CondLock<Concurrent> lock;
+    //! Reallocated only while holding lock
+    std::vector<T> items;
+
+    //! Threads to steal from, grouped by level (core, socket, machine)
+    std::vector<unsigned> victims;
+    unsigned levelEnd[3];
+    unsigned cursor;
+
+    Deque() : bottom(0), levelEnd(), cursor(0) { top.get() = 0; }
+  };
+
+  static constexpr size_t initialCapacity = 64;
+
+  substrate::PerThreadStorage<Deque> deques;
+
+  //! Makes room for one more item at the bottom of the owner's deque
+  GALOIS_ATTRIBUTE_NOINLINE void grow(Deque& d) {
+    std::lock_guard<substrate::CondLock<Concurrent>> lg(d.lock);
+    int64_t t = d.top.get().load(std::memory_order_relaxed);
+    int64_t b = d.bottom.load(std::memory_order_relaxed);
+    size_t n  = b - t;
+    if (d.items.empty() || 2 * n > d.items.size()) {
+      std::vector<T> larger(std::max(2 * d.items.size(), initialCapacity));
+      std::move(d.items.begin() + t, d.items.begin() + b, larger.begin());
+      d.items.swap(larger);
+    } else {
+      std::move(d.items.begin() + t, d.items.begin() + b, d.items.begin());
+    }
+    d.top.get().store(0, std::memory_order_relaxed);
+    d.bottom.store(n, std::memory_order_relaxed);
+  }
+
+  void pushLocal(Deque& d, const T& val) {
+    int64_t b = d.bottom.load(std::memory_order_relaxed);
+    if (b == (int64_t)d.items.size()) {
+      grow(d);
+      b = d.bottom.load(std::memory_order_relaxed);
+    }
+    d.items[b] = val;
+    d.bottom.store(b + 1, std::memory_order_release);
+  }
+
+  galois::optional<T> popLocal(Deque& d) {
+    // a thief raises top past bottom only while failing on an empty deque
+    if (d.top.get().load(std::memory_order_relaxed) >=
+        d.bottom.load(std::memory_order_relaxed))
+      return galois::optional<T>();
+
+    int64_t b = d.bottom.load(std::memory_order_relaxed) - 1;
+    d.bottom.store(b, std::memory_order_seq_cst);
+    int64_t t = d.top.get().load(std::memory_order_seq_cst);
+    if (t > b) {
+      // a thief is taking the last item; settle it under the lock
+      std::lock_guard<substrate::CondLock<Concurrent>> lg(d.lock);
+      t = d.top.get().load(std::memory_order_relaxed);
+      if (t > b) {
+        // restart from the beginning of the items
+        d.top.get().store(0, std::memory_order_relaxed);
+        d.bottom.store(0, std::memory_order_relaxed);
+        return galois::optional<T>();
+      }
+    }
+    return galois::optional<T>(d.items[b]);
+  }
+
+  galois::optional<T> stealFrom(Deque& v) {
+    if (!v.lock.try_lock())
+      return galois::optional<T>();
+    galois::optional<T> item;
+    int64_t t = v.top.get().load(std::memory_order_relaxed);
+    v.top.get().store(t + 1, std::memory_order_seq_cst);
+    int64_t b = v.bottom.load(std::memory_order_seq_cst);
+    if (t < b)
+      item = v.items[t];
+    else
+      v.top.get().store(t, std::memory_order_relaxed);
+    v.lock.unlock();
+    return item;
+  }
+
+  GALOIS_ATTRIBUTE_NOINLINE galois::optional<T> steal(Deque& d) {
+    galois::optional<T> item;
+    unsigned begin = 0;
+    for (unsigned end : d.levelEnd) {
+      unsigned n = end - begin;
+      for (unsigned i = 0; i < n; ++i) {
+        unsigned victim = d.victims[begin + (d.cursor + i) % n];
+        item            = stealFrom(*deques.getRemote(victim));
+        if (item) {
+          ++d.cursor;
+          return item;
+        }
+      }
+      begin = end;
+    }
+    ++d.cursor;
+    return item;
+  }
+
+public:
+  template <bool _concurrent>
+  using rethread = StealingDeque<T, _concurrent>;
+
+  template <typename _T>
+  using retype = StealingDeque<_T, Concurrent>;
+
+  typedef T value_type;
+
+  StealingDeque() {
+    auto& tp         = substrate::getThreadPool();
+    unsigned threads = Concurrent ? runtime::activeThreads : 1;
+    for (unsigned tid = 0; tid < threads; ++tid) {
+      Deque& d       = *deques.getRemote(tid);
+      unsigned core  = tp.getCore(tid);
+      unsigned sock  = tp.getSocket(tid);
+      unsigned socks = tp.getMaxSockets();
+      for (unsigned v = 0; v < threads; ++v)
+        if (v != tid && tp.getCore(v) == core)
+          d.victims.push_back(v);
+      d.levelEnd[0] = d.victims.size();
+      for (unsigned v = 0; v < threads; ++v)
+        if (tp.getSocket(v) == sock && tp.getCore(v) != core)
+          d.victims.push_back(v);
+      d.levelEnd[1] = d.victims.size();
+      for (unsigned s = 1; s < socks; ++s)
+        for (unsigned v = 0; v < threads; ++v)
+          if (tp.getSocket(v) == (sock + s) % socks)
+            d.victims.push_back(v);
+      d.levelEnd[2] = d.victims.size();
+      d.cursor      = tid;
+    }
+  }
+
+  void push(const value_type& val) { pushLocal(*deques.getLocal(), val); }
+
+  template <typename Iter>
+  void push(Iter b, Iter e) {
+    Deque& d = *deques.getLocal();
+    while (b != e)
+      pushLocal(d, *b++);
+  }
+
+  template <typename RangeTy>
+  void push_initial(const RangeTy& range) {
+    auto rp = range.local_pair();
+    push(rp.first, rp.second);
+  }
+
+  galois::optional<value_type> pop() {
+    Deque& d  = *deques.getLocal();
+    auto item = popLocal(d);
+    if (item || !Concurrent)
+      return item;
+    return steal(d);
+  }
+};
+GALOIS_WLCOMPILECHECK(StealingDeque)
+
+} // end namespace worklists
+} // end namespace galois
+
+#endif
@@ -28,10 +28,13 @@
 #include "galois/worklists/Chunk.h"
 #include "galois/worklists/Simple.h"
 #include "galois/worklists/LocalQueue.h"
+#include "galois/worklists/MonotoneBucket.h"
+#include "galois/worklists/MultiQueue.h"
 #include "galois/worklists/Obim.h"
 #include "galois/worklists/OrderedList.h"
 #include "galois/worklists/OwnerComputes.h"
 #include "galois/worklists/StableIterator.h"
+#include "galois/worklists/StealingDeque.h"
 
 namespace galois {
 /**
@@ -20,6 +20,7 @@
 #include "galois/substrate/PerThreadStorage.h"
 #include "galois/substrate/Barrier.h"
 #include "galois/substrate/CompilerSpecific.h"
+#include "galois/substrate/EventTrace.h"
 
 #include <atomic>
 
@@ -81,6 +82,7 @@ public:
   virtual void reinit(unsigned val) { _reinit(val); }
 
   virtual void wait() {
+    galois::substrate::traceEvent(galois::substrate::TraceEvent::BARRIER_BEGIN);
     unsigned id = galois::substrate::ThreadPool::getTID();
     treenode& n = *nodes.getLocal();
     unsigned& s = *sense.getLocal();
@@ -115,6 +117,7 @@ public:
         n.parentsense = s;
     }
     ++s;
+    galois::substrate::traceEvent(galois::substrate::TraceEvent::BARRIER_END);
   }
 
   virtual const char* name() const { return "TopoBarrier"; }
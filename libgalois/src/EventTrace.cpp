@@ -0,0 +1,240 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file EventTrace.cpp
+ *
+ * Buffers and output of the event tracer.
+ */
+
+#include "galois/substrate/EventTrace.h"
+
+#ifdef GALOIS_ENABLE_EVENT_TRACE
+
+#include "galois/gIO.h"
+#include "galois/substrate/EnvCheck.h"
+#include "galois/substrate/SimpleLock.h"
+#include "galois/substrate/ThreadPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <unistd.h>
+
+struct galois::substrate::internal::TraceBuffer {
+  std::unique_ptr<TraceRecord[]> records;
+  uint64_t mask;
+  //! number of records ever recorded
+  uint64_t count;
+  unsigned tid;
+  std::unordered_set<std::string> names;
+  //! interned copy of the last name seen at each address; the caller may
+  //! reuse the storage for another name, so hits are checked with strcmp
+  std::unordered_map<const char*, const char*> namesByAddress;
+};
+
+thread_local galois::substrate::internal::TraceBuffer*
+    galois::substrate::internal::localTraceBuffer = nullptr;
+
+namespace {
+
+using galois::substrate::TraceEvent;
+using galois::substrate::internal::TraceBuffer;
+using galois::substrate::internal::TraceRecord;
+
+//! All buffers; written out when the program exits
+struct TraceRegistry {
+  galois::substrate::SimpleLock lock;
+  std::vector<std::unique_ptr<TraceBuffer>> buffers;
+
+  ~TraceRegistry() {
+    std::string filename;
+    if (!galois::substrate::EnvCheck("GALOIS_EVENT_TRACE", filename))
+      filename = "galois-trace." + std::to_string(getpid()) + ".json";
+    galois::substrate::writeEventTrace(filename);
+  }
+};
+
+TraceRegistry& getRegistry() {
+  static TraceRegistry registry;
+  return registry;
+}
+
+const char* eventName(const TraceRecord& r) {
+  switch (r.event) {
+  case TraceEvent::LOOP_BEGIN:
+  case TraceEvent::LOOP_END:
+    return r.name ? r.name : "loop";
+  case TraceEvent::BARRIER_BEGIN:
+  case TraceEvent::BARRIER_END:
+    return "barrier";
+  case TraceEvent::CHUNK_PUSH:
+    return "push";
+  case TraceEvent::CHUNK_POP:
+    return "pop";
+  case TraceEvent::CHUNK_STEAL:
+    return "steal";
+  case TraceEvent::ABORT:
+    return "abort";
+  }
+  return "unknown";
+}
+
+char eventPhase(const TraceRecord& r) {
+  switch (r.event) {
+  case TraceEvent::LOOP_BEGIN:
+  case TraceEvent::BARRIER_BEGIN:
+    return 'B';
+  case TraceEvent::LOOP_END:
+  case TraceEvent::BARRIER_END:
+    return 'E';
+  default:
+    return 'i';
+  }
+}
+
+/**
+ * Marks the records of b that can be written. Once the ring buffer wraps, the
+ * oldest surviving records may end spans whose beginnings were overwritten,
+ * and spans still open when the trace is written have no end; such halves
+ * are dropped so that every B event written has its E event.
+ */
+std::vector<bool> matchedRecords(const TraceBuffer& b, uint64_t first) {
+  std::vector<bool> keep(b.count - first, true);
+  std::vector<std::pair<uint64_t, TraceEvent>> open;
+  for (uint64_t i = first; i < b.count; ++i) {
+    const TraceRecord& r = b.records[i & b.mask];
+    char phase           = eventPhase(r);
+    if (phase == 'B') {
+      open.emplace_back(i, r.event);
+    } else if (phase == 'E') {
+      TraceEvent begin = r.event == TraceEvent::LOOP_END
+                             ? TraceEvent::LOOP_BEGIN
+                             : TraceEvent::BARRIER_BEGIN;
+      if (!open.empty() && open.back().second == begin)
+        open.pop_back();
+      else
+        keep[i - first] = false;
+    }
+  }
+  for (auto& o : open)
+    keep[o.first - first] = false;
+  return keep;
+}
+
+void writeString(std::ostream& os, const char* s) {
+  os << '"';
+  for (; *s; ++s) {
+    if (*s == '"' || *s == '\\')
+      os << '\\' << *s;
+    else if ((unsigned char)*s >= 0x20)
+      os << *s;
+  }
+  os << '"';
+}
+
+} // namespace
+
+galois::substrate::internal::TraceBuffer*
+galois::substrate::internal::createTraceBuffer() {
+  int size = 1 << 16;
+  EnvCheck("GALOIS_EVENT_TRACE_SIZE", size);
+  uint64_t capacity = 1;
+  while (capacity < uint64_t(std::max(size, 1)))
+    capacity *= 2;
+
+  std::unique_ptr<TraceBuffer> b(new TraceBuffer());
+  b->records.reset(new TraceRecord[capacity]);
+  b->mask  = capacity - 1;
+  b->count = 0;
+  b->tid   = ThreadPool::getTID();
+
+  TraceRegistry& registry = getRegistry();
+  std::lock_guard<SimpleLock> lg(registry.lock);
+  registry.buffers.push_back(std::move(b));
+  localTraceBuffer = registry.buffers.back().get();
+  return localTraceBuffer;
+}
+
+galois::substrate::internal::TraceRecord&
+galois::substrate::internal::nextTraceRecord(TraceBuffer* b) {
+  return b->records[b->count++ & b->mask];
+}
+
+const char* galois::substrate::internal::internTraceName(TraceBuffer* b,
+                                                         const char* name) {
+  // loops pass the same name at every begin and end; only copy new names
+  const char*& interned = b->namesByAddress[name];
+  if (!interned || std::strcmp(interned, name) != 0)
+    interned = b->names.emplace(name).first->c_str();
+  return interned;
+}
+
+void galois::substrate::writeEventTrace(const std::string& filename) {
+  TraceRegistry& registry = getRegistry();
+  std::lock_guard<SimpleLock> lg(registry.lock);
+
+  uint64_t start = UINT64_MAX;
+  for (auto& b : registry.buffers) {
+    uint64_t first = b->count > b->mask ? b->count - b->mask - 1 : 0;
+    if (first < b->count)
+      start = std::min(start, b->records[first & b->mask].time);
+  }
+
+  std::ofstream out(filename);
+  if (!out) {
+    gWarn("cannot write event trace to ", filename);
+    return;
+  }
+
+  out << "{\"traceEvents\":[";
+  bool firstEvent = true;
+  for (auto& b : registry.buffers) {
+    uint64_t first         = b->count > b->mask ? b->count - b->mask - 1 : 0;
+    std::vector<bool> keep = matchedRecords(*b, first);
+    for (uint64_t i = first; i < b->count; ++i) {
+      if (!keep[i - first])
+        continue;
+      const TraceRecord& r = b->records[i & b->mask];
+      out << (firstEvent ? "\n" : ",\n");
+      firstEvent = false;
+      out << "{\"name\":";
+      writeString(out, eventName(r));
+      out << ",\"ph\":\"" << eventPhase(r) << "\",\"ts\":"
+          << (r.time - start) / 1000 << "." << (r.time - start) % 1000 / 100
+          << ",\"pid\":0,\"tid\":" << b->tid;
+      if (eventPhase(r) == 'i')
+        out << ",\"s\":\"t\",\"args\":{\"arg\":" << r.arg << "}";
+      out << "}";
+    }
+  }
+  out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+#else
+
+void galois::substrate::writeEventTrace(const std::string&) {}
+
+#endif
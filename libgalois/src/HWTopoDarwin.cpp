@@ -69,6 +69,9 @@ HWTopoInfo makeHWTopo() {
 
   const unsigned threadsPerSocket =
       (mti.maxThreads + mti.maxThreads - 1) / mti.maxSockets;
+  // SMT siblings per core, as the kernel reports them
+  const unsigned logicalPerPhysical = std::max(
+      1, getIntValue("hw.logicalcpu") / getIntValue("hw.physicalcpu"));
 
   // Describe dense configuration first; then, sort logical threads to the
   // back.
@@ -81,12 +84,10 @@ HWTopoInfo makeHWTopo() {
         .numaNode     = socket,
         .osContext    = i,
         .osNumaNode   = socket,
+        .core         = i / logicalPerPhysical,
     });
   }
 
-  const unsigned logicalPerPhysical =
-      (mti.maxThreads + mti.maxThreads - 1) / mti.maxCores;
-
   std::sort(tti.begin(), tti.end(),
             [&](const ThreadTopoInfo& a, const ThreadTopoInfo& b) {
               int smtA = a.osContext % logicalPerPhysical;
@@ -32,6 +32,8 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <sstream>
+#include <tuple>
 
 #ifdef GALOIS_USE_NUMA
 #include <numa.h>
@@ -54,16 +56,72 @@ struct cpuinfo {
   unsigned numaNode; // from libnuma
   bool valid;        // from cpuset
   bool smt;          // computed
+  unsigned coreRank; // computed: index of core within its socket
 };
 
-bool operator<(const cpuinfo& lhs, const cpuinfo& rhs) {
-  if (lhs.smt != rhs.smt)
-    return lhs.smt < rhs.smt;
-  if (lhs.physid != rhs.physid)
-    return lhs.physid < rhs.physid;
-  if (lhs.coreid != rhs.coreid)
-    return lhs.coreid < rhs.coreid;
-  return lhs.proc < rhs.proc;
+//! Order in which SMT siblings are handed out to threads
+enum class SMTPolicy {
+  CORES,    // one context per physical core before any sibling
+  SIBLINGS, // all contexts of a core before the next core
+  NOSMT,    // never use more than one context per core
+};
+
+//! Order in which sockets are handed out to threads
+enum class SocketPolicy {
+  COMPACT, // fill a socket before moving on to the next
+  SPREAD,  // round-robin cores across sockets
+};
+
+struct PlacementPolicy {
+  SMTPolicy smt       = SMTPolicy::CORES;
+  SocketPolicy socket = SocketPolicy::COMPACT;
+  std::vector<int> exclude;
+};
+
+const char* name(SMTPolicy p) {
+  switch (p) {
+  case SMTPolicy::CORES:
+    return "cores";
+  case SMTPolicy::SIBLINGS:
+    return "siblings";
+  case SMTPolicy::NOSMT:
+    return "nosmt";
+  }
+  return "";
+}
+
+const char* name(SocketPolicy p) {
+  return p == SocketPolicy::SPREAD ? "spread" : "compact";
+}
+
+/**
+ * Reads the placement policy from the environment:
+ *  - GALOIS_SMT_POLICY: cores (default), siblings or nosmt
+ *  - GALOIS_SOCKET_POLICY: compact (default) or spread
+ *  - GALOIS_EXCLUDE_CPUS: OS cpus never to run on, in cpuset(7) list format
+ */
+PlacementPolicy getPlacementPolicy() {
+  PlacementPolicy policy;
+  std::string val;
+  if (galois::substrate::EnvCheck("GALOIS_SMT_POLICY", val)) {
+    if (val == "siblings")
+      policy.smt = SMTPolicy::SIBLINGS;
+    else if (val == "nosmt")
+      policy.smt = SMTPolicy::NOSMT;
+    else if (val != "cores")
+      galois::gWarn("Unknown GALOIS_SMT_POLICY ", val, ", using cores");
+  }
+  if (galois::substrate::EnvCheck("GALOIS_SOCKET_POLICY", val)) {
+    if (val == "spread")
+      policy.socket = SocketPolicy::SPREAD;
+    else if (val != "compact")
+      galois::gWarn("Unknown GALOIS_SOCKET_POLICY ", val, ", using compact");
+  }
+  if (galois::substrate::EnvCheck("GALOIS_EXCLUDE_CPUS", val)) {
+    policy.exclude = galois::substrate::parseCPUList(val);
+    std::sort(policy.exclude.begin(), policy.exclude.end());
+  }
+  return policy;
 }
 
 unsigned getNumaNode(cpuinfo& c) {
@@ -158,13 +216,39 @@ unsigned countNumaNodes(const std::vector<cpuinfo>& info) {
   return nodes.size();
 }
 
+//! Sort by physical location and compute smt and coreRank
 void markSMT(std::vector<cpuinfo>& info) {
-  for (unsigned int i = 1; i < info.size(); ++i)
-    if (info[i - 1].physid == info[i].physid &&
-        info[i - 1].coreid == info[i].coreid)
-      info[i].smt = true;
-    else
-      info[i].smt = false;
+  std::sort(info.begin(), info.end(), [](const cpuinfo& a, const cpuinfo& b) {
+    return std::tie(a.physid, a.coreid, a.proc) <
+           std::tie(b.physid, b.coreid, b.proc);
+  });
+  for (unsigned int i = 0; i < info.size(); ++i) {
+    if (i == 0 || info[i - 1].physid != info[i].physid) {
+      info[i].smt      = false;
+      info[i].coreRank = 0;
+    } else if (info[i - 1].coreid == info[i].coreid) {
+      info[i].smt      = true;
+      info[i].coreRank = info[i - 1].coreRank;
+    } else {
+      info[i].smt      = false;
+      info[i].coreRank = info[i - 1].coreRank + 1;
+    }
+  }
+}
+
+//! Order contexts in the sequence threads are assigned to them
+void orderCPUs(std::vector<cpuinfo>& info, const PlacementPolicy& policy) {
+  bool smtFirst = policy.smt != SMTPolicy::SIBLINGS;
+  bool spread   = policy.socket == SocketPolicy::SPREAD;
+  std::stable_sort(info.begin(), info.end(),
+                   [=](const cpuinfo& a, const cpuinfo& b) {
+                     if (smtFirst && a.smt != b.smt)
+                       return a.smt < b.smt;
+                     if (spread && a.coreRank != b.coreRank)
+                       return a.coreRank < b.coreRank;
+                     return std::tie(a.physid, a.coreid, a.proc) <
+                            std::tie(b.physid, b.coreid, b.proc);
+                   });
 }
 
 std::vector<int> parseCPUSet() {
@@ -200,32 +284,108 @@ std::vector<int> parseCPUSet() {
   return galois::substrate::parseCPUList(line);
 }
 
-void markValid(std::vector<cpuinfo>& info) {
-  auto v = parseCPUSet();
-  if (v.empty()) {
-    for (auto& c : info)
-      c.valid = true;
-  } else {
+//! Effective cpuset of our cgroup v2 group; empty if there is none
+std::vector<int> parseCgroupCPUSet() {
+  std::ifstream cgroup("/proc/self/cgroup");
+  if (!cgroup) {
+    return {};
+  }
+
+  // the unified hierarchy is the entry with id 0 and no controllers
+  std::string line;
+  std::string prefix("0::");
+  while (std::getline(cgroup, line)) {
+    if (line.compare(0, prefix.size(), prefix) == 0) {
+      std::ifstream data("/sys/fs/cgroup" + line.substr(prefix.size()) +
+                         "/cpuset.cpus.effective");
+      if (data && std::getline(data, line)) {
+        return galois::substrate::parseCPUList(line);
+      }
+      break;
+    }
+  }
+  return {};
+}
+
+//! CPUs in the affinity mask the process was started with
+std::vector<int> getAffinity() {
+  std::vector<int> vals;
+#ifdef GALOIS_USE_SCHED_SETAFFINITY
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+    for (int i = 0; i < CPU_SETSIZE; ++i) {
+      if (CPU_ISSET(i, &mask)) {
+        vals.push_back(i);
+      }
+    }
+  }
+#endif
+  return vals;
+}
+
+/**
+ * A context is valid if it is in every cpu restriction we can find (the
+ * status cpuset, the affinity mask and the cgroup cpuset) and not excluded
+ * by the user. Empty restrictions are ignored.
+ */
+void markValid(std::vector<cpuinfo>& info, const PlacementPolicy& policy) {
+  for (auto& c : info)
+    c.valid = !std::binary_search(policy.exclude.begin(), policy.exclude.end(),
+                                  c.proc);
+
+  for (auto v : {parseCPUSet(), getAffinity(), parseCgroupCPUSet()}) {
+    if (v.empty()) {
+      continue;
+    }
     std::sort(v.begin(), v.end());
     for (auto& c : info)
-      c.valid = std::binary_search(v.begin(), v.end(), c.proc);
+      c.valid = c.valid && std::binary_search(v.begin(), v.end(), c.proc);
+  }
+}
+
+/**
+ * Reports the chosen policy and the cpus it leaves; with
+ * GALOIS_REPORT_PLACEMENT, also the cpu, socket and core of every thread.
+ */
+void reportPlacement(const galois::substrate::HWTopoInfo& topo,
+                     const PlacementPolicy& policy) {
+  const auto& m = topo.machineTopoInfo;
+  std::ostringstream os;
+  os << "Thread placement (smt: " << name(policy.smt)
+     << ", sockets: " << name(policy.socket) << "): " << m.maxThreads
+     << " cpus, " << m.maxCores << " cores, " << m.maxSockets << " sockets";
+  if (galois::substrate::EnvCheck("GALOIS_REPORT_PLACEMENT")) {
+    os << "; tid:cpu/socket/core:";
+    for (auto& t : topo.threadTopoInfo) {
+      os << " " << t.tid << ":" << t.osContext << "/" << t.socket << "/"
+         << t.core;
+    }
   }
+  galois::gInfo(os.str());
 }
 
 galois::substrate::HWTopoInfo makeHWTopo() {
   galois::substrate::MachineTopoInfo retMTI;
 
-  auto info = parseCPUInfo();
-  std::sort(info.begin(), info.end());
-  markSMT(info);
-  markValid(info);
+  auto policy = getPlacementPolicy();
+  auto info   = parseCPUInfo();
+  markValid(info, policy);
 
   info.erase(std::partition(info.begin(), info.end(),
                             [](const cpuinfo& c) { return c.valid; }),
              info.end());
+  if (info.empty())
+    GALOIS_DIE("no cpus left to run on after applying cpusets and "
+               "GALOIS_EXCLUDE_CPUS");
 
-  std::sort(info.begin(), info.end());
   markSMT(info);
+  if (policy.smt == SMTPolicy::NOSMT)
+    info.erase(std::remove_if(info.begin(), info.end(),
+                              [](const cpuinfo& c) { return c.smt; }),
+               info.end());
+  orderCPUs(info, policy);
+
   retMTI.maxSockets   = countSockets(info);
   retMTI.maxThreads   = info.size();
   retMTI.maxCores     = countCores(info);
@@ -236,9 +396,11 @@ galois::substrate::HWTopoInfo makeHWTopo() {
   // compute renumberings
   std::set<unsigned> sockets;
   std::set<unsigned> numaNodes;
+  std::set<std::pair<unsigned, unsigned>> cores;
   for (auto& i : info) {
     sockets.insert(i.physid);
     numaNodes.insert(i.numaNode);
+    cores.insert(std::make_pair(i.physid, i.coreid));
   }
   unsigned mid = 0; // max socket id
   for (unsigned i = 0; i < info.size(); ++i) {
@@ -254,13 +416,18 @@ galois::substrate::HWTopoInfo makeHWTopo() {
         i, leader, repid,
         (unsigned)std::distance(numaNodes.begin(),
                                 numaNodes.find(info[i].numaNode)),
-        mid, info[i].proc, info[i].numaNode});
+        mid, info[i].proc, info[i].numaNode,
+        (unsigned)std::distance(
+            cores.begin(),
+            cores.find(std::make_pair(info[i].physid, info[i].coreid)))});
   }
 
-  return {
+  galois::substrate::HWTopoInfo ret{
       .machineTopoInfo = retMTI,
       .threadTopoInfo  = retTTI,
   };
+  reportPlacement(ret, policy);
+  return ret;
 }
 
 } // namespace
@@ -0,0 +1,273 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/graphs/Intersection.h"
+#include "galois/gIO.h"
+
+#include <algorithm>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define GALOIS_INTERSECT_X86
+#include <immintrin.h>
+#endif
+
+using namespace galois::graphs;
+
+namespace {
+
+//! Sets that differ in size by at least this factor are galloped over
+constexpr uint64_t gallopRatio = 32;
+
+typedef uint64_t (*CountFn)(const uint32_t*, uint64_t, const uint32_t*,
+                            uint64_t);
+
+uint64_t countScalar(const uint32_t* a, uint64_t na, const uint32_t* b,
+                     uint64_t nb) {
+  uint64_t i = 0, j = 0, count = 0;
+  while (i < na && j < nb) {
+    uint32_t x = a[i];
+    uint32_t y = b[j];
+    // branch free: the outcome of the comparisons is unpredictable
+    i += x <= y;
+    j += y <= x;
+    count += x == y;
+  }
+  return count;
+}
+
+#ifdef GALOIS_INTERSECT_X86
+
+// The vector kernels compare a block of each set against all rotations of a
+// block of the other set and count the lanes of the first block that matched.
+// The block with the smaller last element is consumed (both if they are
+// equal). That counts every element at most once only while the sets have no
+// duplicates, so each block is also compared with the elements after it and
+// the kernels leave everything from the first repeated element on to the
+// scalar merge, which pairs up repeated elements one to one. The remainders
+// are intersected with the scalar merge too.
+
+__attribute__((target("sse4.2"))) uint64_t
+countSSE42(const uint32_t* a, uint64_t na, const uint32_t* b, uint64_t nb) {
+  uint64_t i = 0, j = 0, count = 0;
+  // one element past each block has to be there for the duplicate check
+  while (i + 4 < na && j + 4 < nb) {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+    __m128i xa = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 1));
+    __m128i xb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j + 1));
+    __m128i d  = _mm_or_si128(_mm_cmpeq_epi32(va, xa), _mm_cmpeq_epi32(vb, xb));
+    if (!_mm_testz_si128(d, d))
+      break;
+    __m128i m = _mm_cmpeq_epi32(va, vb);
+    vb        = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+    m         = _mm_or_si128(m, _mm_cmpeq_epi32(va, vb));
+    vb        = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+    m         = _mm_or_si128(m, _mm_cmpeq_epi32(va, vb));
+    vb        = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+    m         = _mm_or_si128(m, _mm_cmpeq_epi32(va, vb));
+    count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(m)));
+
+    uint32_t amax = a[i + 3];
+    uint32_t bmax = b[j + 3];
+    i += (amax <= bmax) * 4;
+    j += (bmax <= amax) * 4;
+  }
+  return count + countScalar(a + i, na - i, b + j, nb - j);
+}
+
+__attribute__((target("avx2"))) uint64_t
+countAVX2(const uint32_t* a, uint64_t na, const uint32_t* b, uint64_t nb) {
+  uint64_t i = 0, j = 0, count = 0;
+  const __m256i r = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+  while (i + 8 < na && j + 8 < nb) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+    __m256i xa =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 1));
+    __m256i xb =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j + 1));
+    __m256i d = _mm256_or_si256(_mm256_cmpeq_epi32(va, xa),
+                                _mm256_cmpeq_epi32(vb, xb));
+    if (!_mm256_testz_si256(d, d))
+      break;
+    __m256i m = _mm256_cmpeq_epi32(va, vb);
+    for (int k = 1; k < 8; ++k) {
+      vb = _mm256_permutevar8x32_epi32(vb, r);
+      m  = _mm256_or_si256(m, _mm256_cmpeq_epi32(va, vb));
+    }
+    count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(m)));
+
+    uint32_t amax = a[i + 7];
+    uint32_t bmax = b[j + 7];
+    i += (amax <= bmax) * 8;
+    j += (bmax <= amax) * 8;
+  }
+  return count + countSSE42(a + i, na - i, b + j, nb - j);
+}
+
+__attribute__((target("avx512f"))) uint64_t
+countAVX512(const uint32_t* a, uint64_t na, const uint32_t* b, uint64_t nb) {
+  uint64_t i = 0, j = 0, count = 0;
+  const __m512i r = _mm512_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12,
+                                      13, 14, 15, 0);
+  while (i + 16 < na && j + 16 < nb) {
+    __m512i va = _mm512_loadu_si512(a + i);
+    __m512i vb = _mm512_loadu_si512(b + j);
+    if (_mm512_cmpeq_epi32_mask(va, _mm512_loadu_si512(a + i + 1)) |
+        _mm512_cmpeq_epi32_mask(vb, _mm512_loadu_si512(b + j + 1)))
+      break;
+    __mmask16 m = _mm512_cmpeq_epi32_mask(va, vb);
+    for (int k = 1; k < 16; ++k) {
+      // full-mask form; the unmasked one warns about an undefined operand
+      vb = _mm512_mask_permutexvar_epi32(vb, 0xFFFF, r, vb);
+      m |= _mm512_cmpeq_epi32_mask(va, vb);
+    }
+    count += __builtin_popcount(m);
+
+    uint32_t amax = a[i + 15];
+    uint32_t bmax = b[j + 15];
+    i += (amax <= bmax) * 16;
+    j += (bmax <= amax) * 16;
+  }
+  return count + countAVX2(a + i, na - i, b + j, nb - j);
+}
+
+#endif
+
+CountFn kernelOf(IntersectISA isa) {
+  switch (isa) {
+#ifdef GALOIS_INTERSECT_X86
+  case IntersectISA::SSE42:
+    return countSSE42;
+  case IntersectISA::AVX2:
+    return countAVX2;
+  case IntersectISA::AVX512:
+    return countAVX512;
+#endif
+  default:
+    return countScalar;
+  }
+}
+
+IntersectISA bestISA() {
+  for (auto isa : {IntersectISA::AVX512, IntersectISA::AVX2,
+                   IntersectISA::SSE42}) {
+    if (isIntersectISASupported(isa))
+      return isa;
+  }
+  return IntersectISA::SCALAR;
+}
+
+struct Dispatch {
+  IntersectISA isa;
+  CountFn count;
+  Dispatch() : isa(bestISA()), count(kernelOf(isa)) {}
+};
+
+Dispatch& dispatch() {
+  static Dispatch d;
+  return d;
+}
+
+} // namespace
+
+const char* galois::graphs::intersectISAName(IntersectISA isa) {
+  switch (isa) {
+  case IntersectISA::SSE42:
+    return "SSE4.2";
+  case IntersectISA::AVX2:
+    return "AVX2";
+  case IntersectISA::AVX512:
+    return "AVX-512";
+  default:
+    return "scalar";
+  }
+}
+
+bool galois::graphs::isIntersectISASupported(IntersectISA isa) {
+#ifdef GALOIS_INTERSECT_X86
+  __builtin_cpu_init();
+  switch (isa) {
+  case IntersectISA::SSE42:
+    return __builtin_cpu_supports("sse4.2");
+  case IntersectISA::AVX2:
+    return __builtin_cpu_supports("avx2");
+  case IntersectISA::AVX512:
+    return __builtin_cpu_supports("avx512f");
+  default:
+    return true;
+  }
+#else
+  return isa == IntersectISA::SCALAR;
+#endif
+}
+
+IntersectISA galois::graphs::getIntersectISA() { return dispatch().isa; }
+
+void galois::graphs::setIntersectISA(IntersectISA isa) {
+  if (!isIntersectISASupported(isa)) {
+    GALOIS_DIE("intersection kernel ", intersectISAName(isa),
+               " not supported on this machine");
+  }
+  dispatch().isa   = isa;
+  dispatch().count = kernelOf(isa);
+}
+
+uint64_t galois::graphs::internal::countIntersectionISA(IntersectISA isa,
+                                                        const uint32_t* a,
+                                                        uint64_t na,
+                                                        const uint32_t* b,
+                                                        uint64_t nb) {
+  return kernelOf(isa)(a, na, b, nb);
+}
+
+uint64_t galois::graphs::internal::countIntersectionGalloping(
+    const uint32_t* small, uint64_t ns, const uint32_t* large, uint64_t nl) {
+  uint64_t count = 0;
+  uint64_t lo    = 0;
+  for (uint64_t i = 0; i < ns && lo < nl; ++i) {
+    uint32_t key = small[i];
+    // all of large before lo is smaller than key; find a window
+    // (lo + bound / 2, lo + bound] that contains the first element >= key
+    uint64_t bound = 1;
+    while (lo + bound < nl && large[lo + bound] < key)
+      bound *= 2;
+    const uint32_t* first = large + lo + bound / 2;
+    const uint32_t* last  = large + std::min(lo + bound + 1, nl);
+    lo                    = std::lower_bound(first, last, key) - large;
+    if (lo < nl && large[lo] == key) {
+      ++count;
+      ++lo;
+    }
+  }
+  return count;
+}
+
+uint64_t galois::graphs::countIntersection(const uint32_t* a, uint64_t na,
+                                           const uint32_t* b, uint64_t nb) {
+  if (na > nb) {
+    std::swap(a, b);
+    std::swap(na, nb);
+  }
+  if (na == 0 || a[na - 1] < b[0] || b[nb - 1] < a[0])
+    return 0;
+  if (nb / na >= gallopRatio)
+    return internal::countIntersectionGalloping(a, na, b, nb);
+  return dispatch().count(a, na, b, nb);
+}
@@ -24,6 +24,10 @@
 
 #include <cassert>
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 using namespace galois::substrate;
 
 /* Access pages on each thread so each thread has some pages already loaded
@@ -233,3 +237,43 @@ template LAptr galois::substrate::largeMallocSpecified<std::vector<uint32_t>>(
 template LAptr galois::substrate::largeMallocSpecified<std::vector<uint64_t>>(
     size_t bytes, uint32_t numThreads, std::vector<uint64_t>& threadRanges,
     size_t elementSize);
+
+LAptr galois::substrate::largeMapFile(const std::string& filename, bool shared,
+                                      size_t& bytes) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1)
+    GALOIS_SYS_DIE("failed opening ", "'", filename, "'");
+
+  struct stat buf;
+  if (fstat(fd, &buf) == -1)
+    GALOIS_SYS_DIE("failed reading ", "'", filename, "'");
+  bytes = buf.st_size;
+
+  // round up so the mapping can be released by largeFreer; the tail past the
+  // end of the file is never touched
+  size_t mapped = roundup(bytes, allocSize());
+  int prot      = shared ? PROT_READ : PROT_READ | PROT_WRITE;
+  void* data =
+      galois::mmap(nullptr, mapped, prot, shared ? MAP_SHARED : MAP_PRIVATE,
+                   fd, 0);
+  if (data == MAP_FAILED)
+    GALOIS_SYS_DIE("failed mapping ", "'", filename, "'");
+  // the mapping keeps the file referenced
+  close(fd);
+
+  return LAptr{data, internal::largeFreer{mapped}};
+}
+
+void galois::substrate::prefaultMapped(const void* ptr, size_t bytes) {
+  static const uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+  if (!bytes)
+    return;
+  uintptr_t begin = reinterpret_cast<uintptr_t>(ptr) & ~(pageSize - 1);
+  uintptr_t end   = reinterpret_cast<uintptr_t>(ptr) + bytes;
+  // read ahead only this thread's block so that the page cache fills from
+  // the thread's own node
+  if (madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED) != 0)
+    gDebug("madvise failed");
+  for (uintptr_t x = begin; x < end; x += pageSize)
+    *reinterpret_cast<const volatile char*>(x);
+}
@@ -21,6 +21,7 @@
   __has_trivial_constructor(type) && __has_trivial_copy(type)
 
 #include "galois/runtime/PagePool.h"
+#include "galois/substrate/EnvCheck.h"
 
 using namespace galois::runtime;
 
@@ -30,6 +31,11 @@ void galois::runtime::internal::setPagePoolState(PageAllocState<>* pa) {
   GALOIS_ASSERT(!(PA && pa),
                 "PagePool.cpp: Double Initialization of PageAllocState");
   PA = pa;
+
+  int highWater;
+  if (PA && substrate::EnvCheck("GALOIS_PAGE_POOL_HIGH_WATER", highWater)) {
+    PA->setHighWater(highWater);
+  }
 }
 
 int galois::runtime::numPagePoolAllocTotal() { return PA->countAll(); }
@@ -48,3 +54,13 @@ void galois::runtime::pagePoolPreAlloc(unsigned num) {
 void galois::runtime::pagePoolFree(void* ptr) { PA->pageFree(ptr); }
 
 size_t galois::runtime::pagePoolSize() { return substrate::allocSize(); }
+
+void galois::runtime::setPagePoolHighWater(int pages) {
+  PA->setHighWater(pages);
+}
+
+void galois::runtime::pagePoolTrim() {
+  if (PA) {
+    PA->trim();
+  }
+}
@@ -0,0 +1,214 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/graphs/ParallelFileReader.h"
+#include "galois/runtime/Statistics.h"
+#include "galois/substrate/PageAlloc.h"
+#include "galois/substrate/ThreadPool.h"
+#include "galois/Threads.h"
+#include "galois/gIO.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace galois::graphs;
+
+namespace {
+
+//! Alignment of offsets, lengths and buffers for O_DIRECT reads
+constexpr uint64_t directAlignment = 4096;
+//! Size of the per-thread bounce buffer used for O_DIRECT reads
+constexpr uint64_t directBufferSize = 4 * 1024 * 1024;
+//! Reads smaller than this are not worth waking up the thread pool for
+constexpr uint64_t minParallelRead = 1024 * 1024;
+
+uint64_t roundup(uint64_t num, uint64_t multiple) {
+  return ((num + multiple - 1) / multiple) * multiple;
+}
+
+} // namespace
+
+ParallelFileReader::ParallelFileReader(const std::string& filename,
+                                       bool direct)
+    : directFd(-1), bytesRead(0), readNanos(0) {
+  fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1) {
+    GALOIS_SYS_DIE("failed opening ", "'", filename, "'");
+  }
+
+  struct stat buf;
+  if (fstat(fd, &buf) == -1) {
+    GALOIS_SYS_DIE("failed reading ", "'", filename, "'");
+  }
+  fileSize = buf.st_size;
+
+  if (direct) {
+#ifdef O_DIRECT
+    directFd = open(filename.c_str(), O_RDONLY | O_DIRECT);
+    if (directFd == -1) {
+      galois::gWarn("O_DIRECT not supported for '", filename,
+                    "'; using buffered reads");
+    }
+#else
+    galois::gWarn("O_DIRECT not supported on this platform; using buffered "
+                  "reads");
+#endif
+  }
+}
+
+ParallelFileReader::~ParallelFileReader() {
+  if (directFd != -1)
+    close(directFd);
+  close(fd);
+}
+
+void ParallelFileReader::readBlock(void* _dst, uint64_t offset,
+                                   uint64_t length) {
+  char* dst = static_cast<char*>(_dst);
+  while (length) {
+    ssize_t r = pread(fd, dst, length, offset);
+    if (r == -1) {
+      if (errno == EINTR)
+        continue;
+      GALOIS_SYS_DIE("failed reading file at offset ", offset);
+    }
+    if (r == 0) {
+      GALOIS_DIE("unexpected end of file at offset ", offset);
+    }
+    dst += r;
+    offset += r;
+    length -= r;
+  }
+}
+
+void ParallelFileReader::readBlockDirect(void* _dst, uint64_t offset,
+                                         uint64_t length) {
+  void* buffer;
+  if (posix_memalign(&buffer, directAlignment, directBufferSize)) {
+    GALOIS_DIE("out of memory");
+  }
+
+  char* dst    = static_cast<char*>(_dst);
+  uint64_t end = offset + length;
+  while (offset < end) {
+    uint64_t aligned = offset & ~(directAlignment - 1);
+    uint64_t skip    = offset - aligned;
+    uint64_t toRead =
+        std::min(directBufferSize, roundup(end - aligned, directAlignment));
+
+    ssize_t r = pread(directFd, buffer, toRead, aligned);
+    if (r == -1) {
+      if (errno == EINTR)
+        continue;
+      if (errno == EINVAL) {
+        // alignment requirement of the device is larger than we assumed
+        readBlock(dst, offset, end - offset);
+        break;
+      }
+      GALOIS_SYS_DIE("failed reading file at offset ", aligned);
+    }
+    if (static_cast<uint64_t>(r) <= skip) {
+      GALOIS_DIE("unexpected end of file at offset ", offset);
+    }
+
+    uint64_t n = std::min(static_cast<uint64_t>(r) - skip, end - offset);
+    std::memcpy(dst, static_cast<char*>(buffer) + skip, n);
+    dst += n;
+    offset += n;
+  }
+
+  free(buffer);
+}
+
+void ParallelFileReader::readSerial(void* dst, uint64_t offset,
+                                    uint64_t length) {
+  if (offset + length > fileSize) {
+    GALOIS_DIE("file too short: reading ", length, " bytes at offset ", offset,
+               " of a ", fileSize, " byte file");
+  }
+  auto start = std::chrono::steady_clock::now();
+  readBlock(dst, offset, length);
+  auto stop = std::chrono::steady_clock::now();
+  bytesRead += length;
+  readNanos +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+          .count();
+}
+
+void ParallelFileReader::read(void* _dst, uint64_t offset, uint64_t length) {
+  if (offset + length > fileSize) {
+    GALOIS_DIE("file too short: reading ", length, " bytes at offset ", offset,
+               " of a ", fileSize, " byte file");
+  }
+  if (!length)
+    return;
+
+  char* dst           = static_cast<char*>(_dst);
+  unsigned numThreads = galois::getActiveThreads();
+  if (length < minParallelRead)
+    numThreads = 1;
+
+  // Use the same split as largeMallocBlocked, which divides the length
+  // rounded up to the allocation size, so that each thread reads into the
+  // pages it faulted in.
+  uint64_t span = roundup(length, substrate::allocSize());
+
+  auto start = std::chrono::steady_clock::now();
+  auto body  = [&]() {
+    unsigned tid   = substrate::ThreadPool::getTID();
+    uint64_t begin = std::min(length, tid * span / numThreads);
+    uint64_t end   = std::min(length, (tid + 1) * span / numThreads);
+    if (begin >= end)
+      return;
+    if (directFd != -1)
+      readBlockDirect(dst + begin, offset + begin, end - begin);
+    else
+      readBlock(dst + begin, offset + begin, end - begin);
+  };
+  if (numThreads == 1)
+    body();
+  else
+    substrate::getThreadPool().run(numThreads, body);
+  auto stop = std::chrono::steady_clock::now();
+
+  bytesRead += length;
+  readNanos +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+          .count();
+}
+
+double ParallelFileReader::getThroughput() const {
+  if (!readNanos)
+    return 0;
+  // bytes per nanosecond is GB/s
+  return static_cast<double>(bytesRead) / readNanos;
+}
+
+void ParallelFileReader::reportStats(const std::string& region) const {
+  galois::runtime::reportStat_Single(region, "ReadBytes", bytesRead);
+  galois::runtime::reportStat_Single(region, "ReadTime", readNanos / 1000000);
+  galois::runtime::reportStat_Single(region, "ReadGBps", getThroughput());
+}
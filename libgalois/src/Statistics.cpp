@@ -19,7 +19,10 @@
 
 #include "galois/runtime/Statistics.h"
 #include "galois/runtime/Executor_OnEach.h"
+#include "galois/Version.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <fstream>
 
@@ -32,7 +35,8 @@ boost::uuids::uuid galois::runtime::getRandUUID(void) {
 
 using galois::gstl::Str;
 
-StatManager::StatManager(const std::string& outfile) : m_outfile(outfile) {}
+StatManager::StatManager(const std::string& outfile)
+    : m_outfile(outfile), m_format(StatFormat::TEXT) {}
 
 StatManager::~StatManager(void) {}
 
@@ -40,10 +44,16 @@ void StatManager::setStatFile(const std::string& outfile) {
   m_outfile = outfile;
 }
 
+void StatManager::setStatFormat(StatFormat format) { m_format = format; }
+
 void galois::runtime::setStatFile(const std::string& f) {
   internal::sysStatManager()->setStatFile(f);
 }
 
+void galois::runtime::setStatFormat(StatFormat format) {
+  internal::sysStatManager()->setStatFormat(format);
+}
+
 void galois::runtime::reportRUsage(const std::string& id) {
   // get rusage at this point in time
   struct rusage usage_stats;
@@ -81,6 +91,18 @@ void StatManager::print(void) {
 
 void StatManager::printStats(std::ostream& out) {
   mergeStats();
+
+  switch (m_format) {
+  case StatFormat::JSON:
+    printJSON(out);
+    return;
+  case StatFormat::CSV:
+    printCSV(out);
+    return;
+  default:
+    break;
+  }
+
   printHeader(out);
   intStats.print(out);
   fpStats.print(out);
@@ -94,6 +116,102 @@ void StatManager::printHeader(std::ostream& out) const {
   out << "\n";
 }
 
+void StatManager::printJSON(std::ostream& out) const {
+  out << "{\n  \"metadata\": {\"version\": ";
+  internal::printJSONValue(out, Str(galois::getVersion()));
+  out << ", \"revision\": ";
+  internal::printJSONValue(out, Str(galois::getRevision()));
+  out << ", \"threads\": " << galois::getActiveThreads() << "},";
+
+  out << "\n  \"stats\": [";
+  const char* sep = "";
+  intStats.printJSON(out, sep);
+  fpStats.printJSON(out, sep);
+  strStats.printJSON(out, sep);
+  out << "\n  ]\n}\n";
+}
+
+void StatManager::printCSV(std::ostream& out) const {
+  unsigned numThreads = std::max(
+      {intStats.numThreads(), fpStats.numThreads(), strStats.numThreads()});
+
+  out << "STAT_TYPE,REGION,CATEGORY,TOTAL_TYPE,TOTAL";
+  for (unsigned t = 0; t < numThreads; ++t) {
+    out << ",T" << t;
+  }
+  out << "\r\n";
+
+  // run metadata, as params of no region
+  auto meta = [&](const char* category, const Str& val) {
+    out << statKind<Str>() << ",(NULL)," << category << ","
+        << StatTotal::str(StatTotal::SINGLE) << ",";
+    internal::printCSVField(out, val);
+    out << std::string(numThreads, ',') << "\r\n";
+  };
+  meta("GaloisVersion", Str(galois::getVersion()));
+  meta("GaloisRevision", Str(galois::getRevision()));
+  meta("ActiveThreads", gstl::makeStr(galois::getActiveThreads()));
+
+  intStats.printCSV(out, numThreads);
+  fpStats.printCSV(out, numThreads);
+  strStats.printCSV(out, numThreads);
+}
+
+void galois::runtime::internal::printJSONValue(std::ostream& out, int64_t v) {
+  out << v;
+}
+
+void galois::runtime::internal::printJSONValue(std::ostream& out, double v) {
+  // JSON has no representation for NaN or infinity
+  if (std::isfinite(v)) {
+    out << v;
+  } else {
+    out << "null";
+  }
+}
+
+void galois::runtime::internal::printJSONValue(std::ostream& out,
+                                               const Str& v) {
+  static const char* const hex = "0123456789abcdef";
+
+  out << '"';
+  for (char c : v) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+void galois::runtime::internal::printCSVField(std::ostream& out, int64_t v) {
+  out << v;
+}
+
+void galois::runtime::internal::printCSVField(std::ostream& out, double v) {
+  out << v;
+}
+
+void galois::runtime::internal::printCSVField(std::ostream& out,
+                                              const Str& v) {
+  if (v.find_first_of(",\"\r\n") == Str::npos) {
+    out << v;
+    return;
+  }
+
+  out << '"';
+  for (char c : v) {
+    if (c == '"') {
+      out << '"';
+    }
+    out << c;
+  }
+  out << '"';
+}
+
 StatManager::int_iterator StatManager::intBegin(void) const {
   return intStats.cbegin();
 }
@@ -133,6 +251,31 @@ void galois::runtime::reportPageAlloc(const char* category) {
       std::make_tuple());
 }
 
+void galois::runtime::reportThreadPoolStats() {
+  auto& tp = substrate::getThreadPool();
+  substrate::ThreadPool::WaitStats total;
+  for (unsigned tid = 0; tid < tp.getMaxThreads(); ++tid) {
+    const auto& stats = tp.getWaitStats(tid);
+    total.wakeups += stats.wakeups;
+    total.parks += stats.parks;
+    total.spinNs += stats.spinNs;
+    total.wakeLatencyNs += stats.wakeLatencyNs;
+    total.maxWakeLatencyNs =
+        std::max(total.maxWakeLatencyNs, stats.maxWakeLatencyNs);
+  }
+  if (!total.wakeups) {
+    return;
+  }
+  reportStat_Single("ThreadPool", "Wakeups", total.wakeups);
+  reportStat_Single("ThreadPool", "Parks", total.parks);
+  // all in nanoseconds; the unit is part of the names since loop times are
+  // reported in milliseconds
+  reportStat_Single("ThreadPool", "SpinTimeNs", total.spinNs);
+  reportStat_Single("ThreadPool", "WakeLatencyNs",
+                    total.wakeLatencyNs / total.wakeups);
+  reportStat_Single("ThreadPool", "WakeLatencyMaxNs", total.maxWakeLatencyNs);
+}
+
 void galois::runtime::reportNumaAlloc(const char*) {
   galois::gWarn("reportNumaAlloc NOT IMPLEMENTED YET. TBD");
   int nodes = substrate::getThreadPool().getMaxNumaNodes();
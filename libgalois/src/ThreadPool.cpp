@@ -23,8 +23,16 @@
 #include "galois/gIO.h"
 
 #include <algorithm>
+#include <chrono>
+#include <climits>
 #include <iostream>
 
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 // Forward declare this to avoid including PerThreadStorage.
 // We avoid this to stress that the thread Pool MUST NOT depend on PTS.
 namespace galois::substrate {
@@ -37,9 +45,91 @@ using galois::substrate::ThreadPool;
 
 thread_local ThreadPool::per_signal ThreadPool::my_box;
 
+namespace {
+
+uint64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+#ifdef __linux__
+void futexWait(std::atomic<uint32_t>& word, uint32_t val) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE,
+          val, nullptr, nullptr, 0);
+}
+
+void futexWake(std::atomic<uint32_t>& word) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE,
+          1, nullptr, nullptr, 0);
+}
+#endif
+
+} // namespace
+
+void ThreadPool::per_signal::wakeup() {
+  done     = 0;
+  wakeTime = nowNs();
+  if (release.exchange(RELEASED) != PARKED) {
+    return;
+  }
+#ifdef __linux__
+  futexWake(release);
+#else
+  std::lock_guard<std::mutex> lg(m);
+  cv.notify_one();
+#endif
+}
+
+void ThreadPool::per_signal::wait(bool fastmode, uint64_t spinBudgetNs) {
+  uint64_t start = nowNs();
+  uint64_t now   = start;
+  bool parked    = false;
+  for (unsigned i = 1; release.load(std::memory_order_acquire) != RELEASED;
+       ++i) {
+    asmPause();
+    // reading the clock is slower than a pause
+    if (fastmode || i % 64) {
+      continue;
+    }
+    now = nowNs();
+    if (now - start < spinBudgetNs) {
+      continue;
+    }
+    uint32_t expected = IDLE;
+    if (release.compare_exchange_strong(expected, PARKED)) {
+      parked = true;
+#ifdef __linux__
+      while (release.load(std::memory_order_acquire) == PARKED) {
+        futexWait(release, PARKED);
+      }
+#else
+      std::unique_lock<std::mutex> lg(m);
+      cv.wait(lg, [this] { return release.load() != PARKED; });
+#endif
+    }
+  }
+  release.store(IDLE, std::memory_order_relaxed);
+
+  uint64_t woken = nowNs();
+  stats.wakeups += 1;
+  stats.spinNs += (parked ? now : woken) - start;
+  if (parked) {
+    stats.parks += 1;
+  }
+  if (woken > wakeTime) {
+    stats.wakeLatencyNs += woken - wakeTime;
+    stats.maxWakeLatencyNs = std::max(stats.maxWakeLatencyNs, woken - wakeTime);
+  }
+}
+
 ThreadPool::ThreadPool()
     : mi(getHWTopo().machineTopoInfo), reserved(0), masterFastmode(false),
-      running(false) {
+      running(false), spinBudgetNs(50 * 1000) {
+  int spinBudget;
+  if (EnvCheck("GALOIS_SPIN_BUDGET", spinBudget) && spinBudget >= 0) {
+    setSpinBudget(spinBudget);
+  }
   signals.resize(mi.maxThreads);
   initThread(0);
 
@@ -134,8 +224,8 @@ void ThreadPool::threadLoop(unsigned tid) {
   bool fastmode = false;
   auto& me      = my_box;
   do {
-    me.wait(fastmode);
-    cascade(fastmode);
+    me.wait(fastmode, spinBudgetNs.load(std::memory_order_relaxed));
+    cascade();
     try {
       work();
     } catch (const shutdown_ty&) {
@@ -176,7 +266,7 @@ void ThreadPool::decascade() {
   me.done = 1;
 }
 
-void ThreadPool::cascade(bool fastmode) {
+void ThreadPool::cascade() {
   auto& me = my_box;
   assert(me.wbegin <= me.wend);
 
@@ -190,13 +280,13 @@ void ThreadPool::cascade(bool fastmode) {
   auto child1    = signals[me.wbegin];
   child1->wbegin = me.wbegin + 1;
   child1->wend   = midpoint;
-  child1->wakeup(fastmode);
+  child1->wakeup();
 
   if (midpoint < me.wend) {
     auto child2    = signals[midpoint];
     child2->wbegin = midpoint + 1;
     child2->wend   = me.wend;
-    child2->wakeup(fastmode);
+    child2->wakeup();
   }
 }
 
@@ -213,7 +303,7 @@ void ThreadPool::runInternal(unsigned num) {
 
   assert(!masterFastmode || masterFastmode == num);
   // launch threads
-  cascade(masterFastmode);
+  cascade();
   // Do master thread work
   try {
     work();
@@ -242,7 +332,7 @@ void ThreadPool::runDedicated(std::function<void(void)>& f) {
   child->wbegin = 0;
   child->wend   = 0;
   child->done   = 0;
-  child->wakeup(masterFastmode);
+  child->wakeup();
   while (!child->done) {
     asmPause();
   }
@@ -0,0 +1,91 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/Reduction.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+//! Skewed work: a few iterations are much more expensive than the rest
+uint64_t work(unsigned i) {
+  unsigned n    = i % 1024 == 0 ? 20000 : 10;
+  uint64_t hash = i;
+  for (unsigned j = 0; j < n; ++j)
+    hash = hash * 6364136223846793005ULL + 1442695040888963407ULL;
+  return hash;
+}
+
+int main() {
+  const std::string filename = "adaptive-chunk-test.out";
+  const unsigned num         = 1 << 18;
+  {
+    galois::SharedMemSys Galois_runtime;
+    galois::setActiveThreads(
+        galois::substrate::getThreadPool().getMaxThreads());
+    galois::runtime::setStatFile(filename);
+
+    for (unsigned initial : {1u, 32u, 4096u}) {
+      galois::GAccumulator<uint64_t> count;
+      galois::GAccumulator<uint64_t> sum;
+      galois::do_all(
+          galois::iterate(0u, num),
+          [&](unsigned i) {
+            count += 1;
+            sum += i;
+            if (work(i) == 0)
+              count += 1;
+          },
+          galois::steal(), galois::chunk_size<>(initial),
+          galois::adaptive_chunk_size(), galois::loopname("adaptive-do_all"));
+      GALOIS_ASSERT(count.reduce() == num, count.reduce());
+      GALOIS_ASSERT(sum.reduce() == uint64_t(num) * (num - 1) / 2);
+    }
+
+    typedef galois::worklists::PerSocketChunkFIFO<64>::with_adaptive<true> WL;
+    galois::GAccumulator<uint64_t> count;
+    galois::for_each(
+        galois::iterate(0u, num / 2),
+        [&](unsigned i, auto& ctx) {
+          count += 1;
+          if (work(i) == 0)
+            count += 1;
+          if (i < num / 2)
+            ctx.push(i + num / 2);
+        },
+        galois::wl<WL>(), galois::disable_conflict_detection(),
+        galois::loopname("adaptive-for_each"));
+    GALOIS_ASSERT(count.reduce() == num, count.reduce());
+  }
+
+  std::ifstream in(filename);
+  GALOIS_ASSERT(in.good(), "stats not written");
+  std::stringstream ss;
+  ss << in.rdbuf();
+  std::remove(filename.c_str());
+  std::string stats = ss.str();
+  GALOIS_ASSERT(stats.find("adaptive-do_all, ChunkSize, TAVG") !=
+                std::string::npos);
+  GALOIS_ASSERT(stats.find("adaptive-for_each, ChunkSize, TAVG") !=
+                std::string::npos);
+
+  return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * Checks LC_Compressed_Graph against LC_CSR_Graph and compares their memory
+ * footprint and traversal throughput.
+ *
+ * Usage: unit-compressed-graph [log2 nodes] [avg degree] [rounds]
+ */
+
+#include "galois/Galois.h"
+#include "galois/Reduction.h"
+#include "galois/Timer.h"
+#include "galois/graphs/LCGraph.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+typedef galois::graphs::LC_CSR_Graph<int, int>::with_no_lockable<true>::type
+    CSRGraph;
+typedef galois::graphs::LC_Compressed_Graph<int, int>::with_no_lockable<
+    true>::type CompressedGraph;
+
+//! Power-law-ish graph with neighbors clustered around the source
+void makeGraph(galois::graphs::FileGraph& out, uint32_t numNodes,
+               uint32_t avgDegree) {
+  std::mt19937 gen(numNodes);
+  std::geometric_distribution<uint32_t> degreeDist(1.0 / avgDegree);
+  std::geometric_distribution<int64_t> distanceDist(0.01);
+  std::uniform_int_distribution<uint32_t> farDist(0, numNodes - 1);
+  std::bernoulli_distribution isFar(0.1);
+
+  std::vector<std::vector<uint32_t>> adj(numNodes);
+  size_t numEdges = 0;
+  for (uint32_t n = 0; n < numNodes; ++n) {
+    uint32_t d = std::min(degreeDist(gen), numNodes);
+    for (uint32_t i = 0; i < d; ++i) {
+      int64_t dst = isFar(gen) ? farDist(gen) : n + distanceDist(gen);
+      adj[n].push_back(dst % numNodes);
+    }
+    numEdges += d;
+  }
+
+  galois::graphs::FileGraphWriter w;
+  w.setNumNodes(numNodes);
+  w.setNumEdges<int>(numEdges);
+  w.phase1();
+  for (uint32_t n = 0; n < numNodes; ++n)
+    w.incrementDegree(n, adj[n].size());
+  w.phase2();
+  for (uint32_t n = 0; n < numNodes; ++n)
+    for (uint32_t dst : adj[n])
+      w.addNeighbor<int>(n, dst, dst ^ n);
+  w.finish();
+  out = std::move(w);
+}
+
+template <typename Graph>
+void check(CSRGraph& csr, Graph& g) {
+  if (csr.size() != g.size() || csr.sizeEdges() != g.sizeEdges())
+    GALOIS_DIE("size mismatch");
+
+  galois::do_all(galois::iterate(csr), [&](CSRGraph::GraphNode n) {
+    auto cc = csr.edge_begin(n);
+    for (auto e : g.edges(n)) {
+      if (csr.getEdgeDst(cc) != g.getEdgeDst(e))
+        GALOIS_DIE("destination mismatch at node ", n);
+      if (g.getEdgeData(e) != static_cast<int>(g.getEdgeDst(e) ^ n))
+        GALOIS_DIE("edge data mismatch at node ", n);
+      if (g.getEdgeDst(g.findEdge(n, g.getEdgeDst(e))) != g.getEdgeDst(e))
+        GALOIS_DIE("findEdge failed at node ", n);
+      ++cc;
+    }
+    if (cc != csr.edge_end(n) || g.getDegree(n) != csr.getDegree(n))
+      GALOIS_DIE("degree mismatch at node ", n);
+  });
+}
+
+template <typename Graph>
+long traverse(Graph& g, unsigned rounds, uint64_t& result) {
+  galois::GAccumulator<uint64_t> sum;
+  galois::Timer t;
+  t.start();
+  for (unsigned r = 0; r < rounds; ++r) {
+    galois::do_all(
+        galois::iterate(g),
+        [&](typename Graph::GraphNode n) {
+          uint64_t local = 0;
+          for (auto e : g.edges(n, galois::MethodFlag::UNPROTECTED))
+            local += g.getEdgeDst(e);
+          sum += local;
+        },
+        galois::steal(), galois::no_stats());
+  }
+  t.stop();
+  result = sum.reduce();
+  return t.get();
+}
+
+int main(int argc, char** argv) {
+  galois::SharedMemSys Galois_runtime;
+  unsigned scale     = argc > 1 ? atoi(argv[1]) : 16;
+  unsigned avgDegree = argc > 2 ? atoi(argv[2]) : 16;
+  unsigned rounds    = argc > 3 ? atoi(argv[3]) : 10;
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+
+  galois::graphs::FileGraph f;
+  makeGraph(f, 1u << scale, avgDegree);
+
+  CSRGraph csr;
+  CompressedGraph g;
+  galois::graphs::readGraph(csr, f);
+  galois::graphs::readGraph(g, f);
+  csr.sortAllEdgesByDst(galois::MethodFlag::UNPROTECTED);
+  check(csr, g);
+
+  // round trip through a compressed graph file
+  std::string filename = "compressed-graph.test";
+  g.writeToCompressedFile(filename);
+  CompressedGraph reread;
+  galois::graphs::readGraph(reread, filename);
+  std::remove(filename.c_str());
+  check(csr, reread);
+
+  size_t csrBytes = csr.sizeEdges() * sizeof(uint32_t) +
+                    csr.size() * sizeof(uint64_t);
+  size_t compressedBytes = g.sizeTopologyBytes() + g.size() * sizeof(uint64_t);
+
+  uint64_t csrSum, compressedSum;
+  long csrTime        = traverse(csr, rounds, csrSum);
+  long compressedTime = traverse(g, rounds, compressedSum);
+  if (csrSum != compressedSum)
+    GALOIS_DIE("traversal mismatch");
+
+  double edges = static_cast<double>(csr.sizeEdges()) * rounds;
+  printf("nodes %zu edges %zu\n", csr.size(), csr.sizeEdges());
+  printf("csr topology bytes %zu (%.2f bytes/edge) %.1f Medges/s\n", csrBytes,
+         static_cast<double>(csrBytes) / csr.sizeEdges(),
+         edges / (csrTime + 1) / 1e3);
+  printf("compressed topology bytes %zu (%.2f bytes/edge) %.1f Medges/s\n",
+         compressedBytes, static_cast<double>(compressedBytes) / g.sizeEdges(),
+         edges / (compressedTime + 1) / 1e3);
+
+  return 0;
+}
@@ -0,0 +1,105 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * Measures the cost of aborting iterations of for_each under heavy
+ * contention, with conflicts signalled by the default mechanism (exception
+ * or longjmp) and with the flag_conflicts trait.
+ *
+ * Usage: conflict-abort [numItems] [numLocks]
+ */
+
+#include "galois/Galois.h"
+#include "galois/Reduction.h"
+#include "galois/Timer.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+struct Cell : public galois::runtime::Lockable {
+  unsigned count = 0;
+};
+
+static const unsigned neighborhoodSize = 4;
+
+template <bool Flag>
+void run(unsigned numItems, std::vector<Cell>& cells) {
+  for (auto& c : cells)
+    c.count = 0;
+  galois::GAccumulator<size_t> runs;
+
+  auto fn = [&](unsigned item, galois::UserContext<unsigned>& ctx) {
+    runs += 1;
+    for (unsigned k = 0; k < neighborhoodSize; ++k) {
+      Cell& c = cells[(item * 7 + k * 13) % cells.size()];
+      galois::runtime::acquire(&c, galois::MethodFlag::WRITE);
+    }
+    if (Flag && ctx.isConflicted())
+      return;
+    for (unsigned k = 0; k < neighborhoodSize; ++k)
+      cells[(item * 7 + k * 13) % cells.size()].count += 1;
+  };
+
+  galois::Timer t;
+  t.start();
+  if (Flag) {
+    galois::for_each(galois::iterate(0u, numItems), fn,
+                     galois::flag_conflicts(), galois::no_pushes(),
+                     galois::no_stats());
+  } else {
+    galois::for_each(galois::iterate(0u, numItems), fn, galois::no_pushes(),
+                     galois::no_stats());
+  }
+  t.stop();
+
+  size_t total = 0;
+  for (auto& c : cells)
+    total += c.count;
+  GALOIS_ASSERT(total == size_t(numItems) * neighborhoodSize);
+
+  size_t aborts = runs.reduce() - numItems;
+  std::cout << (Flag ? "flag" : "default") << ": " << t.get_usec()
+            << " us, aborts: " << aborts;
+  if (aborts)
+    std::cout << ", us/abort: " << double(t.get_usec()) / aborts;
+  std::cout << "\n";
+}
+
+int main(int argc, char** argv) {
+  galois::SharedMemSys Galois_runtime;
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+
+  unsigned numItems = 100000;
+  unsigned numLocks = 16;
+  if (argc > 1)
+    numItems = atoi(argv[1]);
+  if (argc > 2)
+    numLocks = atoi(argv[2]);
+  if (numLocks < neighborhoodSize)
+    numLocks = neighborhoodSize;
+
+  std::vector<Cell> cells(numLocks);
+  std::cout << "threads: " << galois::getActiveThreads()
+            << " items: " << numItems << " locks: " << numLocks << "\n";
+  run<false>(numItems, cells);
+  run<true>(numItems, cells);
+
+  return 0;
+}
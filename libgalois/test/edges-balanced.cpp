@@ -0,0 +1,168 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/Reduction.h"
+#include "galois/graphs/LCGraph.h"
+#include "galois/graphs/LC_CSR_CSC_Graph.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+typedef galois::graphs::LC_CSR_Graph<uint64_t, void>::with_no_lockable<
+    true>::type Graph;
+typedef Graph::GraphNode GNode;
+typedef Graph::edge_iterator EI;
+typedef galois::graphs::LC_CSR_CSC_Graph<uint64_t, void, false, true> BiGraph;
+
+//! Random graph with a few hubs, some isolated nodes and a zero-degree tail
+void makeGraph(const std::string& filename, uint32_t numNodes) {
+  std::mt19937 gen(numNodes);
+  std::uniform_int_distribution<uint32_t> dist(0, numNodes - 1);
+  std::vector<std::vector<uint32_t>> adj(numNodes);
+  for (uint32_t n = 0; n < numNodes - 10; ++n) {
+    uint32_t degree = n % 1000 == 0 ? numNodes / 2 : (n % 3 == 0 ? 0 : 4);
+    for (uint32_t i = 0; i < degree; ++i)
+      adj[n].push_back(dist(gen));
+  }
+
+  uint64_t numEdges = 0;
+  for (auto& s : adj)
+    numEdges += s.size();
+
+  galois::graphs::FileGraphWriter w;
+  w.setNumNodes(numNodes);
+  w.setNumEdges<void>(numEdges);
+  w.phase1();
+  for (uint32_t n = 0; n < numNodes; ++n)
+    w.incrementDegree(n, adj[n].size());
+  w.phase2();
+  for (uint32_t n = 0; n < numNodes; ++n)
+    for (auto dst : adj[n])
+      w.addNeighbor(n, dst);
+  w.finish();
+  w.toFile(filename);
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+
+  const std::string filename = "edges-balanced-test.gr";
+  makeGraph(filename, 10000);
+  Graph g;
+  galois::graphs::readGraph(g, filename);
+  BiGraph bg;
+  bg.readAndConstructBiGraphFromGRFile(filename);
+  std::remove(filename.c_str());
+
+  std::vector<uint64_t> expected(g.size());
+  for (auto n : g)
+    for (auto e : g.edges(n))
+      expected[n] += g.getEdgeDst(e);
+
+  for (uint64_t blockSize : {1, 7, 64, 1024, 1 << 20}) {
+    // every edge is visited once, and every node at least once
+    galois::GAccumulator<uint64_t> edges;
+    galois::do_all(
+        galois::iterate_edges_balanced(g, blockSize),
+        [&](GNode n, EI ii, EI ei) {
+          g.getData(n) = 1;
+          edges += std::distance(ii, ei);
+        });
+    GALOIS_ASSERT(edges.reduce() == g.sizeEdges(), edges.reduce());
+    for (auto n : g) {
+      GALOIS_ASSERT(g.getData(n) == 1);
+      g.getData(n) = 0;
+    }
+
+    // the slices of a split adjacency list are combined before the hook
+    // sees them, exactly once per node
+    galois::GAccumulator<uint64_t> finished;
+    galois::do_all(
+        galois::iterate_edges_balanced(g, blockSize),
+        [&](GNode, EI ii, EI ei) {
+          uint64_t sum = 0;
+          for (; ii != ei; ++ii)
+            sum += g.getEdgeDst(ii);
+          return sum;
+        },
+        galois::edge_reduce([&](GNode n, uint64_t sum) {
+          g.getData(n) += sum;
+          finished += 1;
+        }),
+        galois::steal(), galois::loopname("edges-balanced"));
+    GALOIS_ASSERT(finished.reduce() == g.size(), finished.reduce());
+    for (auto n : g) {
+      GALOIS_ASSERT(g.getData(n) == expected[n], n);
+      g.getData(n) = 0;
+    }
+  }
+
+  // slices are combined in edge order: a combine that is not associative
+  // gives the same result as folding the slices of each node sequentially
+  for (uint64_t blockSize : {1, 7, 64}) {
+    auto combine = [](uint64_t a, uint64_t b) { return a * 1000003 + b + 1; };
+    auto sliceValue = [&](EI ii, EI ei) {
+      uint64_t sum = 0;
+      for (; ii != ei; ++ii)
+        sum = sum * 31 + g.getEdgeDst(ii);
+      return sum;
+    };
+    galois::runtime::EdgeBalancedRange<Graph> range(g, blockSize);
+    std::vector<uint64_t> folded(g.size());
+    for (uint64_t k = 0; k < range.numBlocks(); ++k)
+      range.for_each_in_block(k, [&](GNode n, EI ii, EI ei, bool split) {
+        folded[n] = split && k != range.firstBlock(n)
+                        ? combine(folded[n], sliceValue(ii, ei))
+                        : sliceValue(ii, ei);
+      });
+
+    for (int rep = 0; rep < 3; ++rep) {
+      galois::do_all(
+          galois::iterate_edges_balanced(g, blockSize),
+          [&](GNode, EI ii, EI ei) { return sliceValue(ii, ei); },
+          galois::edge_reduce(
+              [&](GNode n, uint64_t v) { GALOIS_ASSERT(v == folded[n], n); },
+              combine),
+          galois::steal());
+    }
+  }
+
+  // in-edges: count the in-degree of every node
+  galois::do_all(
+      galois::iterate_in_edges_balanced(bg, 64),
+      [&](GNode n, auto ii, auto ei) {
+        static_assert(std::is_same<decltype(ii),
+                                   decltype(bg.in_edge_begin(n))>::value,
+                      "in-edge ranges must pass in-edge iterators");
+        return uint64_t(std::distance(ii, ei));
+      },
+      galois::edge_reduce([&](GNode n, uint64_t d) { bg.getData(n) = d; }),
+      galois::steal());
+  std::vector<uint64_t> inDegree(g.size());
+  for (auto n : g)
+    for (auto e : g.edges(n))
+      ++inDegree[g.getEdgeDst(e)];
+  for (auto n : bg)
+    GALOIS_ASSERT(bg.getData(n) == inDegree[n], n);
+
+  return 0;
+}
@@ -0,0 +1,105 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/substrate/EventTrace.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+size_t count(const std::string& s, const std::string& pattern) {
+  size_t n = 0;
+  for (size_t pos = s.find(pattern); pos != std::string::npos;
+       pos     = s.find(pattern, pos + 1))
+    ++n;
+  return n;
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+
+  const std::string filename = "event-trace-test.json";
+  std::remove(filename.c_str());
+
+  galois::for_each(
+      galois::iterate(0, 1000),
+      [](int i, auto& ctx) {
+        if (i < 500)
+          ctx.push(i + 1000);
+      },
+      galois::loopname("trace \"for_each\""));
+  galois::do_all(
+      galois::iterate(0, 1000), [](int) {}, galois::steal(),
+      galois::loopname("trace-do_all"));
+
+  galois::substrate::writeEventTrace(filename);
+
+  std::ifstream in(filename);
+#ifdef GALOIS_ENABLE_EVENT_TRACE
+  GALOIS_ASSERT(in.good(), "trace not written");
+  std::stringstream ss;
+  ss << in.rdbuf();
+  std::string trace = ss.str();
+
+  GALOIS_ASSERT(trace.find("{\"traceEvents\":[") == 0);
+  GALOIS_ASSERT(
+      count(trace, "\"name\":\"trace \\\"for_each\\\"\",\"ph\":\"B\"") > 0);
+  GALOIS_ASSERT(count(trace, "\"name\":\"trace-do_all\",\"ph\":\"B\"") ==
+                count(trace, "\"name\":\"trace-do_all\",\"ph\":\"E\""));
+  GALOIS_ASSERT(count(trace, "\"ph\":\"B\"") == count(trace, "\"ph\":\"E\""));
+  GALOIS_ASSERT(count(trace, "\"name\":\"push\"") > 0);
+  GALOIS_ASSERT(count(trace, "\"name\":\"pop\"") +
+                    count(trace, "\"name\":\"steal\"") >
+                0);
+  std::remove(filename.c_str());
+
+  // enough loops to wrap every ring buffer; the oldest surviving records
+  // end spans whose beginnings were overwritten
+  for (int i = 0; i < 40000; ++i)
+    galois::do_all(
+        galois::iterate(0, 1), [](int) {}, galois::loopname("trace-wrap"));
+  // names are copied, so a buffer reused for another name is not mixed up
+  char name[16];
+  std::strcpy(name, "trace-alpha");
+  galois::do_all(
+      galois::iterate(0, 1000), [](int) {}, galois::loopname(name));
+  std::strcpy(name, "trace-beta");
+  galois::do_all(
+      galois::iterate(0, 1000), [](int) {}, galois::loopname(name));
+
+  galois::substrate::writeEventTrace(filename);
+  std::ifstream wrapped(filename);
+  GALOIS_ASSERT(wrapped.good(), "trace not written");
+  ss.str("");
+  ss << wrapped.rdbuf();
+  trace = ss.str();
+  GALOIS_ASSERT(count(trace, "\"ph\":\"B\"") == count(trace, "\"ph\":\"E\""));
+  GALOIS_ASSERT(count(trace, "\"name\":\"trace-alpha\",\"ph\":\"B\"") > 0);
+  GALOIS_ASSERT(count(trace, "\"name\":\"trace-beta\",\"ph\":\"B\"") > 0);
+  std::remove(filename.c_str());
+#else
+  GALOIS_ASSERT(!in.good(), "trace written while tracing is compiled out");
+#endif
+
+  return 0;
+}
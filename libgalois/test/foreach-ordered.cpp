@@ -0,0 +1,107 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+
+#include <random>
+#include <vector>
+
+struct Object : public galois::runtime::Lockable {
+  std::vector<int> history;
+};
+
+struct Event {
+  int time;
+  int a;
+  int b;
+  int depth;
+};
+
+/**
+ * Runs events that each touch two objects and checks that every object saw
+ * its events in time order. Follow-up events either touch the same objects
+ * (stable sources) or random ones (unstable sources).
+ */
+template <typename Cmp>
+void test(int numEvents, int depth, bool stable, const Cmp& cmp) {
+  const int numObjects = 64;
+  std::vector<Object> objects(numObjects);
+
+  std::mt19937 gen(numEvents);
+  std::uniform_int_distribution<int> time(0, 10000);
+  std::uniform_int_distribution<int> obj(0, numObjects - 1);
+  std::vector<Event> events;
+  for (int i = 0; i < numEvents; ++i) {
+    int a = obj(gen);
+    events.push_back(Event{time(gen), a, (a + 1 + obj(gen) % 63) % numObjects,
+                           depth});
+  }
+
+  auto nhFunc = [&](const Event& e) {
+    galois::runtime::acquire(&objects[e.a], galois::MethodFlag::WRITE);
+    galois::runtime::acquire(&objects[e.b], galois::MethodFlag::WRITE);
+  };
+
+  auto opFunc = [&](const Event& e, galois::UserContext<Event>& ctx) {
+    for (int o : {e.a, e.b}) {
+      std::vector<int>& h = objects[o].history;
+      GALOIS_ASSERT(h.empty() || h.back() <= e.time, "out of order");
+      h.push_back(e.time);
+    }
+    if (e.depth == 0)
+      return;
+    int t = e.time + 1 + e.time % 7;
+    if (stable) {
+      ctx.push(Event{t, e.a, e.b, e.depth - 1});
+    } else {
+      int a = (e.a * 31 + e.time) % numObjects;
+      ctx.push(Event{t, a, (a + 1 + e.b) % numObjects, e.depth - 1});
+    }
+  };
+
+  if (stable) {
+    galois::for_each_ordered(events.begin(), events.end(), cmp, nhFunc,
+                             opFunc);
+  } else {
+    // no source is known to be stable; only the earliest event may run
+    galois::for_each_ordered(events.begin(), events.end(), cmp, nhFunc,
+                             opFunc, [](const Event&) { return false; });
+  }
+
+  size_t total = 0;
+  for (auto& o : objects)
+    total += o.history.size();
+  GALOIS_ASSERT(total == size_t(2 * numEvents * (depth + 1)));
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+
+  auto less = [](const Event& x, const Event& y) { return x.time < y.time; };
+  auto lessEq = [](const Event& x, const Event& y) {
+    return x.time <= y.time;
+  };
+
+  test(20000, 3, true, less);
+  test(20000, 3, true, lessEq);
+  test(1000, 2, false, less);
+
+  return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/graphs/LCGraph.h"
+
+#include <cstdio>
+#include <random>
+
+typedef galois::graphs::LC_CSR_Graph<int, int>::with_no_lockable<true>::type
+    Graph;
+
+void makeGraph(const std::string& filename, uint32_t numNodes,
+               uint64_t numEdges) {
+  std::mt19937 gen(numNodes);
+  std::uniform_int_distribution<uint32_t> dist(0, numNodes - 1);
+  std::vector<uint32_t> srcs(numEdges);
+  std::vector<uint32_t> dsts(numEdges);
+
+  galois::graphs::FileGraphWriter w;
+  w.setNumNodes(numNodes);
+  w.setNumEdges<int>(numEdges);
+  w.phase1();
+  for (uint64_t e = 0; e < numEdges; ++e) {
+    srcs[e] = dist(gen);
+    dsts[e] = dist(gen);
+    w.incrementDegree(srcs[e]);
+  }
+  w.phase2();
+  for (uint64_t e = 0; e < numEdges; ++e)
+    w.addNeighbor<int>(srcs[e], dsts[e], e);
+  w.finish();
+  w.toFile(filename);
+}
+
+void check(Graph& expected, Graph& g) {
+  GALOIS_ASSERT(expected.size() == g.size());
+  GALOIS_ASSERT(expected.sizeEdges() == g.sizeEdges());
+  for (auto n : expected) {
+    GALOIS_ASSERT(*expected.edge_end(n) == *g.edge_end(n));
+    for (auto e : expected.edges(n)) {
+      GALOIS_ASSERT(expected.getEdgeDst(e) == g.getEdgeDst(e));
+      GALOIS_ASSERT(expected.getEdgeData(e) == g.getEdgeData(e));
+    }
+  }
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+
+  // odd number of edges to exercise version 1 padding
+  std::string filename = "graph-mmap.gr";
+  makeGraph(filename, 1000, 10001);
+
+  Graph expected;
+  galois::graphs::readGraph(expected, filename);
+
+  Graph shared;
+  shared.mapGraphFromGRFile(filename, true);
+  check(expected, shared);
+
+  // private mappings are copy-on-write; modifying them must not change the
+  // file
+  Graph priv;
+  priv.mapGraphFromGRFile(filename);
+  check(expected, priv);
+  for (auto n : priv)
+    priv.getData(n) = n;
+  priv.sortAllEdgesByDst();
+  expected.sortAllEdgesByDst();
+  check(expected, priv);
+
+  Graph reread;
+  reread.mapGraphFromGRFile(filename, true);
+  check(shared, reread);
+
+  std::remove(filename.c_str());
+  return 0;
+}
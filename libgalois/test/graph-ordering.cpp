@@ -0,0 +1,200 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/graphs/FileGraph.h"
+#include "galois/graphs/GraphOrdering.h"
+#include "galois/graphs/LCGraph.h"
+
+#include <random>
+#include <vector>
+
+typedef galois::graphs::FileGraph Graph;
+typedef galois::LargeArray<uint32_t> Permutation;
+typedef galois::graphs::LC_CSR_Graph<uint32_t, uint64_t>::with_no_lockable<
+    true>::type::with_file_edge_data<void>::type LCGraph;
+
+//! Symmetric 2D grid with randomly shuffled node ids plus a few hubs
+void makeGraph(Graph& out, uint32_t side, uint32_t numHubs) {
+  uint32_t numNodes = side * side;
+  std::vector<uint32_t> ids(numNodes);
+  for (uint32_t i = 0; i < numNodes; ++i)
+    ids[i] = i;
+  std::mt19937 gen(side);
+  std::shuffle(ids.begin(), ids.end(), gen);
+
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  auto addEdge = [&](uint32_t a, uint32_t b) {
+    edges.emplace_back(a, b);
+    edges.emplace_back(b, a);
+  };
+  for (uint32_t r = 0; r < side; ++r) {
+    for (uint32_t c = 0; c < side; ++c) {
+      if (c + 1 < side)
+        addEdge(ids[r * side + c], ids[r * side + c + 1]);
+      if (r + 1 < side)
+        addEdge(ids[r * side + c], ids[(r + 1) * side + c]);
+    }
+  }
+  std::uniform_int_distribution<uint32_t> dist(0, numNodes - 1);
+  for (uint32_t h = 0; h < numHubs; ++h)
+    for (uint32_t i = 0; i < side; ++i)
+      addEdge(ids[h], dist(gen));
+
+  galois::graphs::FileGraphWriter w;
+  w.setNumNodes(numNodes);
+  w.setNumEdges<void>(edges.size());
+  w.phase1();
+  for (auto& e : edges)
+    w.incrementDegree(e.first);
+  w.phase2();
+  for (auto& e : edges)
+    w.addNeighbor(e.first, e.second);
+  w.finish();
+  out = std::move(w);
+}
+
+void checkPermutation(const Permutation& perm) {
+  std::vector<bool> seen(perm.size(), false);
+  for (auto p : perm) {
+    GALOIS_ASSERT(p < perm.size() && !seen[p]);
+    seen[p] = true;
+  }
+}
+
+//! Average |perm[src] - perm[dst]| over all edges
+double averageGap(Graph& g, const Permutation& perm) {
+  double sum = 0;
+  for (auto n : g)
+    for (auto e : g.edges(n))
+      sum += std::abs(static_cast<double>(perm[n]) -
+                      perm[g.getEdgeDst(e)]);
+  return sum / g.sizeEdges();
+}
+
+template <typename OrderFn>
+void checkOrdering(Graph& g, OrderFn orderFn, bool checkGap) {
+  Permutation identity;
+  identity.create(g.size());
+  for (uint32_t i = 0; i < g.size(); ++i)
+    identity[i] = i;
+
+  Permutation serial, parallel;
+  serial.create(g.size());
+  parallel.create(g.size());
+  galois::setActiveThreads(1);
+  orderFn(g, serial);
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+  orderFn(g, parallel);
+
+  checkPermutation(serial);
+  GALOIS_ASSERT(std::equal(serial.begin(), serial.end(), parallel.begin()),
+                "ordering depends on the number of threads");
+  if (checkGap)
+    GALOIS_ASSERT(averageGap(g, serial) < averageGap(g, identity) / 4,
+                  "ordering did not improve locality");
+}
+
+//! Relabels an in-memory graph and checks it against the original
+template <typename RelabelFn>
+void checkRelabel(Graph& f, RelabelFn relabelFn) {
+  LCGraph g, orig;
+  galois::graphs::readGraph(g, f);
+  galois::graphs::readGraph(orig, f);
+  for (auto n : g) {
+    g.getData(n) = n;
+    for (auto e : g.edges(n))
+      g.getEdgeData(e) = (uint64_t{n} << 32) | g.getEdgeDst(e);
+  }
+
+  galois::graphs::NodeRelabeling relabeling;
+  GALOIS_ASSERT(relabeling.isIdentity() && relabeling.toNew(7) == 7);
+  relabelFn(g, relabeling);
+  checkPermutation(relabeling.getOldToNew());
+
+  GALOIS_ASSERT(g.size() == orig.size() && g.sizeEdges() == orig.sizeEdges());
+  for (auto n : orig) {
+    uint32_t m = relabeling.toNew(n);
+    GALOIS_ASSERT(relabeling.toOld(m) == n);
+    GALOIS_ASSERT(g.getData(m) == n);
+    GALOIS_ASSERT(g.getDegree(m) == orig.getDegree(n));
+    auto ee = g.edge_begin(m);
+    for (auto e : orig.edges(n)) {
+      uint32_t dst = orig.getEdgeDst(e);
+      GALOIS_ASSERT(g.getEdgeDst(ee) == relabeling.toNew(dst));
+      GALOIS_ASSERT(g.getEdgeData(ee) == ((uint64_t{n} << 32) | dst));
+      ++ee;
+    }
+  }
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+
+  Graph g, hubs;
+  makeGraph(g, 200, 0);
+  makeGraph(hubs, 100, 4);
+
+  checkOrdering(
+      g, [](Graph& g, Permutation& p) { galois::graphs::rcmOrder(g, p); },
+      true);
+  checkOrdering(
+      g, [](Graph& g, Permutation& p) { galois::graphs::gorderOrder(g, p); },
+      true);
+  checkOrdering(
+      hubs, [](Graph& g, Permutation& p) { galois::graphs::rcmOrder(g, p); },
+      false);
+  checkOrdering(
+      hubs,
+      [](Graph& g, Permutation& p) { galois::graphs::gorderOrder(g, p); },
+      false);
+  checkOrdering(
+      hubs,
+      [](Graph& g, Permutation& p) { galois::graphs::degreeGroupOrder(g, p); },
+      false);
+
+  checkRelabel(g, [](LCGraph& g, galois::graphs::NodeRelabeling& r) {
+    galois::graphs::relabelByRCM(g, r);
+  });
+  checkRelabel(hubs, [](LCGraph& g, galois::graphs::NodeRelabeling& r) {
+    galois::graphs::relabelByDegree(g, r);
+    for (uint32_t n = 1; n < g.size(); ++n)
+      GALOIS_ASSERT(g.getDegree(n - 1) >= g.getDegree(n));
+  });
+
+  // hubs come first and the remaining nodes keep their relative order
+  Permutation perm;
+  perm.create(hubs.size());
+  galois::graphs::degreeGroupOrder(hubs, perm, 2);
+  double avgDegree = static_cast<double>(hubs.sizeEdges()) / hubs.size();
+  uint32_t lastLow = 0;
+  bool first       = true;
+  for (auto n : hubs) {
+    bool hub = std::distance(hubs.edge_begin(n), hubs.edge_end(n)) >= avgDegree;
+    if (hub) {
+      GALOIS_ASSERT(perm[n] < 4 * 100);
+    } else {
+      GALOIS_ASSERT(first || perm[n] > lastLow);
+      lastLow = perm[n];
+      first   = false;
+    }
+  }
+
+  return 0;
+}
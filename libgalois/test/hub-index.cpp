@@ -0,0 +1,174 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/graphs/LCGraph.h"
+
+#include <cstdio>
+#include <random>
+#include <set>
+#include <vector>
+
+typedef galois::graphs::LC_CSR_Graph<void, void>::with_no_lockable<true>::type
+    Graph;
+
+//! Random graph in which the first few nodes have most of the edges
+std::vector<std::set<uint32_t>> makeGraph(const std::string& filename,
+                                          uint32_t numNodes) {
+  std::mt19937 gen(numNodes);
+  std::uniform_int_distribution<uint32_t> dist(0, numNodes - 1);
+  std::vector<std::set<uint32_t>> adj(numNodes);
+  for (uint32_t n = 0; n < numNodes; ++n) {
+    uint32_t degree = n < 8 ? numNodes / (n + 2) : 5;
+    for (uint32_t i = 0; i < degree; ++i)
+      adj[n].insert(dist(gen));
+  }
+
+  uint64_t numEdges = 0;
+  for (auto& s : adj)
+    numEdges += s.size();
+
+  galois::graphs::FileGraphWriter w;
+  w.setNumNodes(numNodes);
+  w.setNumEdges<void>(numEdges);
+  w.phase1();
+  for (uint32_t n = 0; n < numNodes; ++n)
+    w.incrementDegree(n, adj[n].size());
+  w.phase2();
+  for (uint32_t n = 0; n < numNodes; ++n)
+    for (auto dst : adj[n])
+      w.addNeighbor(n, dst);
+  w.finish();
+  w.toFile(filename);
+  return adj;
+}
+
+void check(Graph& g, const std::vector<std::set<uint32_t>>& adj) {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<uint32_t> dist(0, g.size() - 1);
+  for (int i = 0; i < 20000; ++i) {
+    // bias towards the hubs
+    uint32_t u = (i % 4 == 0) ? i % 8 : dist(gen);
+    uint32_t v = (i % 3 == 0) ? (i / 3) % 8 : dist(gen);
+    GALOIS_ASSERT(g.hasEdge(u, v) == (adj[u].count(v) == 1));
+
+    uint64_t common = 0;
+    for (auto x : adj[u])
+      common += adj[v].count(x);
+    GALOIS_ASSERT(g.countCommonNeighbors(u, v) == common);
+  }
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+
+  std::string filename = "hub-index.gr";
+  uint32_t numNodes    = 5000;
+  auto adj             = makeGraph(filename, numNodes);
+
+  Graph g;
+  galois::graphs::readGraph(g, filename);
+  GALOIS_ASSERT(g.getHubIndex().empty());
+  check(g, adj);
+
+  // room for every candidate
+  g.buildHubIndex(100, UINT64_C(1) << 30);
+  GALOIS_ASSERT(g.getHubIndex().size() == 8);
+  for (uint32_t n = 0; n < numNodes; ++n)
+    GALOIS_ASSERT(g.getHubIndex().isHub(n) == (n < 8));
+  check(g, adj);
+
+  // room for the three largest hubs only
+  uint64_t bitmapBytes = (numNodes + 63) / 64 * sizeof(uint64_t);
+  g.buildHubIndex(100, numNodes * sizeof(uint32_t) + 3 * bitmapBytes);
+  GALOIS_ASSERT(g.getHubIndex().size() == 3);
+  GALOIS_ASSERT(g.getHubIndex().isHub(0) && g.getHubIndex().isHub(2));
+  GALOIS_ASSERT(!g.getHubIndex().isHub(3));
+  check(g, adj);
+
+  // too small for anything
+  g.buildHubIndex(100, numNodes);
+  GALOIS_ASSERT(g.getHubIndex().empty());
+  check(g, adj);
+
+  g.clearHubIndex();
+  GALOIS_ASSERT(g.getHubIndex().memoryUsage() == 0);
+
+  // the index follows its graph through swap
+  std::string smallFile = "hub-index-small.gr";
+  uint32_t smallNodes   = 500;
+  auto smallAdj         = makeGraph(smallFile, smallNodes);
+  g.buildHubIndex(10, UINT64_C(1) << 30);
+  GALOIS_ASSERT(!g.getHubIndex().empty());
+  Graph small;
+  galois::graphs::readGraph(small, smallFile);
+  swap(g, small);
+  GALOIS_ASSERT(g.getHubIndex().empty());
+  GALOIS_ASSERT(!small.getHubIndex().empty());
+  check(g, smallAdj);
+  check(small, adj);
+
+  // reloading drops the index of the old graph
+  small.mapGraphFromGRFile(smallFile);
+  GALOIS_ASSERT(small.getHubIndex().empty());
+  check(small, smallAdj);
+  small.buildHubIndex(10, UINT64_C(1) << 30);
+  galois::graphs::readGraph(small, filename);
+  GALOIS_ASSERT(small.getHubIndex().empty());
+  check(small, adj);
+
+  // nodes with repeated neighbors are not indexed, and repeated elements are
+  // counted like the intersection kernels count them
+  std::string dupFile = "hub-index-dup.gr";
+  {
+    galois::graphs::FileGraphWriter w;
+    w.setNumNodes(200);
+    w.setNumEdges<void>(4 * 150);
+    w.phase1();
+    for (uint32_t n = 0; n < 4; ++n)
+      w.incrementDegree(n, 150);
+    w.phase2();
+    for (uint32_t n = 0; n < 4; ++n)
+      for (uint32_t i = 0; i < 150; ++i)
+        w.addNeighbor(n, n % 2 ? i / 2 : i);
+    w.finish();
+    w.toFile(dupFile);
+  }
+  Graph dup;
+  galois::graphs::readGraph(dup, dupFile);
+  dup.sortAllEdgesByDst();
+  std::vector<uint64_t> merged(16);
+  for (uint32_t u = 0; u < 4; ++u)
+    for (uint32_t v = 0; v < 4; ++v)
+      merged[u * 4 + v] = dup.countCommonNeighbors(u, v);
+  dup.buildHubIndex(100, UINT64_C(1) << 30);
+  GALOIS_ASSERT(dup.getHubIndex().size() == 2);
+  GALOIS_ASSERT(dup.getHubIndex().isHub(0) && !dup.getHubIndex().isHub(1));
+  for (uint32_t u = 0; u < 4; ++u)
+    for (uint32_t v = 0; v < 4; ++v)
+      GALOIS_ASSERT(dup.countCommonNeighbors(u, v) == merged[u * 4 + v], u,
+                    " ", v);
+  GALOIS_ASSERT(merged[1 * 4 + 3] == 150 && merged[0 * 4 + 1] == 75);
+
+  std::remove(filename.c_str());
+  std::remove(smallFile.c_str());
+  std::remove(dupFile.c_str());
+  return 0;
+}
@@ -21,6 +21,7 @@
 #include "galois/gIO.h"
 
 #include <iostream>
+#include <set>
 
 void printMyTopo() {
   auto t = galois::substrate::getHWTopo();
@@ -33,10 +34,26 @@ void printMyTopo() {
               << " socket: " << c.socket << " numaNode: " << c.numaNode
               << " cumulativeMaxSocket: " << c.cumulativeMaxSocket
               << " osContext: " << c.osContext
-              << " osNumaNode: " << c.osNumaNode << "\n";
+              << " osNumaNode: " << c.osNumaNode << " core: " << c.core
+              << "\n";
   }
 }
 
+void checkPlacement() {
+  auto t = galois::substrate::getHWTopo();
+  std::set<unsigned> contexts;
+  std::set<unsigned> cores;
+  for (auto& c : t.threadTopoInfo) {
+    GALOIS_ASSERT(contexts.insert(c.osContext).second,
+                  "os context used twice");
+    cores.insert(c.core);
+    GALOIS_ASSERT(c.socketLeader <= c.tid);
+    GALOIS_ASSERT(t.threadTopoInfo[c.socketLeader].socket == c.socket);
+  }
+  GALOIS_ASSERT(cores.size() == t.machineTopoInfo.maxCores);
+  GALOIS_ASSERT(t.threadTopoInfo.size() == t.machineTopoInfo.maxThreads);
+}
+
 void test(const std::string& name, const std::vector<int>& found,
           const std::vector<int>& expected) {
   if (found != expected) {
@@ -59,6 +76,7 @@ void test(const std::string& name, const std::vector<int>& found,
 
 int main() {
   printMyTopo();
+  checkPlacement();
 
   using namespace galois::substrate;
 
@@ -0,0 +1,132 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/graphs/Intersection.h"
+#include "galois/gIO.h"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace galois::graphs;
+
+std::vector<uint32_t> makeSet(std::mt19937& gen, size_t size, uint32_t range) {
+  std::uniform_int_distribution<uint32_t> dist(0, range - 1);
+  std::vector<uint32_t> v(size);
+  for (auto& x : v)
+    x = dist(gen);
+  std::sort(v.begin(), v.end());
+  v.erase(std::unique(v.begin(), v.end()), v.end());
+  return v;
+}
+
+//! Sorted multiset in which most elements are repeated
+std::vector<uint32_t> makeMultiset(std::mt19937& gen, size_t size,
+                                   uint32_t range) {
+  std::uniform_int_distribution<uint32_t> dist(0, range - 1);
+  std::vector<uint32_t> v(size);
+  for (auto& x : v)
+    x = dist(gen);
+  std::sort(v.begin(), v.end());
+  return v;
+}
+
+//! Counts repeated elements min(x, y) times, like the merge kernels
+uint64_t expected(const std::vector<uint32_t>& x,
+                  const std::vector<uint32_t>& y) {
+  std::vector<uint32_t> out;
+  std::set_intersection(x.begin(), x.end(), y.begin(), y.end(),
+                        std::back_inserter(out));
+  return out.size();
+}
+
+void check(const std::vector<uint32_t>& x, const std::vector<uint32_t>& y) {
+  uint64_t count = expected(x, y);
+  for (auto isa : {IntersectISA::SCALAR, IntersectISA::SSE42,
+                   IntersectISA::AVX2, IntersectISA::AVX512}) {
+    if (!isIntersectISASupported(isa))
+      continue;
+    GALOIS_ASSERT(internal::countIntersectionISA(isa, x.data(), x.size(),
+                                                 y.data(), y.size()) == count,
+                  intersectISAName(isa));
+    GALOIS_ASSERT(internal::countIntersectionISA(isa, y.data(), y.size(),
+                                                 x.data(), x.size()) == count,
+                  intersectISAName(isa));
+  }
+  GALOIS_ASSERT(internal::countIntersectionGalloping(x.data(), x.size(),
+                                                     y.data(), y.size()) ==
+                count);
+  GALOIS_ASSERT(internal::countIntersectionGalloping(y.data(), y.size(),
+                                                     x.data(), x.size()) ==
+                count);
+  GALOIS_ASSERT(countIntersection(x.data(), x.size(), y.data(), y.size()) ==
+                count);
+}
+
+int main() {
+  std::mt19937 gen(0);
+
+  std::cout << "intersection kernel: " << intersectISAName(getIntersectISA())
+            << "\n";
+
+  // sizes around the block sizes of the vector kernels
+  for (size_t nx : {0, 1, 3, 4, 5, 8, 15, 16, 17, 33, 100, 1000}) {
+    for (size_t ny : {0, 1, 4, 7, 16, 31, 64, 100, 1000, 50000}) {
+      for (uint32_t range : {64, 1000, 100000}) {
+        check(makeSet(gen, nx, range), makeSet(gen, ny, range));
+      }
+    }
+  }
+
+  // repeated elements are paired up the same way by every kernel, whether
+  // they are inside a block, across blocks or after a run of distinct ones
+  for (size_t nx : {2, 9, 17, 40, 300}) {
+    for (size_t ny : {2, 9, 17, 40, 300}) {
+      for (uint32_t range : {4, 50, 1000}) {
+        check(makeMultiset(gen, nx, range), makeMultiset(gen, ny, range));
+      }
+    }
+  }
+  std::vector<uint32_t> tail(64);
+  std::iota(tail.begin(), tail.end(), 0);
+  tail.insert(tail.end(), {64, 64, 64, 65});
+  check(tail, tail);
+  check(tail, makeSet(gen, 100, 200));
+
+  // identical and disjoint sets
+  auto all = makeSet(gen, 1000, 2000);
+  check(all, all);
+  std::vector<uint32_t> evens, odds;
+  for (uint32_t i = 0; i < 1000; ++i)
+    (i % 2 ? odds : evens).push_back(i);
+  check(evens, odds);
+
+  for (size_t n : {0, 1, 2, 7, 64, 1001}) {
+    auto v = makeSet(gen, n, 4096);
+    for (uint32_t key = 0; key < 4096; ++key) {
+      bool found = std::binary_search(v.begin(), v.end(), key);
+      GALOIS_ASSERT(containsSorted(v.data(), v.size(), key) == found);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,83 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/Reduction.h"
+#include "galois/worklists/MonotoneBucket.h"
+
+#include <vector>
+
+struct Indexer {
+  unsigned shift;
+  unsigned operator()(unsigned x) const { return x >> shift; }
+};
+
+typedef galois::worklists::MonotoneBucketWL<Indexer>::retype<unsigned> WL;
+
+//! Each of numChains chains walks through every numChains-th value below
+//! limit; every value must be processed exactly once
+template <typename W>
+void testChains(unsigned numChains, unsigned limit, unsigned shift) {
+  std::vector<unsigned> initial;
+  for (unsigned i = 0; i < numChains; ++i)
+    initial.push_back(i);
+
+  galois::GAccumulator<uint64_t> count;
+  galois::GAccumulator<uint64_t> sum;
+  galois::for_each(
+      galois::iterate(initial),
+      [&](unsigned x, auto& ctx) {
+        count += 1;
+        sum += x;
+        if (x + numChains < limit)
+          ctx.push(x + numChains);
+      },
+      galois::wl<W>(Indexer{shift}), galois::no_stats());
+  GALOIS_ASSERT(count.reduce() == limit, count.reduce());
+  GALOIS_ASSERT(sum.reduce() == uint64_t(limit) * (limit - 1) / 2);
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+
+  // a single thread sees its pushes in priority order, including the ones
+  // that start out beyond the window
+  WL wl(Indexer{0});
+  std::vector<unsigned> initial = {5000, 7, 300, 7, 2, 100000, 299};
+  wl.push(initial.begin(), initial.end());
+  unsigned last = 0;
+  unsigned n    = 0;
+  while (auto item = wl.pop()) {
+    GALOIS_ASSERT(*item >= last, *item, " after ", last);
+    last = *item;
+    ++n;
+  }
+  GALOIS_ASSERT(n == initial.size());
+
+  // work for passed buckets is still processed
+  wl.push(100);
+  GALOIS_ASSERT(wl.pop() && !wl.pop());
+
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+  testChains<WL>(64, 200000, 0);
+  testChains<WL>(64, 200000, 4);
+  testChains<WL::with_num_buckets<2>::type>(3, 100000, 0);
+
+  return 0;
+}
@@ -0,0 +1,80 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/Reduction.h"
+#include "galois/worklists/MultiQueue.h"
+
+#include <random>
+#include <vector>
+
+struct Item {
+  float weight;
+  unsigned id;
+};
+
+struct Lighter {
+  bool operator()(const Item& a, const Item& b) const {
+    return a.weight < b.weight;
+  }
+};
+
+typedef galois::worklists::MultiQueue<Lighter, Item> WL;
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+
+  // with a single heap the order is exact
+  WL::rethread<false> serial;
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> dist(0, 1);
+  for (unsigned i = 0; i < 1000; ++i)
+    serial.push(Item{dist(gen), i});
+  float last = 0;
+  unsigned n = 0;
+  while (auto item = serial.pop()) {
+    GALOIS_ASSERT(item->weight >= last);
+    last = item->weight;
+    ++n;
+  }
+  GALOIS_ASSERT(n == 1000);
+
+  // every item pushed in parallel is popped exactly once
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+  const unsigned numItems = 200000;
+  std::vector<Item> initial;
+  for (unsigned i = 0; i < 64; ++i)
+    initial.push_back(Item{0, i});
+
+  galois::GAccumulator<uint64_t> count;
+  galois::GAccumulator<uint64_t> sum;
+  galois::for_each(
+      galois::iterate(initial),
+      [&](const Item& item, auto& ctx) {
+        count += 1;
+        sum += item.id;
+        if (item.id + 64 < numItems)
+          ctx.push(Item{item.weight + 0.5f * (item.id % 7), item.id + 64});
+      },
+      galois::wl<WL>(), galois::no_stats());
+  GALOIS_ASSERT(count.reduce() == numItems, count.reduce());
+  GALOIS_ASSERT(sum.reduce() == uint64_t(numItems) * (numItems - 1) / 2);
+
+  return 0;
+}
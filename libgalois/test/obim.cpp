@@ -0,0 +1,78 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/Reduction.h"
+#include "galois/worklists/Obim.h"
+
+#include <vector>
+
+struct Indexer {
+  int operator()(int x) const { return x; }
+};
+
+typedef galois::worklists::OrderedByIntegerMetric<Indexer> OBIM;
+
+//! Each of numChains chains walks through every numChains-th priority below
+//! limit; every priority is processed exactly once unless items are lost
+//! while buckets are retired and reused
+template <typename WL>
+void testChains(int numChains, int limit) {
+  std::vector<int> initial;
+  for (int i = 0; i < numChains; ++i)
+    initial.push_back(i);
+
+  galois::GAccumulator<uint64_t> count;
+  galois::GAccumulator<uint64_t> sum;
+  galois::for_each(
+      galois::iterate(initial),
+      [&](int x, auto& ctx) {
+        count += 1;
+        sum += x;
+        if (x + numChains < limit)
+          ctx.push(x + numChains);
+      },
+      galois::wl<WL>(), galois::no_stats());
+  GALOIS_ASSERT(count.reduce() == uint64_t(limit), count.reduce());
+  GALOIS_ASSERT(sum.reduce() == uint64_t(limit) * (limit - 1) / 2);
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+
+  // a single thread walking through many priorities keeps reusing a few
+  // buckets
+  OBIM wl;
+  wl.push(0);
+  int processed = 0;
+  while (auto item = wl.pop()) {
+    ++processed;
+    if (*item < 100000)
+      wl.push(*item + 1);
+  }
+  GALOIS_ASSERT(processed == 100001, processed);
+  GALOIS_ASSERT(wl.numBuckets() < 100, wl.numBuckets());
+
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+  testChains<OBIM>(64, 200000);
+  testChains<OBIM::with_back_scan_prevention<false>::type>(64, 200000);
+  testChains<OBIM::with_block_period<2>::type>(3, 100000);
+
+  return 0;
+}
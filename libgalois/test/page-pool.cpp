@@ -0,0 +1,81 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+
+#include "galois/Galois.h"
+#include "galois/runtime/PagePool.h"
+
+#include <vector>
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+  unsigned numThreads = galois::setActiveThreads(
+      galois::substrate::getThreadPool().getMaxThreads());
+  using namespace galois::runtime;
+
+  // pages freed by another thread go back to their owner
+  std::vector<void*> pages(numThreads * 4);
+  galois::on_each([&](unsigned tid, unsigned) {
+    for (unsigned i = 0; i < 4; ++i)
+      pages[tid * 4 + i] = pagePoolAlloc();
+  });
+  int allocated = numPagePoolAllocTotal();
+  GALOIS_ASSERT(allocated >= int(pages.size()));
+  galois::on_each([&](unsigned tid, unsigned num) {
+    unsigned other = (tid + 1) % num;
+    for (unsigned i = 0; i < 4; ++i)
+      pagePoolFree(pages[other * 4 + i]);
+  });
+  galois::on_each([&](unsigned tid, unsigned) {
+    for (unsigned i = 0; i < 4; ++i)
+      pages[tid * 4 + i] = pagePoolAlloc();
+  });
+  GALOIS_ASSERT(numPagePoolAllocTotal() == allocated, "free pages not reused");
+
+  // idle pages above the high water mark are unmapped after the next loop
+  setPagePoolHighWater(1);
+  galois::on_each([&](unsigned tid, unsigned) {
+    for (unsigned i = 0; i < 4; ++i)
+      pagePoolFree(pages[tid * 4 + i]);
+  });
+  GALOIS_ASSERT(numPagePoolAllocTotal() <= allocated - int(3 * numThreads),
+                "idle pages were not trimmed");
+
+  // preallocated pages are kept
+  int before = numPagePoolAllocTotal();
+  galois::preAlloc(2 * numThreads);
+  galois::on_each([](unsigned, unsigned) {});
+  GALOIS_ASSERT(numPagePoolAllocTotal() == before + int(2 * numThreads));
+
+  // unmapped pages are not handed out again
+  galois::on_each([&](unsigned tid, unsigned) {
+    for (unsigned i = 0; i < 4; ++i) {
+      char* page         = static_cast<char*>(pagePoolAlloc());
+      page[0]            = 1;
+      pages[tid * 4 + i] = page;
+    }
+  });
+  galois::on_each([&](unsigned tid, unsigned) {
+    for (unsigned i = 0; i < 4; ++i)
+      pagePoolFree(pages[tid * 4 + i]);
+  });
+
+  setPagePoolHighWater(-1);
+  return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/Version.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+unsigned numThreads;
+
+std::string run(galois::runtime::StatFormat format) {
+  const std::string filename = "stat-format-test.out";
+  {
+    galois::SharedMemSys Galois_runtime;
+    numThreads = galois::setActiveThreads(
+        galois::substrate::getThreadPool().getMaxThreads());
+    galois::runtime::setStatFile(filename);
+    galois::runtime::setStatFormat(format);
+
+    galois::runtime::reportParam("(NULL)", "Input", "a \"quoted\", input");
+    galois::runtime::reportStat_Single("main", "Ratio", 0.5);
+    galois::on_each(
+        [](unsigned tid, unsigned) {
+          galois::runtime::reportStat_Tsum("loop", "Iterations", tid + 1);
+        },
+        galois::no_stats());
+  }
+
+  std::ifstream in(filename);
+  GALOIS_ASSERT(in.good(), "stats not written");
+  std::stringstream ss;
+  ss << in.rdbuf();
+  std::remove(filename.c_str());
+  return ss.str();
+}
+
+bool contains(const std::string& s, const std::string& pattern) {
+  return s.find(pattern) != std::string::npos;
+}
+
+int main() {
+  std::string json = run(galois::runtime::StatFormat::JSON);
+  unsigned n       = numThreads;
+  std::string sum  = std::to_string(n * (n + 1) / 2);
+
+  GALOIS_ASSERT(contains(json, "\"revision\": \"" + galois::getRevision()));
+  GALOIS_ASSERT(contains(json, "\"threads\": " + std::to_string(n) + "}"));
+  GALOIS_ASSERT(contains(json, "\"region\": \"loop\", \"category\": "
+                               "\"Iterations\", \"totalType\": \"TSUM\", "
+                               "\"total\": " +
+                                   sum));
+  GALOIS_ASSERT(contains(json, "\"total\": 0.5"));
+  GALOIS_ASSERT(contains(json, "\"total\": \"a \\\"quoted\\\", input\""));
+
+  std::string csv = run(galois::runtime::StatFormat::CSV);
+  GALOIS_ASSERT(csv.find("STAT_TYPE,REGION,CATEGORY,TOTAL_TYPE,TOTAL,T0") ==
+                0);
+  std::string row = "STAT,loop,Iterations,TSUM," + sum;
+  for (unsigned t = 0; t < n; ++t) {
+    row += "," + std::to_string(t + 1);
+  }
+  GALOIS_ASSERT(contains(csv, row + "\r\n"));
+  GALOIS_ASSERT(contains(csv, "PARAM,(NULL),Input,SINGLE,"
+                              "\"a \"\"quoted\"\", input\""));
+
+  return 0;
+}
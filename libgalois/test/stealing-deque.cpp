@@ -0,0 +1,70 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/Reduction.h"
+#include "galois/worklists/StealingDeque.h"
+
+#include <utility>
+#include <vector>
+
+typedef std::pair<unsigned, unsigned> Range;
+typedef galois::worklists::StealingDeque<Range> WL;
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+
+  // a single deque pops in LIFO order
+  WL::rethread<false> serial;
+  for (unsigned i = 0; i < 1000; ++i)
+    serial.push(Range(i, i + 1));
+  unsigned n = 1000;
+  while (auto item = serial.pop())
+    GALOIS_ASSERT(item->first == --n);
+  GALOIS_ASSERT(n == 0);
+
+  // every leaf of a recursive split is visited exactly once, however the
+  // pieces get stolen
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+  const unsigned numLeaves = 1 << 18;
+  std::vector<Range> initial{Range(0, numLeaves)};
+
+  for (int round = 0; round < 3; ++round) {
+    galois::GAccumulator<uint64_t> count;
+    galois::GAccumulator<uint64_t> sum;
+    galois::for_each(
+        galois::iterate(initial),
+        [&](const Range& r, auto& ctx) {
+          if (r.second - r.first == 1) {
+            count += 1;
+            sum += r.first;
+            return;
+          }
+          unsigned mid = r.first + (r.second - r.first) / 2;
+          ctx.push(Range(r.first, mid));
+          ctx.push(Range(mid, r.second));
+        },
+        galois::wl<WL>(), galois::disable_conflict_detection(),
+        galois::no_stats());
+    GALOIS_ASSERT(count.reduce() == numLeaves, count.reduce());
+    GALOIS_ASSERT(sum.reduce() == uint64_t(numLeaves) * (numLeaves - 1) / 2);
+  }
+
+  return 0;
+}
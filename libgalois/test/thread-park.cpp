@@ -0,0 +1,75 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/Reduction.h"
+
+#include <chrono>
+#include <thread>
+
+uint64_t sumOfWaits(uint64_t galois::substrate::ThreadPool::WaitStats::*field) {
+  auto& tp     = galois::substrate::getThreadPool();
+  uint64_t sum = 0;
+  for (unsigned tid = 0; tid < tp.getMaxThreads(); ++tid)
+    sum += tp.getWaitStats(tid).*field;
+  return sum;
+}
+
+void runLoops(unsigned num) {
+  for (unsigned i = 0; i < num; ++i) {
+    galois::GAccumulator<unsigned> count;
+    galois::on_each([&](unsigned, unsigned) { count += 1; });
+    GALOIS_ASSERT(count.reduce() == galois::getActiveThreads());
+  }
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+  auto& tp            = galois::substrate::getThreadPool();
+  unsigned numThreads = galois::setActiveThreads(tp.getMaxThreads());
+  typedef galois::substrate::ThreadPool::WaitStats WaitStats;
+
+  // without a spin budget, every wait ends in a sleep
+  tp.setSpinBudget(0);
+  GALOIS_ASSERT(tp.getSpinBudget() == 0);
+  uint64_t wakeups = sumOfWaits(&WaitStats::wakeups);
+  uint64_t parks   = sumOfWaits(&WaitStats::parks);
+  runLoops(100);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  runLoops(100);
+  if (numThreads > 1) {
+    GALOIS_ASSERT(sumOfWaits(&WaitStats::wakeups) - wakeups >=
+                  200 * (numThreads - 1));
+    GALOIS_ASSERT(sumOfWaits(&WaitStats::parks) > parks);
+  }
+
+  // spinning and fastmode still run every loop
+  tp.setSpinBudget(100);
+  runLoops(100);
+  tp.burnPower(numThreads);
+  runLoops(100);
+  tp.beKind();
+  runLoops(100);
+
+  if (numThreads > 1) {
+    GALOIS_ASSERT(sumOfWaits(&WaitStats::maxWakeLatencyNs) > 0);
+  }
+
+  return 0;
+}
@@ -28,11 +28,17 @@
 
 #include <unordered_map>
 #include <fstream>
+#include <cstring>
+#include <memory>
+#include <thread>
 
 #include "galois/runtime/GlobalObj.h"
 #include "galois/runtime/DistStats.h"
 #include "galois/runtime/SyncStructures.h"
 #include "galois/runtime/DataCommMode.h"
+#include "galois/runtime/CompressedMessage.h"
+#include "galois/runtime/Checkpoint.h"
+#include "galois/DReducible.h"
 #include "galois/DynamicBitset.h"
 
 #ifdef GALOIS_ENABLE_GPU
@@ -130,6 +136,27 @@ private:
   galois::DynamicBitSet syncBitset;
   galois::PODResizeableArray<unsigned int> syncOffsets;
 
+  //! If true, large sync messages are delta+varint compressed when that
+  //! makes them smaller
+  bool compressSync;
+  //! Messages with fewer elements than this are never compressed
+  static constexpr size_t minCompressCount = 64;
+  //! Scratch buffers for compressed offsets and values
+  galois::PODResizeableArray<uint8_t> compressedOffsets;
+  galois::PODResizeableArray<uint8_t> compressedValues;
+
+  //! True between a beginSync that left the reduce receive pending and the
+  //! matching endSync
+  bool syncPending = false;
+  //! Loop name and round of the pending sync
+  std::string pendingSyncLoop;
+  uint32_t pendingSyncRound;
+  //! Accumulates the time spent in both halves of the pending sync
+  std::unique_ptr<galois::StatTimer> pendingSyncTimer;
+  //! Masters with mirrors on other hosts: the only proxies a pending reduce
+  //! receive can update
+  galois::DynamicBitSet sharedMasters;
+
   /**
    * Reset a provided bitset given the type of synchronization performed
    *
@@ -419,18 +446,21 @@ public:
    * @param _partitionAgnostic determines if sync should be partition agnostic
    * or not
    * @param _enforcedDataMode Forced data comm mode for sync
+   * @param _compressSync allow sync messages to be compressed; only valid if
+   * every host syncs on the CPU
    */
   GluonSubstrate(
       GraphTy& _userGraph, unsigned host, unsigned numHosts, bool _transposed,
       std::pair<unsigned, unsigned> _cartesianGrid = std::make_pair(0u, 0u),
       bool _partitionAgnostic                      = false,
-      DataCommMode _enforcedDataMode               = DataCommMode::noData)
+      DataCommMode _enforcedDataMode               = DataCommMode::noData,
+      bool _compressSync                           = false)
       : galois::runtime::GlobalObject(this), userGraph(_userGraph), id(host),
         transposed(_transposed), isVertexCut(userGraph.is_vertex_cut()),
         cartesianGrid(_cartesianGrid), partitionAgnostic(_partitionAgnostic),
         substrateDataMode(_enforcedDataMode), numHosts(numHosts), num_run(0),
         num_round(0), currentBVFlag(nullptr),
-        mirrorNodes(userGraph.getMirrorNodes()) {
+        mirrorNodes(userGraph.getMirrorNodes()), compressSync(_compressSync) {
     if (cartesianGrid.first != 0 && cartesianGrid.second != 0) {
       GALOIS_ASSERT(cartesianGrid.first * cartesianGrid.second == numHosts,
                     "Cartesian split doesn't equal number of hosts");
@@ -455,9 +485,15 @@ public:
         "GraphCommSetupTime", RNAME);
     Tgraph_construct_comm.start();
     setupCommunication();
+    initSharedMasters();
     Tgraph_construct_comm.stop();
   }
 
+  /**
+   * Waits for a checkpoint still being written in the background.
+   */
+  ~GluonSubstrate() { checkpointWait(); }
+
   ////////////////////////////////////////////////////////////////////////////////
   // Data extraction from bitsets
   ////////////////////////////////////////////////////////////////////////////////
@@ -799,26 +835,95 @@ private:
       convertLIDToGID<syncType>(loopName, indices, offsets);
       val_vec.resize(bit_set_count);
       Tserialize.start();
-      gSerialize(b, data_mode, bit_set_count, offsets, val_vec);
+      if (!serializeCompressed<syncType>(loopName, data_mode, bit_set_count,
+                                         offsets, bit_set_comm, val_vec, b)) {
+        gSerialize(b, data_mode, bit_set_count, offsets, val_vec);
+      }
       Tserialize.stop();
     } else if (data_mode == offsetsData) {
       offsets.resize(bit_set_count);
       val_vec.resize(bit_set_count);
       Tserialize.start();
-      gSerialize(b, data_mode, bit_set_count, offsets, val_vec);
+      if (!serializeCompressed<syncType>(loopName, data_mode, bit_set_count,
+                                         offsets, bit_set_comm, val_vec, b)) {
+        gSerialize(b, data_mode, bit_set_count, offsets, val_vec);
+      }
       Tserialize.stop();
     } else if (data_mode == bitsetData) {
       val_vec.resize(bit_set_count);
       Tserialize.start();
-      gSerialize(b, data_mode, bit_set_count, bit_set_comm, val_vec);
+      if (!serializeCompressed<syncType>(loopName, data_mode, bit_set_count,
+                                         offsets, bit_set_comm, val_vec, b)) {
+        gSerialize(b, data_mode, bit_set_count, bit_set_comm, val_vec);
+      }
       Tserialize.stop();
     } else { // onlyData
       Tserialize.start();
-      gSerialize(b, data_mode, val_vec);
+      if (!serializeCompressed<syncType>(loopName, data_mode, bit_set_count,
+                                         offsets, bit_set_comm, val_vec, b)) {
+        gSerialize(b, data_mode, val_vec);
+      }
       Tserialize.stop();
     }
   }
 
+  /**
+   * Serializes a message with its offsets/global ids and its integral values
+   * delta+varint encoded. The encoding is only used if compression is
+   * enabled, the message is large enough, and the encoded message saves at
+   * least an eighth of the raw bytes.
+   *
+   * @tparam syncType either reduce or broadcast
+   * @tparam VecType type of val_vec, which stores the data to send
+   *
+   * @param loopName loop name used for timers
+   * @param data_mode uncompressed mode chosen for the message
+   * @param bit_set_count the number of items we are sending in this message
+   * @param offsets offsets (or global ids) of the items being sent
+   * @param bit_set_comm bitset of the items being sent
+   * @param val_vec contains the data that we are serializing to send
+   * @param b the buffer in which to serialize the message
+   * @returns true if the message was serialized into b compressed; false if
+   * it still needs to be serialized uncompressed
+   */
+  template <SyncType syncType, typename VecType>
+  bool serializeCompressed(std::string loopName, DataCommMode data_mode,
+                           size_t bit_set_count,
+                           galois::PODResizeableArray<unsigned int>& offsets,
+                           galois::DynamicBitSet& bit_set_comm,
+                           VecType& val_vec, galois::runtime::SendBuffer& b) {
+    using ValTy = typename VecType::value_type;
+    constexpr bool compressValues = std::is_integral<ValTy>::value;
+    bool hasOffsets = (data_mode == offsetsData || data_mode == gidsData);
+    if (!compressSync || (!hasOffsets && !compressValues) ||
+        val_vec.size() < minCompressCount) {
+      return false;
+    }
+
+    std::string syncTypeStr = (syncType == syncReduce) ? "Reduce" : "Broadcast";
+    std::string compress_timer_str(syncTypeStr + "Compress_" +
+                                   get_run_identifier(loopName));
+    galois::CondStatTimer<GALOIS_COMM_STATS> Tcompress(
+        compress_timer_str.c_str(), RNAME);
+
+    Tcompress.start();
+    size_t rawSize = galois::runtime::compressMessage(
+        data_mode, bit_set_count, offsets, val_vec, compressedOffsets,
+        compressedValues);
+    size_t compressedSize = compressedOffsets.size() + compressedValues.size();
+    Tcompress.stop();
+
+    if (compressedSize > rawSize - rawSize / 8) {
+      return false;
+    }
+    reportCompressedSize(loopName, syncTypeStr, rawSize, compressedSize);
+
+    galois::runtime::serializeCompressedMessage(b, data_mode, bit_set_count,
+                                                bit_set_comm, compressedOffsets,
+                                                compressedValues, val_vec);
+    return true;
+  }
+
   /**
    * Given the data mode, deserialize the rest of a message in a Receive Buffer.
    *
@@ -827,7 +932,8 @@ private:
    *
    * @param loopName used to name timers for statistics
    * @param data_mode data mode with which the original message was sent;
-   * determines how to deserialize the rest of the message
+   * determines how to deserialize the rest of the message. Compressed modes
+   * are decoded and replaced with their uncompressed mode.
    * @param buf buffer which contains the received message to deserialize
    *
    * The rest of the arguments are output arguments (they are passed by
@@ -844,7 +950,7 @@ private:
    * @param val_vec The data proper will be deserialized into this vector
    */
   template <SyncType syncType, typename VecType>
-  void deserializeMessage(std::string loopName, DataCommMode data_mode,
+  void deserializeMessage(std::string loopName, DataCommMode& data_mode,
                           uint32_t num, galois::runtime::RecvBuffer& buf,
                           size_t& bit_set_count,
                           galois::PODResizeableArray<unsigned int>& offsets,
@@ -857,6 +963,15 @@ private:
         serialize_timer_str.c_str(), RNAME);
     Tdeserialize.start();
 
+    if (uncompressedDataMode(data_mode) != data_mode) {
+      deserializeCompressed<syncType>(loopName, data_mode, num, buf,
+                                      bit_set_count, offsets, bit_set_comm,
+                                      val_vec);
+      data_mode = uncompressedDataMode(data_mode);
+      Tdeserialize.stop();
+      return;
+    }
+
     // get other metadata associated with message if mode isn't OnlyData
     if (data_mode != onlyData) {
       galois::runtime::gDeserialize(buf, bit_set_count);
@@ -882,6 +997,45 @@ private:
     Tdeserialize.stop();
   }
 
+  /**
+   * Deserializes and decodes the rest of a message sent by
+   * serializeCompressed.
+   *
+   * @tparam syncType either reduce or broadcast
+   * @tparam VecType type of val_vec, which data will be decoded into
+   *
+   * @param loopName used to name timers for statistics
+   * @param data_mode compressed data mode the message was sent with
+   * @param num number of nodes shared with the sending host
+   * @param buf buffer which contains the received message to deserialize
+   * @param bit_set_count output: number of items in the message
+   * @param offsets output: decoded offsets (converted to local ids for gids)
+   * @param bit_set_comm output: bitset of items for bitset messages
+   * @param val_vec output: decoded data
+   */
+  template <SyncType syncType, typename VecType>
+  void deserializeCompressed(std::string loopName, DataCommMode data_mode,
+                             uint32_t num, galois::runtime::RecvBuffer& buf,
+                             size_t& bit_set_count,
+                             galois::PODResizeableArray<unsigned int>& offsets,
+                             galois::DynamicBitSet& bit_set_comm,
+                             VecType& val_vec) {
+    std::string syncTypeStr = (syncType == syncReduce) ? "Reduce" : "Broadcast";
+    std::string decompress_timer_str(syncTypeStr + "Decompress_" +
+                                     get_run_identifier(loopName));
+    galois::CondStatTimer<GALOIS_COMM_STATS> Tdecompress(
+        decompress_timer_str.c_str(), RNAME);
+
+    Tdecompress.start();
+    galois::runtime::deserializeCompressedMessage(
+        buf, data_mode, num, bit_set_count, offsets, bit_set_comm, val_vec,
+        compressedValues);
+    Tdecompress.stop();
+    if (data_mode == gidsDataCompressed) {
+      convertGIDToLID<syncType>(loopName, offsets);
+    }
+  }
+
   ////////////////////////////////////////////////////////////////////////////////
   // Other helper functions
   ////////////////////////////////////////////////////////////////////////////////
@@ -1061,6 +1215,27 @@ private:
     }
   }
 
+  /**
+   * Reports bytes going into and coming out of sync message compression; the
+   * ratio of the two is the compression ratio.
+   *
+   * @param loopName loop name used for timers
+   * @param syncTypeStr String used to name timers
+   * @param rawSize bytes of offsets and values before compression
+   * @param compressedSize bytes of offsets and values after compression
+   */
+  void reportCompressedSize(std::string loopName, std::string syncTypeStr,
+                            size_t rawSize, size_t compressedSize) {
+    std::string statRaw_str(syncTypeStr + "CompressInBytes_" +
+                            get_run_identifier(loopName));
+    std::string statCompressed_str(syncTypeStr + "CompressOutBytes_" +
+                                   get_run_identifier(loopName));
+    galois::runtime::reportStatCond_Tsum<MORE_DIST_STATS>(RNAME, statRaw_str,
+                                                          rawSize);
+    galois::runtime::reportStatCond_Tsum<MORE_DIST_STATS>(
+        RNAME, statCompressed_str, compressedSize);
+  }
+
   ////////////////////////////////////////////////////////////////////////////////
   // Extract data from nodes (for reduce and broadcast)
   ////////////////////////////////////////////////////////////////////////////////
@@ -3082,6 +3257,167 @@ public:
     Tsync.stop();
   }
 
+private:
+  /**
+   * Returns true if a sync with the given locations only reduces from
+   * mirrors to masters on this partition, so that its receive can be left
+   * pending.
+   */
+  bool syncIsReduceOnly(WriteLocation writeLocation,
+                        ReadLocation readLocation) const {
+    if (partitionAgnostic || isVertexCut) {
+      return false;
+    }
+    // see sync_dst_to_src, sync_any_to_src, sync_src_to_dst and
+    // sync_any_to_dst
+    if (readLocation == readSource) {
+      return !transposed && writeLocation != writeSource;
+    } else if (readLocation == readDestination) {
+      return transposed && writeLocation != writeDestination;
+    }
+    return false;
+  }
+
+  /**
+   * Marks the masters that have mirrors on some other host.
+   */
+  void initSharedMasters() {
+    sharedMasters.resize(userGraph.size());
+    for (unsigned h = 0; h < numHosts; ++h) {
+      galois::do_all(
+          galois::iterate(size_t{0}, masterNodes[h].size()),
+          [&](size_t i) { sharedMasters.set(masterNodes[h][i]); },
+          galois::no_stats());
+    }
+  }
+
+public:
+  /**
+   * Returns true if beginSync with the same template arguments leaves the
+   * receive pending until endSync. If not, beginSync does the whole sync, so
+   * callers can skip splitting their work around isSyncBoundary.
+   *
+   * @tparam writeLocation Location data is written (src or dst)
+   * @tparam readLocation Location data is read (src or dst)
+   * @tparam async true if the sync is asynchronous
+   */
+  template <WriteLocation writeLocation, ReadLocation readLocation,
+            bool async = false>
+  bool syncWillSplit() const {
+#ifdef GALOIS_USE_BARE_MPI
+    if (bare_mpi != noBareMPI) {
+      return false;
+    }
+#endif
+    return !async && syncIsReduceOnly(writeLocation, readLocation);
+  }
+
+  /**
+   * First half of a split-phase sync: does everything sync would except
+   * receiving the last messages, which endSync does. In between, the caller
+   * can do local work while the messages are in flight.
+   *
+   * Only syncs that reduce from mirrors to masters on this partition are
+   * actually split (e.g. writeDestination/readSource on an outgoing edge
+   * cut); the pending receive then only updates the masters for which
+   * isSyncBoundary is true, by reducing into them. Work done before endSync
+   * must not read the synced field of those masters, and may only write it
+   * with the reduction of SyncFnTy. For every other sync (and for async
+   * execution) beginSync does the whole sync and endSync does nothing.
+   *
+   * No other sync may be started before endSync.
+   *
+   * @tparam writeLocation Location data is written (src or dst)
+   * @tparam readLocation Location data is read (src or dst)
+   * @tparam SyncFnTy sync structure for the field
+   * @tparam BitsetFnTy struct that has info on how to access the bitset
+   *
+   * @param loopName used to name timers for statistics
+   */
+  template <WriteLocation writeLocation, ReadLocation readLocation,
+            typename SyncFnTy, typename BitsetFnTy = galois::InvalidBitsetFnTy,
+            bool async = false>
+  void beginSync(std::string loopName) {
+    if (syncPending) {
+      GALOIS_DIE("beginSync ", loopName, " while sync ", pendingSyncLoop,
+                 " is pending");
+    }
+
+    if (!syncWillSplit<writeLocation, readLocation, async>()) {
+      sync<writeLocation, readLocation, SyncFnTy, BitsetFnTy, async>(loopName);
+      return;
+    }
+
+    typedef typename SyncFnTy::ValTy T;
+    typedef
+        typename std::conditional<galois::runtime::is_memory_copyable<T>::value,
+                                  galois::PODResizeableArray<T>,
+                                  galois::gstl::Vector<T>>::type VecTy;
+
+    std::string timer_str("Sync_" + loopName + "_" + get_run_identifier());
+    pendingSyncTimer =
+        std::make_unique<galois::StatTimer>(timer_str.c_str(), RNAME);
+    pendingSyncTimer->start();
+    syncSend<writeLocation, readLocation, syncReduce, SyncFnTy, BitsetFnTy,
+             VecTy, async>(loopName);
+    pendingSyncTimer->stop();
+
+    syncPending      = true;
+    pendingSyncLoop  = loopName;
+    pendingSyncRound = num_round;
+  }
+
+  /**
+   * Second half of a split-phase sync started by beginSync with the same
+   * template arguments: receives and applies the pending messages. Does
+   * nothing if no receive is pending.
+   *
+   * @tparam writeLocation Location data is written (src or dst)
+   * @tparam readLocation Location data is read (src or dst)
+   * @tparam SyncFnTy sync structure for the field
+   * @tparam BitsetFnTy struct that has info on how to access the bitset
+   *
+   * @param loopName used to name timers for statistics
+   */
+  template <WriteLocation writeLocation, ReadLocation readLocation,
+            typename SyncFnTy, typename BitsetFnTy = galois::InvalidBitsetFnTy,
+            bool async = false>
+  void endSync(std::string loopName) {
+    if (!syncPending) {
+      return;
+    }
+    assert(pendingSyncLoop == loopName);
+
+    typedef typename SyncFnTy::ValTy T;
+    typedef
+        typename std::conditional<galois::runtime::is_memory_copyable<T>::value,
+                                  galois::PODResizeableArray<T>,
+                                  galois::gstl::Vector<T>>::type VecTy;
+
+    // statistics belong to the round that started the sync
+    uint32_t round = num_round;
+    num_round      = pendingSyncRound;
+    pendingSyncTimer->start();
+    syncRecv<writeLocation, readLocation, syncReduce, SyncFnTy, BitsetFnTy,
+             VecTy, async>(loopName);
+    pendingSyncTimer->stop();
+    pendingSyncTimer.reset();
+    num_round = round;
+
+    syncPending = false;
+  }
+
+  /**
+   * Returns true if a split-phase sync may update the given proxy between
+   * beginSync and endSync, i.e. if it is a master with mirrors on other
+   * hosts. Does not depend on whether a sync is pending, so a round can be
+   * split into the work on other proxies, done before endSync, and the work
+   * on these, done after it.
+   *
+   * @param lid local id of the proxy
+   */
+  bool isSyncBoundary(uint32_t lid) const { return sharedMasters.test(lid); }
+
   ////////////////////////////////////////////////////////////////////////////////
   // Sync on demand code (unmaintained, may not work)
   ////////////////////////////////////////////////////////////////////////////////
@@ -3542,89 +3878,192 @@ public:
 // Checkpointing code for graph
 ////////////////////////////////////////////////////////////////////////////////
 
-// @todo Checkpointing code needs updates to make it work.
-#ifdef GALOIS_CHECKPOINT
-///*
-// * Headers for boost serialization
-// */
-//#include <boost/archive/binary_oarchive.hpp>
-//#include <boost/archive/binary_iarchive.hpp>
-//#include <boost/serialization/split_member.hpp>
-//#include <boost/serialization/binary_object.hpp>
-//#include <boost/serialization/serialization.hpp>
-//#include <boost/serialization/vector.hpp>
-//#include <boost/serialization/unordered_map.hpp>
-//
-// public:
-//  /**
-//   * Checkpoint the complete structure on the node to disk
-//   */
-//  void checkpointSaveNodeData(std::string checkpointFileName = "checkpoint") {
-//    using namespace boost::archive;
-//    galois::StatTimer TimerSaveCheckPoint(
-//        get_run_identifier("TimerSaveCheckpoint").c_str(), RNAME);
-//
-//    TimerSaveCheckPoint.start();
-//    std::string checkpointFileName_local =
-//        checkpointFileName + "_" + std::to_string(id);
-//
-//    std::ofstream outputStream(checkpointFileName_local, std::ios::binary);
-//    if (!outputStream.is_open()) {
-//      galois::gPrint("ERROR: Could not open ", checkpointFileName_local,
-//                     " to save checkpoint!!!\n");
-//    }
-//    galois::gPrint("[", id,
-//                   "] Saving local checkpoint to :", checkpointFileName_local,
-//                   "\n");
-//
-//    boost::archive::binary_oarchive ar(outputStream,
-//    boost::archive::no_header);
-//
-//    // TODO handle this with CuSP
-//    userGraph.serializeNodeData(ar);
-//
-//    std::string statSendBytes_str("CheckpointBytesTotal");
-//    constexpr static const char* const RREGION = "RECOVERY";
-//    size_t cp_size                             = outputStream.tellp();
-//    galois::runtime::reportStat_Tsum(RREGION, statSendBytes_str, cp_size);
-//
-//    outputStream.flush();
-//    outputStream.close();
-//    TimerSaveCheckPoint.stop();
-//  }
-//
-//  /**
-//   * Load checkpointed data from disk.
-//   */
-//  void checkpointApplyNodeData(std::string checkpointFileName = "checkpoint")
-//  {
-//    using namespace boost::archive;
-//    galois::StatTimer TimerApplyCheckPoint(
-//        get_run_identifier("TimerApplyCheckpoint").c_str(), RNAME);
-//
-//    TimerApplyCheckPoint.start();
-//    std::string checkpointFileName_local =
-//        checkpointFileName + "_" + std::to_string(id);
-//
-//    std::ifstream inputStream(checkpointFileName_local, std::ios::binary);
-//
-//    if (!inputStream.is_open()) {
-//      galois::gPrint("ERROR: Could not open ", checkpointFileName_local,
-//                     " to read checkpoint!!!\n");
-//    }
-//    galois::gPrint("[", id, "] reading local checkpoint from: ",
-//                   checkpointFileName_local, "\n");
-//
-//    boost::archive::binary_iarchive ar(inputStream,
-//    boost::archive::no_header);
-//
-//    // TODO handle this with CuSP
-//    userGraph.deSerializeNodeData(ar);
-//
-//    inputStream.close();
-//    TimerApplyCheckPoint.stop();
-//  }
-#endif
+private:
+  //! Identifies node data checkpoints written by this version of the code
+  constexpr static uint64_t checkpointMagic = 0x47616c4e6f646531ULL;
+
+  //! Type of the node data that is checkpointed
+  using CheckpointNodeTy = typename std::remove_reference<decltype(
+      std::declval<GraphTy&>().getData(0))>::type;
+
+  //! Background thread writing the last checkpoint started
+  std::thread checkpointThread;
+  //! Copy of the node data the background thread is writing
+  std::vector<uint8_t> checkpointSnapshot;
+  //! Number of checkpoints started; picks the file to write next
+  uint64_t numCheckpoints = 0;
+
+  //! Returns the name of one of the two checkpoint files of this host
+  std::string checkpointFile(const std::string& checkpointFileName,
+                             unsigned slot) const {
+    return checkpointFileName + "_" + std::to_string(id) + "." +
+           std::to_string(slot);
+  }
+
+  //! Checks the header of a checkpoint file and returns its tag
+  uint64_t readCheckpointHeader(galois::runtime::CheckpointReader& r,
+                                const std::string& fileName) {
+    if (r.readValue<uint64_t>() != checkpointMagic ||
+        r.readValue<unsigned>() != id || r.readValue<uint32_t>() != numHosts ||
+        r.readValue<uint64_t>() != userGraph.size() ||
+        r.readValue<uint64_t>() != sizeof(CheckpointNodeTy)) {
+      GALOIS_DIE(fileName, " does not match this graph");
+    }
+    return r.readValue<uint64_t>();
+  }
+
+public:
+  /**
+   * Starts an asynchronous checkpoint of the data of all local nodes. The
+   * node data is copied in parallel, after which this returns and the copy
+   * is written to local disk in the background while computation continues.
+   * Checkpoints alternate between two files per host. A file is only
+   * overwritten once every host has completed the checkpoint in the other
+   * one, so all hosts always share at least one complete checkpoint.
+   *
+   * Collective: all hosts must checkpoint at the same point, e.g. after the
+   * sync at the end of a round, so that masters and mirrors are consistent.
+   *
+   * @param checkpointFileName prefix of the checkpoint files
+   * @param tag value saved with the checkpoint, e.g. the current round;
+   * returned when the checkpoint is applied
+   */
+  void checkpointSaveNodeData(std::string checkpointFileName = "checkpoint",
+                              uint64_t tag                   = 0) {
+    galois::StatTimer TimerSaveCheckPoint(
+        get_run_identifier("TimerSaveCheckpoint").c_str(), RNAME);
+    static_assert(galois::runtime::is_memory_copyable<CheckpointNodeTy>::value,
+                  "node data must be memory copyable to be checkpointed");
+    TimerSaveCheckPoint.start();
+    // only one checkpoint is written at a time, and the file of the one
+    // before it is reused only when every host has completed the last one
+    checkpointWait();
+    galois::runtime::getHostBarrier().wait();
+
+    uint64_t numNodes = userGraph.size();
+    checkpointSnapshot.resize(numNodes * sizeof(CheckpointNodeTy));
+    uint8_t* snapshot = checkpointSnapshot.data();
+    galois::do_all(
+        galois::iterate(uint64_t{0}, numNodes),
+        [&](uint64_t n) {
+          std::memcpy(snapshot + n * sizeof(CheckpointNodeTy),
+                      static_cast<const void*>(&userGraph.getData(n)),
+                      sizeof(CheckpointNodeTy));
+        },
+        galois::no_stats(),
+        galois::loopname(get_run_identifier("CheckpointSnapshot").c_str()));
+
+    std::string fileName =
+        checkpointFile(checkpointFileName, numCheckpoints++ % 2);
+    checkpointThread = std::thread([this, fileName, numNodes, tag]() {
+      galois::runtime::CheckpointWriter w(fileName);
+      w.writeValue(checkpointMagic);
+      w.writeValue(id);
+      w.writeValue(numHosts);
+      w.writeValue(numNodes);
+      w.writeValue(uint64_t{sizeof(CheckpointNodeTy)});
+      w.writeValue(tag);
+      w.alignToPage();
+      w.write(checkpointSnapshot.data(), checkpointSnapshot.size());
+      w.commit();
+    });
+    TimerSaveCheckPoint.stop();
+
+    constexpr static const char* const RREGION = "RECOVERY";
+    galois::runtime::reportStat_Tsum(RREGION, "CheckpointBytesTotal",
+                                     checkpointSnapshot.size());
+  }
+
+  /**
+   * Waits until the checkpoint being written in the background, if any, is
+   * on disk.
+   */
+  void checkpointWait() {
+    if (checkpointThread.joinable()) {
+      checkpointThread.join();
+    }
+  }
+
+  /**
+   * Restores the data of all local nodes from the newest checkpoint that
+   * every host completed. Collective: all hosts must call it.
+   *
+   * @param checkpointFileName prefix of the checkpoint files
+   * @param tag if not null, set to the tag the checkpoint was saved with
+   * @returns false (leaving node data untouched) if some host has no
+   * checkpoint
+   */
+  bool checkpointApplyNodeData(std::string checkpointFileName = "checkpoint",
+                               uint64_t* tag                  = nullptr) {
+    galois::StatTimer TimerApplyCheckPoint(
+        get_run_identifier("TimerApplyCheckpoint").c_str(), RNAME);
+    static_assert(galois::runtime::is_memory_copyable<CheckpointNodeTy>::value,
+                  "node data must be memory copyable to be checkpointed");
+    TimerApplyCheckPoint.start();
+    checkpointWait();
+
+    // find the tags of the complete checkpoints on this host
+    uint64_t numNodes = userGraph.size();
+    uint64_t slotTags[2];
+    bool slotValid[2] = {false, false};
+    for (unsigned slot = 0; slot < 2; ++slot) {
+      std::string fileName = checkpointFile(checkpointFileName, slot);
+      if (!galois::runtime::CheckpointReader::exists(fileName)) {
+        continue;
+      }
+      galois::runtime::CheckpointReader r(fileName);
+      slotTags[slot]  = readCheckpointHeader(r, fileName);
+      slotValid[slot] = true;
+    }
+
+    // hosts may have failed between finishing their last checkpoints, so
+    // use the newest one all hosts have; since no host starts a checkpoint
+    // before all hosts completed the previous one, every host still has it
+    galois::DGAccumulator<unsigned> missing;
+    galois::DGReduceMin<uint64_t> newest;
+    missing.reset();
+    newest.reset();
+    if (slotValid[0] || slotValid[1]) {
+      newest.update(std::max(slotValid[0] ? slotTags[0] : 0,
+                             slotValid[1] ? slotTags[1] : 0));
+    } else {
+      missing += 1;
+    }
+    if (missing.reduce() != 0) {
+      TimerApplyCheckPoint.stop();
+      return false;
+    }
+    uint64_t common = newest.reduce();
+    unsigned slot   = (slotValid[0] && slotTags[0] == common) ? 0 : 1;
+    if (!slotValid[slot] || slotTags[slot] != common) {
+      GALOIS_DIE("[", id, "] has no checkpoint with tag ", common);
+    }
+
+    std::string fileName = checkpointFile(checkpointFileName, slot);
+    galois::gPrint("[", id, "] Reading local checkpoint from ", fileName,
+                   "\n");
+    galois::runtime::CheckpointReader r(fileName);
+    readCheckpointHeader(r, fileName);
+    r.alignToPage();
+    checkpointSnapshot.resize(numNodes * sizeof(CheckpointNodeTy));
+    r.read(checkpointSnapshot.data(), checkpointSnapshot.size());
+    const uint8_t* snapshot = checkpointSnapshot.data();
+    galois::do_all(
+        galois::iterate(uint64_t{0}, numNodes),
+        [&](uint64_t n) {
+          std::memcpy(static_cast<void*>(&userGraph.getData(n)),
+                      snapshot + n * sizeof(CheckpointNodeTy),
+                      sizeof(CheckpointNodeTy));
+        },
+        galois::no_stats(),
+        galois::loopname(get_run_identifier("CheckpointRestore").c_str()));
+
+    if (tag) {
+      *tag = common;
+    }
+    TimerApplyCheckPoint.stop();
+    return true;
+  }
 };
 
 template <typename GraphTy>
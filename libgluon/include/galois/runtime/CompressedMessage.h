@@ -0,0 +1,150 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file CompressedMessage.h
+ *
+ * Wire format of the compressed Gluon sync messages: the offsets (or global
+ * ids) and integral values of a message are delta+varint encoded.
+ */
+#pragma once
+
+#include "galois/DynamicBitset.h"
+#include "galois/runtime/DataCommMode.h"
+#include "galois/runtime/DeltaVarint.h"
+#include "galois/runtime/Network.h"
+
+namespace galois {
+namespace runtime {
+
+/**
+ * Encodes the parts of a message that compress: offsets (or global ids) for
+ * offsetsData and gidsData, and the values if they are integral.
+ *
+ * @param data_mode uncompressed mode of the message
+ * @param bit_set_count number of items in the message
+ * @param offsets offsets (or global ids) of the items
+ * @param val_vec values of the items
+ * @param compressedOffsets output: encoded offsets
+ * @param compressedValues output: encoded values
+ * @returns number of bytes the encoded parts take uncompressed
+ */
+template <typename VecType>
+size_t compressMessage(DataCommMode data_mode, size_t bit_set_count,
+                       const galois::PODResizeableArray<unsigned int>& offsets,
+                       const VecType& val_vec,
+                       galois::PODResizeableArray<uint8_t>& compressedOffsets,
+                       galois::PODResizeableArray<uint8_t>& compressedValues) {
+  using ValTy = typename VecType::value_type;
+  size_t rawSize = 0;
+  compressedOffsets.clear();
+  compressedValues.clear();
+  if (data_mode == offsetsData || data_mode == gidsData) {
+    deltaVarintEncode(offsets.data(), bit_set_count, compressedOffsets);
+    rawSize += bit_set_count * sizeof(unsigned int);
+  }
+  if constexpr (std::is_integral<ValTy>::value) {
+    deltaVarintEncode(val_vec.data(), val_vec.size(), compressedValues);
+    rawSize += val_vec.size() * sizeof(ValTy);
+  }
+  return rawSize;
+}
+
+/**
+ * Serializes a message encoded by compressMessage, starting with its
+ * compressed data mode.
+ *
+ * @param b buffer to serialize into
+ * @param data_mode uncompressed mode of the message
+ * @param bit_set_count number of items in the message
+ * @param bit_set_comm bitset of the items for bitsetData
+ * @param compressedOffsets encoded offsets
+ * @param compressedValues encoded values
+ * @param val_vec values of the items, sent as is if they are not integral
+ */
+template <typename VecType>
+void serializeCompressedMessage(
+    SendBuffer& b, DataCommMode data_mode, size_t bit_set_count,
+    const galois::DynamicBitSet& bit_set_comm,
+    const galois::PODResizeableArray<uint8_t>& compressedOffsets,
+    const galois::PODResizeableArray<uint8_t>& compressedValues,
+    const VecType& val_vec) {
+  constexpr bool compressValues =
+      std::is_integral<typename VecType::value_type>::value;
+  DataCommMode compressed_mode = compressedDataMode(data_mode);
+  if (data_mode == bitsetData) {
+    gSerialize(b, compressed_mode, bit_set_count, bit_set_comm,
+               compressedValues);
+  } else if (data_mode == onlyData) {
+    gSerialize(b, compressed_mode, compressedValues);
+  } else if constexpr (compressValues) {
+    gSerialize(b, compressed_mode, bit_set_count, compressedOffsets,
+               compressedValues);
+  } else {
+    gSerialize(b, compressed_mode, bit_set_count, compressedOffsets, val_vec);
+  }
+}
+
+/**
+ * Deserializes and decodes the rest of a message written by
+ * serializeCompressedMessage; its data mode has already been read. Dies if
+ * the encoded parts are shorter than the message claims.
+ *
+ * @param buf buffer positioned after the data mode
+ * @param data_mode compressed data mode of the message
+ * @param num number of nodes shared with the sending host
+ * @param bit_set_count output: number of items in the message; must be num
+ * on entry for onlyDataCompressed
+ * @param offsets output: decoded offsets (or global ids)
+ * @param bit_set_comm output: bitset of items for bitsetDataCompressed
+ * @param val_vec output: decoded values
+ * @param scratch buffer the encoded bytes are read into
+ */
+template <typename VecType>
+void deserializeCompressedMessage(
+    RecvBuffer& buf, DataCommMode data_mode, uint32_t num,
+    size_t& bit_set_count, galois::PODResizeableArray<unsigned int>& offsets,
+    galois::DynamicBitSet& bit_set_comm, VecType& val_vec,
+    galois::PODResizeableArray<uint8_t>& scratch) {
+  if (data_mode != onlyDataCompressed) {
+    gDeserialize(buf, bit_set_count);
+  }
+  if (data_mode == bitsetDataCompressed) {
+    bit_set_comm.resize(num);
+    gDeserialize(buf, bit_set_comm);
+  } else if (data_mode == offsetsDataCompressed ||
+             data_mode == gidsDataCompressed) {
+    gDeserialize(buf, scratch);
+    offsets.resize(bit_set_count);
+    deltaVarintDecode(scratch.data(), scratch.data() + scratch.size(),
+                      offsets.data(), bit_set_count);
+  }
+
+  if constexpr (std::is_integral<typename VecType::value_type>::value) {
+    gDeserialize(buf, scratch);
+    val_vec.resize(bit_set_count);
+    deltaVarintDecode(scratch.data(), scratch.data() + scratch.size(),
+                      val_vec.data(), bit_set_count);
+  } else {
+    gDeserialize(buf, val_vec);
+  }
+}
+
+} // namespace runtime
+} // namespace galois
@@ -37,9 +37,49 @@ enum DataCommMode {
   gidsData,
   onlyData,
   dataSplitFirst, // NOT USED
-  dataSplit       // NOT USED
+  dataSplit,      // NOT USED
+  //! offsetsData with delta+varint offsets (and integral values)
+  offsetsDataCompressed,
+  //! gidsData with delta+varint global ids (and integral values)
+  gidsDataCompressed,
+  //! bitsetData with delta+varint integral values
+  bitsetDataCompressed,
+  //! onlyData with delta+varint integral values
+  onlyDataCompressed
 };
 
+//! Returns the compressed counterpart of an uncompressed data mode
+inline DataCommMode compressedDataMode(DataCommMode mode) {
+  switch (mode) {
+  case offsetsData:
+    return offsetsDataCompressed;
+  case gidsData:
+    return gidsDataCompressed;
+  case bitsetData:
+    return bitsetDataCompressed;
+  case onlyData:
+    return onlyDataCompressed;
+  default:
+    return mode;
+  }
+}
+
+//! Returns the uncompressed data mode a compressed data mode decodes into
+inline DataCommMode uncompressedDataMode(DataCommMode mode) {
+  switch (mode) {
+  case offsetsDataCompressed:
+    return offsetsData;
+  case gidsDataCompressed:
+    return gidsData;
+  case bitsetDataCompressed:
+    return bitsetData;
+  case onlyDataCompressed:
+    return onlyData;
+  default:
+    return mode;
+  }
+}
+
 //! If some mode is to be enforced, set this variable
 //! @todo using a global is not great, but current problem is that GPU code
 //! assumes variable and would take some reorg to fix
@@ -0,0 +1,110 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file DeltaVarint.h
+ *
+ * Delta + variable-length integer codec used to compress the offsets and
+ * integral values sent during Gluon synchronization.
+ */
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "galois/PODResizeableArray.h"
+#include "galois/gIO.h"
+
+namespace galois {
+namespace runtime {
+
+/**
+ * Appends the encoding of n integers to out. Each element is stored as the
+ * difference from its predecessor, zigzagged so small negative steps stay
+ * small, in little-endian base 128 (7 bits per byte, high bit = more).
+ *
+ * @tparam T integral element type (at most 64 bits)
+ * @param in elements to encode
+ * @param n number of elements to encode
+ * @param out byte array the encoding is appended to
+ */
+template <typename T>
+void deltaVarintEncode(const T* in, size_t n,
+                       galois::PODResizeableArray<uint8_t>& out) {
+  static_assert(std::is_integral<T>::value && sizeof(T) <= sizeof(uint64_t),
+                "only integers can be delta encoded");
+  size_t pos = out.size();
+  // worst case is 10 bytes per 64 bit element
+  out.resize(pos + n * ((sizeof(T) * 8 + 6) / 7 + 1));
+  uint8_t* dst  = out.data() + pos;
+  uint64_t prev = 0;
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t cur  = static_cast<uint64_t>(in[i]);
+    int64_t delta = static_cast<int64_t>(cur - prev);
+    uint64_t zz   = ((cur - prev) << 1) ^ static_cast<uint64_t>(delta >> 63);
+    prev          = cur;
+    while (zz >= 0x80) {
+      *dst++ = static_cast<uint8_t>(zz) | 0x80;
+      zz >>= 7;
+    }
+    *dst++ = static_cast<uint8_t>(zz);
+  }
+  out.resize(dst - out.data());
+}
+
+/**
+ * Decodes n integers written by deltaVarintEncode.
+ *
+ * @tparam T integral element type; must match the encoded type
+ * @param in encoded bytes
+ * @param end one past the last encoded byte
+ * @param out destination for n elements
+ * @param n number of elements to decode
+ * @returns pointer one past the last byte consumed; dies if the encoding of
+ * the n elements does not fit between in and end
+ */
+template <typename T>
+const uint8_t* deltaVarintDecode(const uint8_t* in, const uint8_t* end, T* out,
+                                 size_t n) {
+  static_assert(std::is_integral<T>::value && sizeof(T) <= sizeof(uint64_t),
+                "only integers can be delta encoded");
+  uint64_t prev = 0;
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t zz    = 0;
+    unsigned shift = 0;
+    uint8_t byte;
+    do {
+      if (in == end) {
+        GALOIS_DIE("delta varint stream ends inside element ", i, " of ", n);
+      }
+      if (shift >= 64) {
+        GALOIS_DIE("delta varint element ", i, " is longer than 64 bits");
+      }
+      byte = *in++;
+      zz |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      shift += 7;
+    } while (byte & 0x80);
+    prev += (zz >> 1) ^ (~(zz & 1) + 1);
+    out[i] = static_cast<T>(prev);
+  }
+  return in;
+}
+
+} // namespace runtime
+} // namespace galois
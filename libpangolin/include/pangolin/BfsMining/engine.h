@@ -13,6 +13,8 @@ int main(int argc, char** argv) {
   galois::StatTimer Tinitial("GraphReadingTime");
   Tinitial.start();
   miner.read_graph(filetype, inputFile);
+  if (hubMemory)
+    miner.build_hub_index(hubDegree, uint64_t(hubMemory) << 20);
   Tinitial.stop();
   ResourceManager rm;
   for (unsigned nt = 0; nt < num_trials; nt++) {
@@ -72,23 +72,18 @@ protected:
   static inline bool is_connected(PangolinGraph& g, unsigned a, unsigned b) {
     if (g.get_degree(a) == 0 || g.get_degree(b) == 0)
       return false;
-    unsigned key    = a;
-    unsigned search = b;
-    if (g.get_degree(a) < g.get_degree(b)) {
-      key    = b;
-      search = a;
-    }
-    auto begin = g.edge_begin(search);
-    auto end   = g.edge_end(search);
-    return binary_search(g, key, begin, end);
+    // test the bitmap of a hub if there is one, otherwise search the shorter
+    // list
+    if (g.getHubIndex().isHub(b) ||
+        (!g.getHubIndex().isHub(a) && g.get_degree(b) < g.get_degree(a)))
+      return g.hasEdge(b, a);
+    return g.hasEdge(a, b);
   }
   static inline int is_connected_dag(PangolinGraph& g, unsigned key,
                                      unsigned search) {
     if (g.get_degree(search) == 0)
       return false;
-    auto begin = g.edge_begin(search);
-    auto end   = g.edge_end(search);
-    return binary_search(g, key, begin, end);
+    return g.hasEdge(search, key);
   }
   static inline bool binary_search(PangolinGraph& g, unsigned key,
                                    PangolinGraph::edge_iterator begin,
@@ -59,6 +59,13 @@ public:
     outfile.close();
     exit(0);
   }
+  //! Builds adjacency bitmaps of the nodes with at least minDegree
+  //! neighbors, using at most memoryBudget bytes
+  void build_hub_index(uint64_t minDegree, uint64_t memoryBudget) {
+    graph.buildHubIndex(minDegree, memoryBudget);
+    std::cout << "Hub index: " << graph.getHubIndex().size() << " hubs, "
+              << graph.getHubIndex().memoryUsage() / (1 << 20) << " MB\n";
+  }
   unsigned read_pattern(std::string filename, std::string filetype = "gr",
                         bool symmetric = false) {
     unsigned max_deg = util::read_graph(pattern, filetype, filename, false);
@@ -188,62 +195,15 @@ protected:
     return std::distance(g->edge_begin(vid), g->edge_end(vid));
   }
   inline unsigned intersect_merge(unsigned src, unsigned dst) {
-    unsigned count = 0;
-    for (auto e : graph.edges(dst)) {
-      GNode dst_dst = graph.getEdgeDst(e);
-      for (auto e1 : graph.edges(src)) {
-        GNode to = graph.getEdgeDst(e1);
-        if (dst_dst == to) {
-          count += 1;
-          break;
-        }
-        if (to > dst_dst)
-          break;
-      }
-    }
-    return count;
+    return graph.countCommonNeighbors(src, dst);
   }
   inline unsigned intersect_dag_merge(unsigned p, unsigned q) {
-    unsigned count = 0;
-    auto p_start   = graph.edge_begin(p);
-    auto p_end     = graph.edge_end(p);
-    auto q_start   = graph.edge_begin(q);
-    auto q_end     = graph.edge_end(q);
-    auto p_it      = p_start;
-    auto q_it      = q_start;
-    int a;
-    int b;
-    while (p_it < p_end && q_it < q_end) {
-      a     = graph.getEdgeDst(p_it);
-      b     = graph.getEdgeDst(q_it);
-      int d = a - b;
-      if (d <= 0)
-        p_it++;
-      if (d >= 0)
-        q_it++;
-      if (d == 0)
-        count++;
-    }
-    return count;
+    return graph.countCommonNeighbors(p, q);
   }
+  // countCommonNeighbors gallops over the larger list when the degrees are
+  // skewed, which is what searching each key of the smaller list amounts to
   inline unsigned intersect_search(unsigned a, unsigned b) {
-    if (degrees[a] == 0 || degrees[b] == 0)
-      return 0;
-    unsigned count  = 0;
-    unsigned lookup = a;
-    unsigned search = b;
-    if (degrees[a] > degrees[b]) {
-      lookup = b;
-      search = a;
-    }
-    auto begin = graph.edge_begin(search);
-    auto end   = graph.edge_end(search);
-    for (auto e : graph.edges(lookup)) {
-      GNode key = graph.getEdgeDst(e);
-      if (binary_search(key, begin, end))
-        count++;
-    }
-    return count;
+    return intersect_merge(a, b);
   }
   inline bool is_all_connected_except(unsigned dst, unsigned pos,
                                       const EmbeddingTy& emb) {
@@ -319,24 +279,17 @@ protected:
   inline bool is_connected(unsigned a, unsigned b) {
     if (degrees[a] == 0 || degrees[b] == 0)
       return false;
-    unsigned key    = a;
-    unsigned search = b;
-    if (degrees[a] < degrees[b]) {
-      key    = b;
-      search = a;
-    }
-    auto begin = graph.edge_begin(search);
-    auto end   = graph.edge_end(search);
-    // return serial_search(key, begin, end);
-    return binary_search(key, begin, end);
+    // the graph is symmetric: test the bitmap of a hub if there is one,
+    // otherwise search the shorter list
+    if (graph.getHubIndex().isHub(b) ||
+        (!graph.getHubIndex().isHub(a) && degrees[b] < degrees[a]))
+      return graph.hasEdge(b, a);
+    return graph.hasEdge(a, b);
   }
   inline int is_connected_dag(unsigned key, unsigned search) {
     if (degrees[search] == 0)
       return false;
-    auto begin = graph.edge_begin(search);
-    auto end   = graph.edge_end(search);
-    // return serial_search(key, begin, end);
-    return binary_search(key, begin, end);
+    return graph.hasEdge(search, key);
   }
   inline bool serial_search(unsigned key, PangolinGraph::edge_iterator begin,
                             PangolinGraph::edge_iterator end) {
@@ -332,6 +332,8 @@ int main(int argc, char** argv) {
   galois::graphs::readGraph(graph, inputFile);
   std::cout << "Read " << graph.size() << " nodes, " << graph.sizeEdges()
             << " edges\n";
+  galois::graphs::NodeRelabeling relabeling;
+  LonestarRelabel(graph, relabeling);
 
   if (startNode >= graph.size() || reportNode >= graph.size()) {
     std::cerr << "failed to set report: " << reportNode
@@ -340,10 +342,10 @@ int main(int argc, char** argv) {
   }
 
   auto it = graph.begin();
-  std::advance(it, startNode.getValue());
+  std::advance(it, relabeling.toNew(startNode));
   source = *it;
   it     = graph.begin();
-  std::advance(it, reportNode.getValue());
+  std::advance(it, relabeling.toNew(reportNode));
   report = *it;
 
   size_t approxNodeData = 4 * (graph.size() + graph.sizeEdges());
@@ -20,6 +20,8 @@
 #ifndef LONESTAR_PAGERANK_CONSTANTS_H
 #define LONESTAR_PAGERANK_CONSTANTS_H
 
+#include "galois/graphs/GraphOrdering.h"
+
 #include <iostream>
 
 #define DEBUG 0
@@ -75,8 +77,12 @@ PRTy atomicAdd(std::atomic<PRTy>& v, PRTy delta) {
   return old;
 }
 
+//! Prints the nodes with the highest rank, with ids translated back to the
+//! input graph if it was relabeled
 template <typename Graph>
-void printTop(Graph& graph, unsigned topn = PRINT_TOP) {
+void printTop(Graph& graph, const galois::graphs::NodeRelabeling& relabeling =
+                                galois::graphs::NodeRelabeling(),
+              unsigned topn = PRINT_TOP) {
 
   using GNode = typename Graph::GraphNode;
   typedef TopPair<GNode> Pair;
@@ -104,7 +110,8 @@ void printTop(Graph& graph, unsigned topn = PRINT_TOP) {
   int rank = 1;
   std::cout << "Rank PageRank Id\n";
   for (auto ii = top.rbegin(), ei = top.rend(); ii != ei; ++ii, ++rank) {
-    std::cout << rank << ": " << ii->first.value << " " << ii->first.id << "\n";
+    std::cout << rank << ": " << ii->first.value << " "
+              << relabeling.toOld(ii->first.id) << "\n";
   }
 }
 
@@ -53,6 +53,7 @@ struct LNode {
 typedef galois::graphs::LC_CSR_Graph<LNode, void>::with_no_lockable<
     true>::type ::with_numa_alloc<true>::type Graph;
 typedef typename Graph::GraphNode GNode;
+typedef typename Graph::edge_iterator EdgeIter;
 
 using DeltaArray    = galois::LargeArray<PRTy>;
 using ResidualArray = galois::LargeArray<PRTy>;
@@ -155,22 +156,26 @@ void computePRResidual(Graph& graph, DeltaArray& delta,
         },
         galois::no_stats(), galois::loopname("PageRank_delta"));
 
+    //! Balanced by edges so that the in-edges of hubs are summed by several
+    //! threads.
     galois::do_all(
-        galois::iterate(graph),
-        [&](const GNode& src) {
+        galois::iterate_edges_balanced(graph),
+        [&](const GNode&, EdgeIter ii, EdgeIter ei) {
           float sum = 0;
-          for (auto nbr : graph.edges(src)) {
-            GNode dst = graph.getEdgeDst(nbr);
+          for (; ii != ei; ++ii) {
+            GNode dst = graph.getEdgeDst(ii);
             if (delta[dst] > 0) {
               sum += delta[dst];
             }
           }
+          return sum;
+        },
+        galois::edge_reduce([&](const GNode& src, float sum) {
           if (sum > 0) {
             residual[src] = sum;
           }
-        },
-        galois::steal(), galois::chunk_size<CHUNK_SIZE>(), galois::no_stats(),
-        galois::loopname("PageRank"));
+        }),
+        galois::steal(), galois::no_stats(), galois::loopname("PageRank"));
 
 #if DEBUG
     std::cout << "iteration: " << iterations << "\n";
@@ -199,23 +204,25 @@ void computePRTopological(Graph& graph) {
 
   float base_score = (1.0f - ALPHA) / graph.size();
   while (true) {
-    galois::do_all(
-        galois::iterate(graph),
-        [&](const GNode& src) {
-          constexpr const galois::MethodFlag flag =
-              galois::MethodFlag::UNPROTECTED;
+    constexpr const galois::MethodFlag flag = galois::MethodFlag::UNPROTECTED;
 
-          LNode& sdata = graph.getData(src, flag);
-          float sum    = 0.0;
+    //! Balanced by edges so that the in-edges of hubs are summed by several
+    //! threads.
+    galois::do_all(
+        galois::iterate_edges_balanced(graph),
+        [&](const GNode&, EdgeIter jj, EdgeIter ej) {
+          float sum = 0.0;
 
-          for (auto jj = graph.edge_begin(src, flag),
-                    ej = graph.edge_end(src, flag);
-               jj != ej; ++jj) {
+          for (; jj != ej; ++jj) {
             GNode dst = graph.getEdgeDst(jj);
 
             LNode& ddata = graph.getData(dst, flag);
             sum += ddata.value / ddata.nout;
           }
+          return sum;
+        },
+        galois::edge_reduce([&](const GNode& src, float sum) {
+          LNode& sdata = graph.getData(src, flag);
 
           //! New value of pagerank after computing contributions from
           //! incoming edges in the original graph.
@@ -227,9 +234,8 @@ void computePRTopological(Graph& graph) {
           //! there is a data dependence on the pagerank value.
           sdata.value = value;
           accum += diff;
-        },
-        galois::no_stats(), galois::steal(), galois::chunk_size<CHUNK_SIZE>(),
-        galois::loopname("PageRank"));
+        }),
+        galois::no_stats(), galois::steal(), galois::loopname("PageRank"));
 
 #if DEBUG
     std::cout << "iteration: " << iteration << " max delta: " << delta << "\n";
@@ -295,6 +301,8 @@ int main(int argc, char** argv) {
             << "Reading graph: " << inputFile << "\n";
 
   galois::graphs::readGraph(transposeGraph, inputFile);
+  galois::graphs::NodeRelabeling relabeling;
+  LonestarRelabel(transposeGraph, relabeling);
   std::cout << "Read " << transposeGraph.size() << " nodes, "
             << transposeGraph.sizeEdges() << " edges\n";
 
@@ -349,7 +357,7 @@ int main(int argc, char** argv) {
   galois::gInfo("Sum is ", rSum);
 
   if (!skipVerify) {
-    printTop(transposeGraph);
+    printTop(transposeGraph, relabeling);
   }
 
 #if DEBUG
@@ -196,6 +196,8 @@ int main(int argc, char** argv) {
 
   Graph graph;
   galois::graphs::readGraph(graph, inputFile);
+  galois::graphs::NodeRelabeling relabeling;
+  LonestarRelabel(graph, relabeling);
   std::cout << "Read " << graph.size() << " nodes, " << graph.sizeEdges()
             << " edges\n";
 
@@ -234,7 +236,7 @@ int main(int argc, char** argv) {
   galois::reportPageAlloc("MeminfoPost");
 
   if (!skipVerify) {
-    printTop(graph);
+    printTop(graph, relabeling);
   }
 
 #if DEBUG
@@ -33,6 +33,7 @@
 #include <utility>
 #include <algorithm>
 #include <iostream>
+#include <vector>
 
 namespace cll = llvm::cl;
 
@@ -40,13 +41,16 @@ static const char* name = "Boruvka's Minimum Spanning Tree Algorithm";
 static const char* desc = "Computes the minimum spanning forest of a graph";
 static const char* url  = "mst";
 
-enum Algo { parallel, exp_parallel };
+enum Algo { parallel, exp_parallel, kruskal };
 
 static cll::opt<std::string>
     inputFilename(cll::Positional, cll::desc("<input file>"), cll::Required);
 static cll::opt<Algo>
     algo("algo", cll::desc("Choose an algorithm (default value parallel):"),
-         cll::values(clEnumVal(parallel, "Parallel")), cll::init(parallel));
+         cll::values(clEnumVal(parallel, "Parallel"),
+                     clEnumVal(kruskal, "Kruskal's algorithm on the ordered "
+                                        "executor")),
+         cll::init(parallel));
 
 typedef int EdgeData;
 
@@ -382,6 +386,65 @@ struct ParallelAlgo {
   }
 };
 
+/**
+ * Kruskal's algorithm on the ordered executor. Edges are added in order of
+ * weight unless they close a cycle. The neighborhood of an edge is the pair
+ * of components it connects, so edges between disjoint components commit in
+ * parallel.
+ */
+struct KruskalAlgo : public ParallelAlgo<false> {
+  //! Conflict detection for components, striped by representative
+  std::vector<galois::runtime::Lockable> locks;
+
+  galois::runtime::Lockable* lockOf(const Node* rep) {
+    uintptr_t i = reinterpret_cast<uintptr_t>(rep) / sizeof(Node);
+    return &locks[i % locks.size()];
+  }
+
+  void operator()() {
+    galois::InsertBag<Edge> bag;
+    galois::do_all(
+        galois::iterate(graph),
+        [&](const GNode& src) {
+          for (auto ii : graph.edges(src, galois::MethodFlag::UNPROTECTED)) {
+            GNode dst = graph.getEdgeDst(ii);
+            if (src < dst)
+              bag.push(Edge(src, dst, &graph.getEdgeData(ii)));
+          }
+        },
+        galois::steal(), galois::loopname("KruskalEdges"));
+
+    std::vector<Edge> edges(bag.begin(), bag.end());
+    locks.resize(graph.size());
+
+    auto lighter = [](const Edge& a, const Edge& b) {
+      return *a.weight < *b.weight;
+    };
+
+    auto nhFunc = [&](const Edge& e) {
+      Node& sdata = graph.getData(e.src, galois::MethodFlag::UNPROTECTED);
+      Node& ddata = graph.getData(e.dst, galois::MethodFlag::UNPROTECTED);
+      Node* srep  = sdata.find();
+      Node* drep  = ddata.find();
+      // An edge within a component stays so; it needs no neighborhood
+      if (srep == drep)
+        return;
+      galois::runtime::acquire(lockOf(srep), galois::MethodFlag::WRITE);
+      galois::runtime::acquire(lockOf(drep), galois::MethodFlag::WRITE);
+    };
+
+    auto opFunc = [&](const Edge& e, galois::UserContext<Edge>&) {
+      Node& sdata = graph.getData(e.src, galois::MethodFlag::UNPROTECTED);
+      Node& ddata = graph.getData(e.dst, galois::MethodFlag::UNPROTECTED);
+      if (sdata.merge(&ddata))
+        mst.push(e);
+    };
+
+    galois::for_each_ordered(edges.begin(), edges.end(), lighter, nhFunc,
+                             opFunc, "Kruskal");
+  }
+};
+
 template <typename Algo>
 void run() {
 
@@ -430,6 +493,9 @@ int main(int argc, char** argv) {
   case exp_parallel:
     run<ParallelAlgo<true>>();
     break;
+  case kruskal:
+    run<KruskalAlgo>();
+    break;
   default:
     std::cerr << "Unknown algo: " << algo << "\n";
   }
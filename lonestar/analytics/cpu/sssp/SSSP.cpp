@@ -59,6 +59,7 @@ enum Algo {
   deltaTile = 0,
   deltaStep,
   deltaStepBarrier,
+  deltaStepBuckets,
   serDeltaTile,
   serDelta,
   dijkstraTile,
@@ -69,15 +70,18 @@ enum Algo {
 };
 
 const char* const ALGO_NAMES[] = {
-    "deltaTile", "deltaStep",    "deltaStepBarrier", "serDeltaTile",
-    "serDelta",  "dijkstraTile", "dijkstra",         "topo",
-    "topoTile",  "Auto"};
+    "deltaTile",    "deltaStep", "deltaStepBarrier", "deltaStepBuckets",
+    "serDeltaTile", "serDelta",  "dijkstraTile",     "dijkstra",
+    "topo",         "topoTile",  "Auto"};
 
 static cll::opt<Algo> algo(
     "algo", cll::desc("Choose an algorithm (default value auto):"),
     cll::values(clEnumVal(deltaTile, "deltaTile"),
                 clEnumVal(deltaStep, "deltaStep"),
                 clEnumVal(deltaStepBarrier, "deltaStepBarrier"),
+                clEnumVal(deltaStepBuckets,
+                          "deltaStepBuckets: delta-stepping on a circular "
+                          "array of buckets"),
                 clEnumVal(serDeltaTile, "serDeltaTile"),
                 clEnumVal(serDelta, "serDelta"),
                 clEnumVal(dijkstraTile, "dijkstraTile"),
@@ -114,6 +118,7 @@ using OBIM    = gwl::OrderedByIntegerMetric<UpdateRequestIndexer, PSchunk>;
 using OBIM_Barrier =
     gwl::OrderedByIntegerMetric<UpdateRequestIndexer,
                                 PSchunk>::with_barrier<true>::type;
+using Buckets = gwl::MonotoneBucketWL<UpdateRequestIndexer, PSchunk>;
 
 template <typename T, typename OBIMTy = OBIM, typename P, typename R>
 void deltaStepAlgo(Graph& graph, GNode source, const P& pushWrap,
@@ -455,6 +460,11 @@ int main(int argc, char** argv) {
                                                OutEdgeRangeFn{graph});
     break;
 
+  case deltaStepBuckets:
+    deltaStepAlgo<UpdateRequest, Buckets>(graph, source, ReqPushWrap(),
+                                          OutEdgeRangeFn{graph});
+    break;
+
   default:
     std::abort();
   }
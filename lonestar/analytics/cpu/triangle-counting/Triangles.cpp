@@ -22,8 +22,8 @@
 #include "galois/ParallelSTL.h"
 #include "galois/Reduction.h"
 #include "galois/Timer.h"
+#include "galois/graphs/Intersection.h"
 #include "galois/graphs/LCGraph.h"
-#include "galois/graphs/BufferedGraph.h"
 #include "galois/runtime/Profile.h"
 #include "llvm/Support/CommandLine.h"
 #include "Lonestar/Utils.h"
@@ -94,30 +94,6 @@ Iterator lowerBound(Iterator first, Iterator last, Compare comp) {
   return first;
 }
 
-/**
- * std::set_intersection over edge_iterators.
- */
-template <typename G>
-size_t countEqual(G& g, typename G::edge_iterator aa,
-                  typename G::edge_iterator ea, typename G::edge_iterator bb,
-                  typename G::edge_iterator eb) {
-  size_t retval = 0;
-  while (aa != ea && bb != eb) {
-    typename G::GraphNode a = g.getEdgeDst(aa);
-    typename G::GraphNode b = g.getEdgeDst(bb);
-    if (a < b) {
-      ++aa;
-    } else if (b < a) {
-      ++bb;
-    } else {
-      retval += 1;
-      ++aa;
-      ++bb;
-    }
-  }
-  return retval;
-}
-
 template <typename G>
 struct LessThan {
   G& g;
@@ -215,13 +191,8 @@ void nodeIteratingAlgo(Graph& graph) {
                 GNode B = graph.getEdgeDst(bb);
                 for (auto aa = first; aa != ea; ++aa) {
                   GNode A = graph.getEdgeDst(aa);
-                  Graph::edge_iterator vv =
-                      graph.edge_begin(A, galois::MethodFlag::UNPROTECTED);
-                  Graph::edge_iterator ev =
-                      graph.edge_end(A, galois::MethodFlag::UNPROTECTED);
-                  Graph::edge_iterator it =
-                      lowerBound(vv, ev, LessThan<Graph>(graph, B));
-                  if (it != ev && graph.getEdgeDst(it) == B) {
+                  if (galois::graphs::containsSorted(graph.edge_dst_begin(A),
+                                                     graph.getDegree(A), B)) {
                     numTriangles += 1;
                   }
                 }
@@ -242,31 +213,17 @@ void nodeIteratingAlgo(Graph& graph) {
 void orderedCountFunc(Graph& graph, GNode n,
                       galois::GAccumulator<size_t>& numTriangles) {
   size_t numTriangles_local = 0;
-  for (auto it_v : graph.edges(n)) {
-    auto v = graph.getEdgeDst(it_v);
-    if (v >= n)
-      break;
-    Graph::edge_iterator it_n =
-        graph.edge_begin(n, galois::MethodFlag::UNPROTECTED);
-
-    for (auto it_vv : graph.edges(v)) {
-      auto vv = graph.getEdgeDst(it_vv);
-      if (vv >= v)
-        break;
-      while (graph.getEdgeDst(it_n) < vv)
-        it_n++;
-      if (vv == graph.getEdgeDst(it_n)) {
-
-        Graph::edge_iterator multi_it_n = it_n;
-
-        while (multi_it_n !=
-                   graph.edge_end(n, galois::MethodFlag::UNPROTECTED) &&
-               graph.getEdgeDst(multi_it_n) == vv) {
-          numTriangles_local += 1;
-          multi_it_n++;
-        }
-      }
-    }
+  const uint32_t* nBegin    = graph.edge_dst_begin(n);
+  const uint32_t* nEnd      = graph.edge_dst_end(n);
+  for (const uint32_t* it_v = nBegin; it_v != nEnd && *it_v < n; ++it_v) {
+    GNode v = *it_v;
+    // common neighbors vv < v of v and n close the triangle vv < v < n; the
+    // neighbors of n smaller than v are exactly [nBegin, it_v)
+    const uint32_t* vBegin = graph.edge_dst_begin(v);
+    const uint32_t* vEnd =
+        std::lower_bound(vBegin, graph.edge_dst_end(v), v);
+    numTriangles_local += galois::graphs::countIntersection(
+        vBegin, vEnd - vBegin, nBegin, it_v - nBegin);
   }
   numTriangles += numTriangles_local;
 }
@@ -330,25 +287,18 @@ void edgeIteratingAlgo(Graph& graph) {
             [&](const WorkItem& w) {
               // Compute intersection of range (w.src, w.dst) in neighbors of
               // w.src and w.dst
-              Graph::edge_iterator abegin =
-                  graph.edge_begin(w.src, galois::MethodFlag::UNPROTECTED);
-              Graph::edge_iterator aend =
-                  graph.edge_end(w.src, galois::MethodFlag::UNPROTECTED);
-              Graph::edge_iterator bbegin =
-                  graph.edge_begin(w.dst, galois::MethodFlag::UNPROTECTED);
-              Graph::edge_iterator bend =
-                  graph.edge_end(w.dst, galois::MethodFlag::UNPROTECTED);
-
-              Graph::edge_iterator aa = lowerBound(
-                  abegin, aend, GreaterThanOrEqual<Graph>(graph, w.src));
-              Graph::edge_iterator ea =
-                  lowerBound(abegin, aend, LessThan<Graph>(graph, w.dst));
-              Graph::edge_iterator bb = lowerBound(
-                  bbegin, bend, GreaterThanOrEqual<Graph>(graph, w.src));
-              Graph::edge_iterator eb =
-                  lowerBound(bbegin, bend, LessThan<Graph>(graph, w.dst));
-
-              numTriangles += countEqual(graph, aa, ea, bb, eb);
+              const uint32_t* abegin = graph.edge_dst_begin(w.src);
+              const uint32_t* aend   = graph.edge_dst_end(w.src);
+              const uint32_t* bbegin = graph.edge_dst_begin(w.dst);
+              const uint32_t* bend   = graph.edge_dst_end(w.dst);
+
+              const uint32_t* aa = std::upper_bound(abegin, aend, w.src);
+              const uint32_t* ea = std::lower_bound(aa, aend, w.dst);
+              const uint32_t* bb = std::upper_bound(bbegin, bend, w.src);
+              const uint32_t* eb = std::lower_bound(bb, bend, w.dst);
+
+              numTriangles +=
+                  galois::graphs::countIntersection(aa, ea - aa, bb, eb - bb);
             },
             galois::loopname("edgeIteratingAlgo"),
             galois::chunk_size<CHUNK_SIZE>(), galois::steal());
@@ -359,112 +309,6 @@ void edgeIteratingAlgo(Graph& graph) {
   std::cout << "NumTriangles: " << numTriangles.reduce() << "\n";
 }
 
-//! Sorts read graph by degree (high degree nodes are reindexed to beginning)
-void makeSortedGraph(Graph& graph) {
-  galois::StatTimer readTimer("ReadGraphTimer");
-  readTimer.start();
-  // read original graph
-  galois::graphs::BufferedGraph<void> initial;
-  initial.loadGraph(inputFile);
-  readTimer.stop();
-
-  galois::StatTimer Trelabel("GraphRelabelTimer");
-  Trelabel.start();
-
-  size_t numGraphNodes = initial.size();
-  // create node -> degree pairs
-  using DegreeNodePair = std::pair<uint64_t, uint32_t>;
-  std::vector<DegreeNodePair> dnPairs(numGraphNodes);
-  galois::do_all(
-      galois::iterate(size_t{0}, numGraphNodes),
-      [&](size_t nodeID) {
-        size_t nodeDegree =
-            std::distance(initial.edgeBegin(nodeID), initial.edgeEnd(nodeID));
-        dnPairs[nodeID] = DegreeNodePair(nodeDegree, nodeID);
-      },
-      galois::loopname("CreateDegreeNodeVector"));
-
-  galois::StatTimer degSortTimer("DegreeSortTimer");
-  degSortTimer.start();
-  // sort by degree (first item)
-  galois::ParallelSTL::sort(dnPairs.begin(), dnPairs.end(),
-                            std::greater<DegreeNodePair>());
-  degSortTimer.stop();
-
-  // create mapping, get degrees out to another vector to get prefix sum
-  std::vector<uint32_t> oldToNewMapping(numGraphNodes);
-  std::vector<uint64_t> inProgressPrefixSum(numGraphNodes);
-  galois::do_all(
-      galois::iterate(size_t{0}, numGraphNodes),
-      [&](size_t index) {
-        // save degree, which is pair.first
-        inProgressPrefixSum[index] = dnPairs[index].first;
-        // save mapping; original index is in .second, map it to current index
-        oldToNewMapping[dnPairs[index].second] = index;
-      },
-      galois::loopname("CreateRemappingGetPrefixSum"));
-
-  std::vector<uint64_t> newPrefixSum(numGraphNodes);
-  galois::ParallelSTL::partial_sum(inProgressPrefixSum.begin(),
-                                   inProgressPrefixSum.end(),
-                                   newPrefixSum.begin());
-
-  // allocate graph
-  graph.allocateFrom(numGraphNodes, initial.sizeEdges());
-  // construct nodes
-  graph.constructNodes();
-  // set edge endpoints using prefix sum
-  galois::do_all(
-      galois::iterate(size_t{0}, numGraphNodes),
-      [&](size_t nodeIndex) {
-        graph.fixEndEdge(nodeIndex, newPrefixSum[nodeIndex]);
-      },
-      galois::loopname("SetEdgeEndpoints"));
-
-  // construct edges by looping through filegraph and saving to correct
-  // locations
-  galois::do_all(
-      galois::iterate(0u, initial.size()),
-      [&](uint32_t oldNodeID) {
-        uint32_t newIndex = oldToNewMapping[oldNodeID];
-
-        // get the start location of this reindex'd nodes edges
-        uint64_t currentEdgeIndex;
-        if (newIndex != 0) {
-          currentEdgeIndex = newPrefixSum[newIndex - 1];
-        } else {
-          currentEdgeIndex = 0;
-        }
-
-        // construct the graph, reindexing as it goes along
-        for (auto e = initial.edgeBegin(oldNodeID);
-             e < initial.edgeEnd(oldNodeID); e++) {
-          // get destination, reindex
-          uint32_t oldEdgeDst       = initial.edgeDestination(*e);
-          uint32_t reindexedEdgeDst = oldToNewMapping[oldEdgeDst];
-
-          // construct edge
-          graph.constructEdge(currentEdgeIndex, reindexedEdgeDst);
-          currentEdgeIndex++;
-        }
-        // this assert makes sure reindex was correct + makes sure all edges
-        // are accounted for
-        assert(currentEdgeIndex == newPrefixSum[newIndex]);
-      },
-      galois::steal(), galois::loopname("ReindexingGraph"));
-
-  galois::StatTimer edgeSortTimer("EdgeSortTimer");
-  edgeSortTimer.start();
-  // sort by destinations
-  graph.sortAllEdgesByDst();
-  edgeSortTimer.stop();
-
-  // initialize local ranges
-  graph.initializeLocalRanges();
-
-  Trelabel.stop();
-}
-
 void readGraph(Graph& graph) {
   galois::StatTimer autoAlgoTimer("AutoAlgo_0");
   if (!relabel) {
@@ -475,14 +319,21 @@ void readGraph(Graph& graph) {
     relabel = isApproximateDegreeDistributionPowerLaw(degreeGraph);
     autoAlgoTimer.stop();
   }
+  galois::graphs::readGraph(graph, inputFile);
+  // triangle counts do not depend on node ids, so no translation is needed
+  galois::graphs::NodeRelabeling relabeling;
   if (relabel) {
+    // high degree nodes are reindexed to the beginning
     galois::gInfo("Relabeling and sorting graph...");
-    makeSortedGraph(graph);
+    galois::StatTimer Trelabel("GraphRelabelTimer");
+    Trelabel.start();
+    galois::graphs::relabelByDegree(graph, relabeling);
+    Trelabel.stop();
   } else {
-    galois::graphs::readGraph(graph, inputFile);
-    // algorithm correctness requires sorting edges by destination
-    graph.sortAllEdgesByDst();
+    LonestarRelabel(graph, relabeling);
   }
+  // algorithm correctness requires sorting edges by destination
+  graph.sortAllEdgesByDst();
 }
 
 int main(int argc, char** argv) {
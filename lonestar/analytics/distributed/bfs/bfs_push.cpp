@@ -229,6 +229,9 @@ struct BFS {
       work_edges.reset();
       if (personality == GPU_CUDA) {
 #ifdef GALOIS_ENABLE_GPU
+        syncSubstrate->endSync<writeDestination, readSource,
+                               Reduce_min_dist_current, Bitset_dist_current,
+                               async>("BFS");
         std::string impl_str(syncSubstrate->get_run_identifier("BFS"));
         galois::StatTimer StatTimer_cuda(impl_str.c_str(), REGION_NAME);
         StatTimer_cuda.start();
@@ -242,14 +245,43 @@ struct BFS {
         abort();
 #endif
       } else if (personality == CPU) {
-        galois::do_all(
-            galois::iterate(nodesWithEdges),
-            BFS(priority, &_graph, dga, work_edges), galois::steal(),
-            galois::no_stats(),
-            galois::loopname(syncSubstrate->get_run_identifier("BFS").c_str()));
+        BFS op(priority, &_graph, dga, work_edges);
+        if (!syncSubstrate->syncWillSplit<writeDestination, readSource,
+                                          async>()) {
+          galois::do_all(
+              galois::iterate(nodesWithEdges), op, galois::steal(),
+              galois::no_stats(),
+              galois::loopname(
+                  syncSubstrate->get_run_identifier("BFS").c_str()));
+        } else {
+          // work on proxies the last round's sync cannot update overlaps
+          // with its pending receives
+          galois::do_all(
+              galois::iterate(nodesWithEdges),
+              [&](GNode src) {
+                if (!syncSubstrate->isSyncBoundary(src))
+                  op(src);
+              },
+              galois::steal(), galois::no_stats(),
+              galois::loopname(
+                  syncSubstrate->get_run_identifier("BFS").c_str()));
+          syncSubstrate->endSync<writeDestination, readSource,
+                                 Reduce_min_dist_current, Bitset_dist_current,
+                                 async>("BFS");
+          galois::do_all(
+              galois::iterate(nodesWithEdges),
+              [&](GNode src) {
+                if (syncSubstrate->isSyncBoundary(src))
+                  op(src);
+              },
+              galois::steal(), galois::no_stats(),
+              galois::loopname(
+                  syncSubstrate->get_run_identifier("BFS_Boundary").c_str()));
+        }
       }
-      syncSubstrate->sync<writeDestination, readSource, Reduce_min_dist_current,
-                          Bitset_dist_current, async>("BFS");
+      syncSubstrate->beginSync<writeDestination, readSource,
+                               Reduce_min_dist_current, Bitset_dist_current,
+                               async>("BFS");
 
       galois::runtime::reportStat_Tsum(
           REGION_NAME, syncSubstrate->get_run_identifier("NumWorkItems"),
@@ -258,6 +290,9 @@ struct BFS {
       ++_num_iterations;
     } while ((async || (_num_iterations < maxIterations)) &&
              dga.reduce(syncSubstrate->get_run_identifier()));
+    syncSubstrate->endSync<writeDestination, readSource,
+                           Reduce_min_dist_current, Bitset_dist_current,
+                           async>("BFS");
 
     galois::runtime::reportStat_Tmax(
         REGION_NAME,
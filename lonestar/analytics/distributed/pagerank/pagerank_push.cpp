@@ -235,8 +235,8 @@ struct PageRank {
   PageRank(Graph* _g, DGTerminatorDetector& _dga)
       : graph(_g), active_vertices(_dga) {}
 
-  void static go(Graph& _graph) {
-    unsigned _num_iterations   = 0;
+  void static go(Graph& _graph, unsigned startRound = 0) {
+    unsigned _num_iterations   = startRound;
     const auto& nodesWithEdges = _graph.allNodesWithEdgesRange();
     DGTerminatorDetector dga;
 
@@ -275,9 +275,18 @@ struct PageRank {
           REGION_NAME, "NumWorkItems_" + (syncSubstrate->get_run_identifier()),
           (unsigned long)dga.read_local());
 
+      // main clears checkpointInterval unless this is the CPU BSP loop:
+      // rounds only line up across hosts in bulk-synchronous execution and
+      // node data of GPU hosts lives on the device
+      if (!async && checkpointInterval &&
+          (_num_iterations + 1) % checkpointInterval == 0) {
+        syncSubstrate->checkpointSaveNodeData(checkpointFile, _num_iterations);
+      }
+
       ++_num_iterations;
     } while ((async || (_num_iterations < maxIterations)) &&
              dga.reduce(syncSubstrate->get_run_identifier()));
+    syncSubstrate->checkpointWait();
 
     if (galois::runtime::getSystemNetworkInterface().ID == 0) {
       galois::runtime::reportStat_Single(
@@ -494,6 +503,18 @@ int main(int argc, char** argv) {
     ss << tolerance;
     galois::runtime::reportParam(REGION_NAME, "Tolerance", ss.str());
   }
+
+  // checkpoints are only taken between the rounds of the CPU BSP loop
+  if ((checkpointInterval || restoreCheckpoint) &&
+      (personality != CPU || execution != Sync)) {
+    if (net.ID == 0) {
+      galois::gWarn("Command line options -checkpointInterval and "
+                    "-restoreCheckpoint ignored: checkpoints need CPU hosts "
+                    "and -exec=Sync");
+    }
+    checkpointInterval = 0;
+    restoreCheckpoint  = false;
+  }
   galois::StatTimer StatTimer_total("TimerTotal", REGION_NAME);
 
   StatTimer_total.start();
@@ -514,6 +535,16 @@ int main(int argc, char** argv) {
   InitializeGraph::go((*hg));
   galois::runtime::getHostBarrier().wait();
 
+  // resume from the round after the last checkpoint all hosts completed
+  unsigned startRound = 0;
+  if (restoreCheckpoint) {
+    uint64_t lastRound;
+    if (syncSubstrate->checkpointApplyNodeData(checkpointFile, &lastRound)) {
+      startRound = lastRound + 1;
+      galois::gPrint("[", net.ID, "] Resuming from round ", startRound, "\n");
+    }
+  }
+
   galois::DGAccumulator<float> DGA_sum;
   galois::DGAccumulator<float> DGA_sum_residual;
   galois::DGAccumulator<uint64_t> DGA_residual_over_tolerance;
@@ -531,7 +562,7 @@ int main(int argc, char** argv) {
     if (execution == Async) {
       PageRank<true>::go(*hg);
     } else {
-      PageRank<false>::go(*hg);
+      PageRank<false>::go(*hg, run == 0 ? startRound : 0);
     }
     StatTimer_main.stop();
 
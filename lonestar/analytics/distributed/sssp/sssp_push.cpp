@@ -227,6 +227,9 @@ struct SSSP {
       work_edges.reset();
       if (personality == GPU_CUDA) {
 #ifdef GALOIS_ENABLE_GPU
+        syncSubstrate->endSync<writeDestination, readSource,
+                               Reduce_min_dist_current, Bitset_dist_current,
+                               async>("SSSP");
         std::string impl_str("SSSP_" + (syncSubstrate->get_run_identifier()));
         galois::StatTimer StatTimer_cuda(impl_str.c_str(), REGION_NAME);
         StatTimer_cuda.start();
@@ -240,15 +243,46 @@ struct SSSP {
         abort();
 #endif
       } else if (personality == CPU) {
-        galois::do_all(
-            galois::iterate(nodesWithEdges),
-            SSSP{priority, &_graph, dga, work_edges}, galois::no_stats(),
-            galois::loopname(syncSubstrate->get_run_identifier("SSSP").c_str()),
-            galois::steal());
+        SSSP op{priority, &_graph, dga, work_edges};
+        if (!syncSubstrate->syncWillSplit<writeDestination, readSource,
+                                          async>()) {
+          galois::do_all(
+              galois::iterate(nodesWithEdges), op, galois::no_stats(),
+              galois::loopname(
+                  syncSubstrate->get_run_identifier("SSSP").c_str()),
+              galois::steal());
+        } else {
+          // work on proxies the last round's sync cannot update overlaps
+          // with its pending receives
+          galois::do_all(
+              galois::iterate(nodesWithEdges),
+              [&](GNode src) {
+                if (!syncSubstrate->isSyncBoundary(src))
+                  op(src);
+              },
+              galois::no_stats(),
+              galois::loopname(
+                  syncSubstrate->get_run_identifier("SSSP").c_str()),
+              galois::steal());
+          syncSubstrate->endSync<writeDestination, readSource,
+                                 Reduce_min_dist_current, Bitset_dist_current,
+                                 async>("SSSP");
+          galois::do_all(
+              galois::iterate(nodesWithEdges),
+              [&](GNode src) {
+                if (syncSubstrate->isSyncBoundary(src))
+                  op(src);
+              },
+              galois::no_stats(),
+              galois::loopname(
+                  syncSubstrate->get_run_identifier("SSSP_Boundary").c_str()),
+              galois::steal());
+        }
       }
 
-      syncSubstrate->sync<writeDestination, readSource, Reduce_min_dist_current,
-                          Bitset_dist_current, async>("SSSP");
+      syncSubstrate->beginSync<writeDestination, readSource,
+                               Reduce_min_dist_current, Bitset_dist_current,
+                               async>("SSSP");
 
       galois::runtime::reportStat_Tsum(
           "SSSP", "NumWorkItems_" + (syncSubstrate->get_run_identifier()),
@@ -256,6 +290,9 @@ struct SSSP {
       ++_num_iterations;
     } while ((async || (_num_iterations < maxIterations)) &&
              dga.reduce(syncSubstrate->get_run_identifier()));
+    syncSubstrate->endSync<writeDestination, readSource,
+                           Reduce_min_dist_current, Bitset_dist_current,
+                           async>("SSSP");
 
     galois::runtime::reportStat_Tmax(
         "SSSP", "NumIterations_" + std::to_string(syncSubstrate->get_run_num()),
@@ -29,6 +29,8 @@
 #include "galois/graphs/CuSPPartitioner.h"
 #include "llvm/Support/CommandLine.h"
 
+#include <typeinfo>
+
 /*******************************************************************************
  * Supported partitioning schemes
  ******************************************************************************/
@@ -109,6 +111,8 @@ extern cll::opt<std::string> localGraphFileName;
 extern cll::opt<bool> saveLocalGraph;
 //! file specifying blocking of masters
 extern cll::opt<std::string> mastersFile;
+//! directory of the partition cache; empty if disabled
+extern cll::opt<std::string> partitionCache;
 
 // @todo command line argument for read balancing across hosts
 
@@ -120,6 +124,86 @@ template <typename NodeData, typename EdgeData>
 using DistGraphPtr =
     std::unique_ptr<galois::graphs::DistGraph<NodeData, EdgeData>>;
 
+/**
+ * Returns the prefix of the files of a partition in the partition cache.
+ * The name contains a hash of the input file contents (and of the masters
+ * file, if any), the partitioning policy, the number of hosts, whether the
+ * input is symmetric and the input and output layouts, so a changed input
+ * never hits a stale entry.
+ * Collective: host 0 hashes the input and the result is shared with all
+ * hosts.
+ *
+ * @param inputType format of the input graph to partition
+ * @param outputType format of the partitions
+ * @param symmetric true if the input graph is symmetric; the input file is
+ * then partitioned whatever the input type
+ * @param policy name of the CuSP policy
+ * @param edgeDataSize size of the edge data stored in the partitions
+ * @param masterBlockFile file specifying blocking of masters
+ * @returns prefix of the cached local graph files
+ */
+std::string partitionCacheFile(galois::CUSP_GRAPH_TYPE inputType,
+                               galois::CUSP_GRAPH_TYPE outputType,
+                               bool symmetric, const std::string& policy,
+                               size_t edgeDataSize,
+                               const std::string& masterBlockFile);
+
+/**
+ * Returns true if the local graph of every host is in the partition cache.
+ * Collective.
+ *
+ * @param cacheFile prefix returned by partitionCacheFile
+ */
+bool partitionCached(const std::string& cacheFile);
+
+//! Creates the partition cache directory if it does not exist
+void createPartitionCache();
+
+/**
+ * Partitions the input graph with CuSP using the given policy, or reloads
+ * the partition saved by an earlier run with -saveLocalGraph if
+ * -readFromFile is set. If -partitionCache is set, the partition is loaded
+ * from the cache when possible and added to it otherwise.
+ *
+ * @tparam PartitionPolicy CuSP policy used to partition the graph
+ * @tparam NodeData node data to store in graph
+ * @tparam EdgeData edge data to store in graph
+ * @param inputType format of the input graph to partition
+ * @param outputType format of the partitions
+ * @param symmetric true if the input graph is symmetric
+ * @param masterBlockFile file specifying blocking of masters
+ * @returns a pointer to a newly allocated DistGraph
+ */
+template <typename PartitionPolicy, typename NodeData, typename EdgeData>
+DistGraphPtr<NodeData, EdgeData>
+partitionGraph(galois::CUSP_GRAPH_TYPE inputType,
+               galois::CUSP_GRAPH_TYPE outputType, bool symmetric,
+               std::string masterBlockFile = "") {
+  if (partitionCache.empty() || readFromFile) {
+    return galois::cuspPartitionGraph<PartitionPolicy, NodeData, EdgeData>(
+        inputFile, inputType, outputType, symmetric, inputFileTranspose,
+        masterBlockFile, true, 100, galois::graphs::BALANCED_EDGES_OF_MASTERS,
+        0, 0, readFromFile, localGraphFileName);
+  }
+
+  std::string cacheFile = partitionCacheFile(
+      inputType, outputType, symmetric, typeid(PartitionPolicy).name(),
+      galois::LargeArray<EdgeData>::size_of::value, masterBlockFile);
+  bool cached = partitionCached(cacheFile);
+  if (galois::runtime::getSystemNetworkInterface().ID == 0) {
+    galois::runtime::reportParam("DistBench", "PartitionCacheHit", cached);
+  }
+  auto graph = galois::cuspPartitionGraph<PartitionPolicy, NodeData, EdgeData>(
+      inputFile, inputType, outputType, symmetric, inputFileTranspose,
+      masterBlockFile, true, 100, galois::graphs::BALANCED_EDGES_OF_MASTERS, 0,
+      0, cached, cacheFile);
+  if (!cached) {
+    createPartitionCache();
+    graph->save_local_graph_to_file(cacheFile);
+  }
+  return graph;
+}
+
 /**
  * Loads a symmetric graph file (i.e. directed graph with edges in both
  * directions)
@@ -142,20 +226,17 @@ constructSymmetricGraph(std::vector<unsigned>& GALOIS_UNUSED(scaleFactor)) {
   switch (partitionScheme) {
   case OEC:
   case IEC:
-    return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, true, inputFileTranspose,
-        mastersFile);
+    return partitionGraph<NoCommunication, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true, mastersFile);
   case HOVC:
   case HIVC:
-    return galois::cuspPartitionGraph<GenericHVC, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, true,
-        inputFileTranspose);
+    return partitionGraph<GenericHVC, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true);
 
   case CART_VCUT:
   case CART_VCUT_IEC:
-    return galois::cuspPartitionGraph<GenericCVC, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, true,
-        inputFileTranspose);
+    return partitionGraph<GenericCVC, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true);
 
     // case CEC:
     //  return new Graph_customEdgeCut(inputFile, "", net.ID, net.Num,
@@ -163,20 +244,17 @@ constructSymmetricGraph(std::vector<unsigned>& GALOIS_UNUSED(scaleFactor)) {
 
   case GINGER_O:
   case GINGER_I:
-    return galois::cuspPartitionGraph<GingerP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, true,
-        inputFileTranspose);
+    return partitionGraph<GingerP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true);
 
   case FENNEL_O:
   case FENNEL_I:
-    return galois::cuspPartitionGraph<FennelP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, true,
-        inputFileTranspose);
+    return partitionGraph<FennelP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true);
 
   case SUGAR_O:
-    return galois::cuspPartitionGraph<SugarP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, true,
-        inputFileTranspose);
+    return partitionGraph<SugarP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true);
   default:
     GALOIS_DIE("partition scheme specified is invalid: ", partitionScheme);
     return DistGraphPtr<NodeData, EdgeData>(nullptr);
@@ -203,50 +281,43 @@ constructGraph(std::vector<unsigned>& GALOIS_UNUSED(scaleFactor)) {
   // 1 host = no concept of cut; just load from edgeCut, no transpose
   auto& net = galois::runtime::getSystemNetworkInterface();
   if (net.Num == 1) {
-    return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose);
+    return partitionGraph<NoCommunication, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
   }
 
   switch (partitionScheme) {
   case OEC:
-    return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose, mastersFile);
+    return partitionGraph<NoCommunication, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false, mastersFile);
   case IEC:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSR, false,
-          inputFileTranspose, mastersFile);
+      return partitionGraph<NoCommunication, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSR, false, mastersFile);
     } else {
       GALOIS_DIE("incoming edge cut requires transpose graph");
       break;
     }
 
   case HOVC:
-    return galois::cuspPartitionGraph<GenericHVC, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose);
+    return partitionGraph<GenericHVC, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
   case HIVC:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<GenericHVC, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSR, false,
-          inputFileTranspose);
+      return partitionGraph<GenericHVC, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSR, false);
     } else {
       GALOIS_DIE("incoming hybrid cut requires transpose graph");
       break;
     }
 
   case CART_VCUT:
-    return galois::cuspPartitionGraph<GenericCVC, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose);
+    return partitionGraph<GenericCVC, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
 
   case CART_VCUT_IEC:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<GenericCVC, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSR, false,
-          inputFileTranspose);
+      return partitionGraph<GenericCVC, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSR, false);
     } else {
       GALOIS_DIE("cvc incoming cut requires transpose graph");
       break;
@@ -257,37 +328,32 @@ constructGraph(std::vector<unsigned>& GALOIS_UNUSED(scaleFactor)) {
     //                                 scaleFactor, vertexIDMapFileName, false);
 
   case GINGER_O:
-    return galois::cuspPartitionGraph<GingerP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose);
+    return partitionGraph<GingerP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
   case GINGER_I:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<GingerP, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSR, false,
-          inputFileTranspose);
+      return partitionGraph<GingerP, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSR, false);
     } else {
       GALOIS_DIE("Ginger requires transpose graph");
       break;
     }
 
   case FENNEL_O:
-    return galois::cuspPartitionGraph<FennelP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose);
+    return partitionGraph<FennelP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
   case FENNEL_I:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<FennelP, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSR, false,
-          inputFileTranspose);
+      return partitionGraph<FennelP, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSR, false);
     } else {
       GALOIS_DIE("Fennel requires transpose graph");
       break;
     }
 
   case SUGAR_O:
-    return galois::cuspPartitionGraph<SugarP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose);
+    return partitionGraph<SugarP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
 
   default:
     GALOIS_DIE("partition scheme specified is invalid: ", partitionScheme);
@@ -317,53 +383,46 @@ DistGraphPtr<NodeData, EdgeData> constructGraph(std::vector<unsigned>&) {
   // 1 host = no concept of cut; just load from edgeCut
   if (net.Num == 1) {
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSC, false,
-          inputFileTranspose);
+      return partitionGraph<NoCommunication, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSC, false);
     } else {
       fprintf(stderr, "WARNING: Loading transpose graph through in-memory "
                       "transpose to iterate over in-edges: pass in transpose "
                       "graph with -graphTranspose to avoid unnecessary "
                       "overhead.\n");
-      return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-          inputFileTranspose);
+      return partitionGraph<NoCommunication, NodeData, EdgeData>(
+          galois::CUSP_CSR, galois::CUSP_CSC, false);
     }
   }
 
   switch (partitionScheme) {
   case OEC:
-    return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-        inputFileTranspose, mastersFile);
+    return partitionGraph<NoCommunication, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false, mastersFile);
   case IEC:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSC, false,
-          inputFileTranspose, mastersFile);
+      return partitionGraph<NoCommunication, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSC, false, mastersFile);
     } else {
       GALOIS_DIE("iec requires transpose graph");
       break;
     }
 
   case HOVC:
-    return galois::cuspPartitionGraph<GenericHVC, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-        inputFileTranspose);
+    return partitionGraph<GenericHVC, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false);
   case HIVC:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<GenericHVC, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSC, false,
-          inputFileTranspose);
+      return partitionGraph<GenericHVC, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSC, false);
     } else {
       GALOIS_DIE("hivc requires transpose graph");
       break;
     }
 
   case CART_VCUT:
-    return galois::cuspPartitionGraph<GenericCVCColumnFlip, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-        inputFileTranspose);
+    return partitionGraph<GenericCVCColumnFlip, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false);
   case CART_VCUT_IEC:
     if (inputFileTranspose.size()) {
       return galois::cuspPartitionGraph<GenericCVCColumnFlip, NodeData,
@@ -376,37 +435,32 @@ DistGraphPtr<NodeData, EdgeData> constructGraph(std::vector<unsigned>&) {
     }
 
   case GINGER_O:
-    return galois::cuspPartitionGraph<GingerP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-        inputFileTranspose);
+    return partitionGraph<GingerP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false);
   case GINGER_I:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<GingerP, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSC, false,
-          inputFileTranspose);
+      return partitionGraph<GingerP, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSC, false);
     } else {
       GALOIS_DIE("Ginger requires transpose graph");
       break;
     }
 
   case FENNEL_O:
-    return galois::cuspPartitionGraph<FennelP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-        inputFileTranspose);
+    return partitionGraph<FennelP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false);
   case FENNEL_I:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<FennelP, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSC, false,
-          inputFileTranspose);
+      return partitionGraph<FennelP, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSC, false);
     } else {
       GALOIS_DIE("Fennel requires transpose graph");
       break;
     }
 
   case SUGAR_O:
-    return galois::cuspPartitionGraph<SugarColumnFlipP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-        inputFileTranspose);
+    return partitionGraph<SugarColumnFlipP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false);
 
   default:
     GALOIS_DIE("partition scheme specified is invalid: ", partitionScheme);
@@ -45,6 +45,14 @@ extern cll::opt<std::string> statFile;
 extern cll::opt<bool> partitionAgnostic;
 //! Set method for metadata sends
 extern cll::opt<DataCommMode> commMetadata;
+//! If set, large sync messages may be compressed
+extern cll::opt<bool> syncCompression;
+//! Rounds between node data checkpoints; 0 disables them
+extern cll::opt<unsigned> checkpointInterval;
+//! Prefix of the node data checkpoint files
+extern cll::opt<std::string> checkpointFile;
+//! If set, resume from the last node data checkpoint
+extern cll::opt<bool> restoreCheckpoint;
 //! Where to write output if output is set
 extern cll::opt<std::string> outputLocation;
 extern cll::opt<bool> output;
@@ -152,8 +160,9 @@ loadDistGraph(std::vector<unsigned>& scaleFactor) {
   dGraphTimer.stop();
 
   // Save local graph structure
-  // if (saveLocalGraph)
-  //  (*loadedGraph).save_local_graph_to_file(localGraphFileName);
+  if (saveLocalGraph && !readFromFile) {
+    (*loadedGraph).save_local_graph_to_file(localGraphFileName);
+  }
 
   return loadedGraph;
 }
@@ -194,8 +203,9 @@ loadSymmetricDistGraph(std::vector<unsigned>& scaleFactor) {
   dGraphTimer.stop();
 
   // Save local graph structure
-  // if (saveLocalGraph)
-  //  (*loadedGraph).save_local_graph_to_file(localGraphFileName);
+  if (saveLocalGraph && !readFromFile) {
+    (*loadedGraph).save_local_graph_to_file(localGraphFileName);
+  }
 
   return loadedGraph;
 }
@@ -237,7 +247,7 @@ distGraphInitialization() {
   const auto& net = galois::runtime::getSystemNetworkInterface();
   s = std::make_unique<Substrate>(*g, net.ID, net.Num, g->isTransposed(),
                                   g->cartesianGrid(), partitionAgnostic,
-                                  commMetadata);
+                                  commMetadata, syncCompression);
 
 // marshal graph to GPU as necessary
 #ifdef GALOIS_ENABLE_GPU
@@ -282,7 +292,7 @@ symmetricDistGraphInitialization() {
   const auto& net = galois::runtime::getSystemNetworkInterface();
   s = std::make_unique<Substrate>(*g, net.ID, net.Num, g->isTransposed(),
                                   g->cartesianGrid(), partitionAgnostic,
-                                  commMetadata);
+                                  commMetadata, syncCompression);
 
 // marshal graph to GPU as necessary
 #ifdef GALOIS_ENABLE_GPU
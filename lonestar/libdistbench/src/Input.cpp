@@ -25,6 +25,18 @@
  */
 
 #include "DistBench/Input.h"
+#include "galois/DReducible.h"
+#include "galois/runtime/Checkpoint.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
 
 using namespace galois::graphs;
 
@@ -61,16 +73,15 @@ cll::opt<PARTITIONING_SCHEME> partitionScheme(
     cll::init(OEC));
 
 cll::opt<bool> readFromFile("readFromFile",
-                            cll::desc("Set this flag if graph is to be "
-                                      "constructed from file (file must be "
-                                      "created by Abelian CSR)"),
+                            cll::desc("Set this flag to load the partition "
+                                      "saved by -saveLocalGraph instead of "
+                                      "partitioning the input graph"),
                             cll::init(false), cll::Hidden);
 
 cll::opt<std::string>
     localGraphFileName("localGraphFileName",
-                       cll::desc("Name of the local file to construct "
-                                 "local graph (file must be created by "
-                                 "Abelian CSR)"),
+                       cll::desc("Prefix of the files the local graph of "
+                                 "each host is saved to or read from"),
                        cll::init("local_graph"), cll::Hidden);
 
 cll::opt<bool> saveLocalGraph("saveLocalGraph",
@@ -80,3 +91,151 @@ cll::opt<bool> saveLocalGraph("saveLocalGraph",
 cll::opt<std::string> mastersFile("mastersFile",
                                   cll::desc("File specifying masters blocking"),
                                   cll::init(""), cll::Hidden);
+
+cll::opt<std::string> partitionCache(
+    "partitionCache",
+    cll::desc("Directory of the partition cache: partitions of the same "
+              "input, policy and host count are loaded from it instead of "
+              "being recomputed, and saved to it otherwise"),
+    cll::init(""), cll::Hidden);
+
+namespace {
+
+//! Mixes a 64-bit word into a hash
+inline uint64_t hashMix(uint64_t h, uint64_t w) {
+  w *= 0x87c37b91114253d5ULL;
+  w = (w << 31) | (w >> 33);
+  h ^= w * 0x4cf5ad432745937fULL;
+  h = (h << 27) | (h >> 37);
+  return h * 5 + 0x52dce729;
+}
+
+//! Hashes a string
+uint64_t hashString(const std::string& str, uint64_t h = 0) {
+  for (char c : str) {
+    h = hashMix(h, static_cast<unsigned char>(c));
+  }
+  return hashMix(h, str.size());
+}
+
+/**
+ * Hashes the contents of a file. The file is mapped and hashed in 1 MB
+ * chunks by all threads, and the chunk hashes are combined in order.
+ */
+uint64_t hashFileContents(const std::string& fileName) {
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd == -1) {
+    GALOIS_SYS_DIE("failed opening ", "'", fileName, "'");
+  }
+  struct stat buf;
+  if (fstat(fd, &buf) == -1) {
+    GALOIS_SYS_DIE("failed reading ", "'", fileName, "'");
+  }
+  size_t size = buf.st_size;
+  if (size == 0) {
+    close(fd);
+    return hashMix(0, 0);
+  }
+  void* base = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (base == MAP_FAILED) {
+    GALOIS_SYS_DIE("failed reading ", "'", fileName, "'");
+  }
+  close(fd);
+
+  constexpr size_t chunkSize = 1 << 20;
+  const char* data           = static_cast<const char*>(base);
+  std::vector<uint64_t> chunkHashes((size + chunkSize - 1) / chunkSize);
+  galois::do_all(
+      galois::iterate(size_t{0}, chunkHashes.size()),
+      [&](size_t c) {
+        size_t begin = c * chunkSize;
+        size_t end   = std::min(begin + chunkSize, size);
+        uint64_t h   = c;
+        size_t i     = begin;
+        for (; i + sizeof(uint64_t) <= end; i += sizeof(uint64_t)) {
+          uint64_t w;
+          std::memcpy(&w, data + i, sizeof(uint64_t));
+          h = hashMix(h, w);
+        }
+        for (; i < end; ++i) {
+          h = hashMix(h, static_cast<unsigned char>(data[i]));
+        }
+        chunkHashes[c] = h;
+      },
+      galois::no_stats(), galois::loopname("HashInputFile"));
+  munmap(base, size);
+
+  uint64_t h = size;
+  for (uint64_t chunkHash : chunkHashes) {
+    h = hashMix(h, chunkHash);
+  }
+  return h;
+}
+
+//! Returns the last component of a path
+std::string baseName(const std::string& path) {
+  size_t slash = path.find_last_of('/');
+  return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+} // namespace
+
+std::string partitionCacheFile(galois::CUSP_GRAPH_TYPE inputType,
+                               galois::CUSP_GRAPH_TYPE outputType,
+                               bool symmetric, const std::string& policy,
+                               size_t edgeDataSize,
+                               const std::string& masterBlockFile) {
+  auto& net = galois::runtime::getSystemNetworkInterface();
+  // same choice as cuspPartitionGraph: a symmetric graph is always read from
+  // the input file
+  const std::string& graphFile =
+      (!symmetric && inputType == galois::CUSP_CSC) ? inputFileTranspose
+                                                    : inputFile;
+
+  // only host 0 reads the input; the others get the hash from the reduction
+  galois::DGReduceMax<uint64_t> contentHash;
+  contentHash.reset();
+  if (net.ID == 0) {
+    uint64_t h = hashFileContents(graphFile);
+    if (!masterBlockFile.empty()) {
+      h = hashMix(h, hashFileContents(masterBlockFile));
+    }
+    contentHash.update(h);
+  }
+
+  const char* layout =
+      symmetric ? "sym" : (inputType == galois::CUSP_CSR) ? "csr" : "csc";
+  const char* out    = (outputType == galois::CUSP_CSR) ? "csr" : "csc";
+  uint64_t key       = contentHash.reduce();
+  key                = hashString(policy, key);
+  key                = hashMix(key, net.Num);
+  key                = hashMix(key, inputType);
+  key                = hashMix(key, outputType);
+  key                = hashMix(key, symmetric);
+  key                = hashMix(key, edgeDataSize);
+
+  char hex[17];
+  std::snprintf(hex, sizeof(hex), "%016llx",
+                static_cast<unsigned long long>(key));
+  return partitionCache + "/" + baseName(graphFile) + "-" +
+         EnumToString(partitionScheme) + "-" + std::to_string(net.Num) +
+         "h-" + layout + "2" + out + "-" + hex;
+}
+
+bool partitionCached(const std::string& cacheFile) {
+  auto& net = galois::runtime::getSystemNetworkInterface();
+  galois::DGAccumulator<uint32_t> missing;
+  missing.reset();
+  if (!galois::runtime::CheckpointReader::exists(cacheFile + "_" +
+                                                 std::to_string(net.ID))) {
+    missing += 1;
+  }
+  return missing.reduce() == 0;
+}
+
+void createPartitionCache() {
+  if (mkdir(partitionCache.c_str(), 0777) == -1 && errno != EEXIST) {
+    GALOIS_SYS_DIE("failed creating partition cache ", "'", partitionCache,
+                   "'");
+  }
+}
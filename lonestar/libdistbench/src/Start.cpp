@@ -54,6 +54,30 @@ cll::opt<DataCommMode> commMetadata(
                            "non-updated values)")),
     cll::init(noData), cll::Hidden);
 
+cll::opt<bool> syncCompression(
+    "syncCompression",
+    cll::desc("Delta+varint compress large sync messages when it makes them "
+              "smaller (CPU hosts only; default false)"),
+    cll::init(false), cll::Hidden);
+
+cll::opt<unsigned> checkpointInterval(
+    "checkpointInterval",
+    cll::desc("Checkpoint node data every this many rounds in benchmarks "
+              "that support it (default 0: never)"),
+    cll::init(0), cll::Hidden);
+
+cll::opt<std::string>
+    checkpointFile("checkpointFile",
+                   cll::desc("Prefix of the node data checkpoint files "
+                             "(default checkpoint)"),
+                   cll::init("checkpoint"), cll::Hidden);
+
+cll::opt<bool> restoreCheckpoint(
+    "restoreCheckpoint",
+    cll::desc("Resume the first run from the last checkpoint if all hosts "
+              "have one (default false)"),
+    cll::init(false), cll::Hidden);
+
 cll::opt<std::string> outputLocation(
     "outputLocation",
     cll::desc("Location (directory) to write results to when output is true"));
@@ -209,6 +233,13 @@ void internal::heteroSetup(std::vector<unsigned>& scaleFactor) {
         }
       }
     }
+
+    // GPU sync cannot decode compressed messages
+    if (syncCompression && personality_set.find('g') != std::string::npos) {
+      galois::gWarn("Command line option -syncCompression ignored because "
+                    "some hosts are GPUs");
+      syncCompression = false;
+    }
   } else {
     galois::gWarn(
         "Command line option -pset ignored because its string length is not "
@@ -21,17 +21,50 @@
 #define LONESTAR_BOILERPLATE_H
 
 #include "galois/Galois.h"
+#include "galois/Timer.h"
 #include "galois/Version.h"
+#include "galois/graphs/GraphOrdering.h"
 #include "llvm/Support/CommandLine.h"
 
+//! in-memory relabelings of the input graph selectable with -relabelNodes
+enum class RelabelNodes { none, degree, rcm };
+
 //! standard global options to the benchmarks
 extern llvm::cl::opt<bool> skipVerify;
 extern llvm::cl::opt<int> numThreads;
 extern llvm::cl::opt<std::string> statFile;
+extern llvm::cl::opt<galois::runtime::StatFormat> statFormat;
 extern llvm::cl::opt<bool> symmetricGraph;
+extern llvm::cl::opt<RelabelNodes> relabelNodes;
 
 //! initialize lonestar benchmark
 void LonestarStart(int argc, char** argv, const char* app, const char* desc,
                    const char* url, llvm::cl::opt<std::string>* input);
 void LonestarStart(int argc, char** argv);
+
+/**
+ * Relabels the nodes of an in-memory graph as selected with -relabelNodes.
+ * Apps supporting relabeling call this after reading the graph and use
+ * relabeling to translate node ids from the command line (toNew) and node
+ * ids they output (toOld).
+ */
+template <typename Graph>
+void LonestarRelabel(Graph& graph, galois::graphs::NodeRelabeling& relabeling) {
+  if (relabelNodes == RelabelNodes::none) {
+    return;
+  }
+  galois::StatTimer relabelTimer("RelabelTime");
+  relabelTimer.start();
+  switch (relabelNodes) {
+  case RelabelNodes::degree:
+    galois::graphs::relabelByDegree(graph, relabeling);
+    break;
+  case RelabelNodes::rcm:
+    galois::graphs::relabelByRCM(graph, relabeling);
+    break;
+  default:
+    break;
+  }
+  relabelTimer.stop();
+}
 #endif
@@ -33,6 +33,15 @@ llvm::cl::opt<std::string> statFile(
     "statFile",
     llvm::cl::desc("ouput file to print stats to (default value empty)"),
     llvm::cl::init(""));
+llvm::cl::opt<galois::runtime::StatFormat> statFormat(
+    "statFormat", llvm::cl::desc("Format of the printed stats:"),
+    llvm::cl::values(clEnumValN(galois::runtime::StatFormat::TEXT, "text",
+                                "comma separated lines (default)"),
+                     clEnumValN(galois::runtime::StatFormat::JSON, "json",
+                                "JSON with run metadata and per-thread values"),
+                     clEnumValN(galois::runtime::StatFormat::CSV, "csv",
+                                "CSV with one column per thread")),
+    llvm::cl::init(galois::runtime::StatFormat::TEXT));
 
 //! Flag that forces user to be aware that they should be passing in a
 //! symmetric graph.
@@ -41,6 +50,16 @@ llvm::cl::opt<bool>
                    llvm::cl::desc("Specify that the input graph is symmetric"),
                    llvm::cl::init(false));
 
+llvm::cl::opt<RelabelNodes> relabelNodes(
+    "relabelNodes",
+    llvm::cl::desc("Relabel nodes in memory after reading the graph, if "
+                   "supported by the application:"),
+    llvm::cl::values(
+        clEnumValN(RelabelNodes::none, "none", "keep input ids (default)"),
+        clEnumValN(RelabelNodes::degree, "degree", "by decreasing degree"),
+        clEnumValN(RelabelNodes::rcm, "rcm", "reverse Cuthill-McKee")),
+    llvm::cl::init(RelabelNodes::none));
+
 static void LonestarPrintVersion(llvm::raw_ostream& out) {
   out << "LoneStar Benchmark Suite v" << galois::getVersion() << " ("
       << galois::getRevision() << ")\n";
@@ -60,6 +79,7 @@ void LonestarStart(int argc, char** argv, const char* app, const char* desc,
   numThreads = galois::setActiveThreads(numThreads);
 
   galois::runtime::setStatFile(statFile);
+  galois::runtime::setStatFormat(statFormat);
 
   LonestarPrintVersion(llvm::outs());
   llvm::outs() << "Copyright (C) " << galois::getCopyrightYear()
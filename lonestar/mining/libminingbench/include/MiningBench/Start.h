@@ -14,6 +14,8 @@ extern cll::opt<unsigned> show;
 extern cll::opt<unsigned> debug;
 extern cll::opt<unsigned> minsup;
 extern cll::opt<std::string> preset_filename;
+extern cll::opt<unsigned> hubMemory;
+extern cll::opt<unsigned> hubDegree;
 
 extern cll::opt<bool> simpleGraph;
 
@@ -37,6 +37,16 @@ cll::opt<unsigned> minsup("ms",
 cll::opt<std::string>
     preset_filename("pf", cll::desc("<filename: preset matching order>"),
                     cll::init(""));
+cll::opt<unsigned>
+    hubMemory("hubMemory",
+              cll::desc("MB of adjacency bitmaps for high degree vertices "
+                        "(default value 0 disables them)"),
+              cll::init(0));
+cll::opt<unsigned>
+    hubDegree("hubDegree",
+              cll::desc("minimum degree of vertices given an adjacency "
+                        "bitmap (default value 1024)"),
+              cll::init(1024));
 // TODO use skipVerify from liblonestar
 cll::opt<bool>
     verify("v", llvm::cl::desc("do verification step (default value false)"),
@@ -19,7 +19,11 @@
 
 #include "galois/Galois.h"
 #include "galois/LargeArray.h"
+#include "galois/Timer.h"
 #include "galois/graphs/FileGraph.h"
+#include "galois/graphs/GraphOrdering.h"
+#include "galois/graphs/LC_Compressed_Graph.h"
+#include "galois/graphs/ReadGraph.h"
 
 #include <llvm/Support/CommandLine.h>
 
@@ -51,10 +55,13 @@ enum ConvertMode {
   gr2binarypbbs64,
   gr2bsml,
   gr2cgr,
+  gr2compressedgr,
+  gr2degreegroupgr,
   gr2dimacs,
   gr2adjacencylist,
   gr2edgelist,
   gr2edgelist1ind,
+  gr2gordergr,
   gr2linegr,
   gr2lowdegreegr,
   gr2mtx,
@@ -64,6 +71,7 @@ enum ConvertMode {
   gr2pbbsedges,
   gr2randgr,
   gr2randomweightgr,
+  gr2rcmgr,
   gr2ringgr,
   gr2rmat,
   gr2metis,
@@ -139,10 +147,15 @@ static cll::opt<ConvertMode> convertMode(
         clEnumVal(gr2bsml, "Convert binary gr to binary sparse MATLAB matrix"),
         clEnumVal(gr2cgr,
                   "Clean up binary gr: remove self edges and multi-edges"),
+        clEnumVal(gr2compressedgr,
+                  "Convert binary gr to delta+varint compressed graph"),
+        clEnumVal(gr2degreegroupgr,
+                  "Group nodes by degree, hubs first (degree-based grouping)"),
         clEnumVal(gr2dimacs, "Convert binary gr to dimacs"),
         clEnumVal(gr2adjacencylist, "Convert binary gr to adjacency list"),
         clEnumVal(gr2edgelist, "Convert binary gr to edgelist"),
         clEnumVal(gr2edgelist1ind, "Convert binary gr to edgelist, 1-indexed"),
+        clEnumVal(gr2gordergr, "Sort nodes by Gorder window ordering"),
         clEnumVal(gr2linegr, "Overlay line graph"),
         clEnumVal(gr2lowdegreegr, "Remove high degree nodes from binary gr"),
         clEnumVal(gr2mtx, "Convert binary gr to matrix market format"),
@@ -154,6 +167,7 @@ static cll::opt<ConvertMode> convertMode(
         clEnumVal(gr2pbbsedges, "Convert binary gr to pbbs edge list"),
         clEnumVal(gr2randgr, "Randomly permute nodes of binary gr"),
         clEnumVal(gr2randomweightgr, "Add or Randomize edge weights"),
+        clEnumVal(gr2rcmgr, "Sort nodes by reverse Cuthill-McKee ordering"),
         clEnumVal(gr2ringgr, "Convert binary gr to strongly connected graph by "
                              "adding ring overlay"),
         clEnumVal(gr2rmat, "Convert binary gr to RMAT graph"),
@@ -201,6 +215,17 @@ static cll::opt<int>
              cll::init(1));
 static cll::opt<int> maxDegree("maxDegree", cll::desc("maximum degree to keep"),
                                cll::init(2 * 1024));
+static cll::opt<unsigned>
+    gorderWindow("gorderWindow",
+                 cll::desc("window size for Gorder ordering (default 5)"),
+                 cll::init(5));
+static cll::opt<unsigned> degreeGroups(
+    "degreeGroups",
+    cll::desc("number of degree groups for degree-based grouping; 2 clusters "
+              "hubs only (default 8)"),
+    cll::init(8));
+static cll::opt<unsigned> threadsToUse("t", cll::desc("Threads to use"),
+                                       cll::init(1));
 
 struct Conversion {};
 struct HasOnlyVoidSpecialization {};
@@ -1450,6 +1475,61 @@ struct SortByDegree : public Conversion {
   }
 };
 
+/**
+ * Relabels nodes with one of the orderings in GraphOrdering.h and writes the
+ * permuted graph and the permutation.
+ */
+template <typename EdgeTy, typename OrderFn>
+void convertWithOrdering(const std::string& infilename,
+                         const std::string& outfilename, OrderFn orderFn) {
+  typedef galois::graphs::FileGraph Graph;
+  typedef Graph::GraphNode GNode;
+  typedef galois::LargeArray<GNode> Permutation;
+
+  Graph ingraph, outgraph;
+  ingraph.fromFile(infilename);
+
+  Permutation perm;
+  perm.create(ingraph.size());
+  galois::Timer timer;
+  timer.start();
+  orderFn(ingraph, perm);
+  timer.stop();
+  std::cout << "Ordering time: " << timer.get() << " ms\n";
+
+  galois::graphs::permute<EdgeTy>(ingraph, perm, outgraph);
+  outputPermutation(perm);
+  outgraph.toFile(outfilename);
+  printStatus(ingraph.size(), ingraph.sizeEdges());
+}
+
+struct SortByRCM : public Conversion {
+  template <typename EdgeTy>
+  void convert(const std::string& infilename, const std::string& outfilename) {
+    convertWithOrdering<EdgeTy>(infilename, outfilename, [](auto& g, auto& p) {
+      galois::graphs::rcmOrder(g, p);
+    });
+  }
+};
+
+struct SortByGorder : public Conversion {
+  template <typename EdgeTy>
+  void convert(const std::string& infilename, const std::string& outfilename) {
+    convertWithOrdering<EdgeTy>(infilename, outfilename, [](auto& g, auto& p) {
+      galois::graphs::gorderOrder(g, p, gorderWindow);
+    });
+  }
+};
+
+struct GroupByDegree : public Conversion {
+  template <typename EdgeTy>
+  void convert(const std::string& infilename, const std::string& outfilename) {
+    convertWithOrdering<EdgeTy>(infilename, outfilename, [](auto& g, auto& p) {
+      galois::graphs::degreeGroupOrder(g, p, degreeGroups);
+    });
+  }
+};
+
 struct ToBigEndian : public HasNoVoidSpecialization {
   template <typename EdgeTy>
   void convert(const std::string& infilename, const std::string& outfilename) {
@@ -2430,6 +2510,32 @@ struct Gr2BinaryPbbs : public HasOnlyVoidSpecialization {
   }
 };
 
+/**
+ * Writes a galois::graphs::LC_Compressed_Graph file: sorted adjacency lists
+ * stored as delta+varint encoded blocks.
+ */
+struct Gr2CompressedGr : public Conversion {
+  template <typename EdgeTy>
+  void convert(const std::string& infilename, const std::string& outfilename) {
+    typedef typename galois::graphs::LC_Compressed_Graph<
+        void, EdgeTy>::template with_no_lockable<true>::type Graph;
+
+    galois::graphs::FileGraph graph;
+    graph.fromFile(infilename);
+
+    Graph out;
+    galois::graphs::readGraph(out, graph);
+    out.writeToCompressedFile(outfilename);
+
+    size_t inBytes = graph.size() * sizeof(uint64_t) +
+                     graph.sizeEdges() * sizeof(uint32_t);
+    std::cout << "Topology bytes: " << inBytes << " -> "
+              << out.sizeTopologyBytes() + out.size() * sizeof(uint64_t)
+              << "\n";
+    printStatus(graph.size(), graph.sizeEdges(), out.size(), out.sizeEdges());
+  }
+};
+
 struct Gr2Dimacs : public HasNoVoidSpecialization {
   template <typename EdgeTy>
   void convert(const std::string& infilename, const std::string& outfilename) {
@@ -2890,6 +2996,7 @@ struct Svmlight2Gr : public HasNoVoidSpecialization {
 int main(int argc, char** argv) {
   galois::SharedMemSys G;
   llvm::cl::ParseCommandLineOptions(argc, argv);
+  galois::setActiveThreads(threadsToUse);
   std::ios_base::sync_with_stdio(false);
   switch (convertMode) {
   case bipartitegr2bigpetsc:
@@ -2925,6 +3032,12 @@ int main(int argc, char** argv) {
   case gr2cgr:
     convert<Cleanup>();
     break;
+  case gr2compressedgr:
+    convert<Gr2CompressedGr>();
+    break;
+  case gr2degreegroupgr:
+    convert<GroupByDegree>();
+    break;
   case gr2dimacs:
     convert<Gr2Dimacs>();
     break;
@@ -2937,6 +3050,9 @@ int main(int argc, char** argv) {
   case gr2edgelist1ind:
     convert<Gr2Edgelist1Ind>();
     break;
+  case gr2gordergr:
+    convert<SortByGorder>();
+    break;
   case gr2linegr:
     convert<AddRing<true>>();
     break;
@@ -2964,6 +3080,9 @@ int main(int argc, char** argv) {
   case gr2randomweightgr:
     convert<RandomizeEdgeWeights>();
     break;
+  case gr2rcmgr:
+    convert<SortByRCM>();
+    break;
   case gr2ringgr:
     convert<AddRing<false>>();
     break;